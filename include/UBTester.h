@@ -2,13 +2,18 @@
 #define UBTESTER_INCLUDE_H_
 
 #include "ub-safe-containers/CArrayNPointerUBAsserts.h"
+#include "ub-safe-containers/LibcCallCheckers.h"
 
 #include "arithmetic-ub/ArithmeticUBAsserts.h"
+#include "arithmetic-ub/ArithmeticUBGenericAsserts.h"
 
+#include "uninit-variables/UBSafeField.h"
 #include "uninit-variables/UBSafeType.h"
+#include "uninit-variables/UninitShadow.h"
 
 using ub_tester::ub_safe_carray::UBSafeCArray;
 using ub_tester::ub_safe_ptr::UBSafePointer;
+using ub_tester::uninit_vars::UBSafeField;
 using ub_tester::uninit_vars::UBSafeType;
 
 #endif
@@ -7,6 +7,7 @@
 #include "clang/AST/Type.h"
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 namespace ub_tester::util {
 
@@ -17,6 +18,10 @@ clang::QualType getLowestLevelPointeeType(clang::QualType);
 std::string getRangeAsString(const clang::SourceRange& Range,
                              const clang::ASTContext* Context);
 
+// expression text on one line, shortened and quoted as C++ string literal
+std::string getExprAsStringLiteral(const clang::Expr*,
+                                   const clang::ASTContext*);
+
 clang::SourceLocation getNameLastLoc(const clang::DeclaratorDecl*,
                                      const clang::ASTContext*);
 clang::SourceLocation getAfterNameLoc(const clang::DeclaratorDecl*,
@@ -24,6 +29,41 @@ clang::SourceLocation getAfterNameLoc(const clang::DeclaratorDecl*,
 
 std::string getFuncNameWithArgsAsString(const clang::FunctionDecl* FuncDecl);
 
+// file path and offset; stable between preprocessing and main tool runs
+std::string getLocAsKey(clang::SourceLocation Loc,
+                        const clang::ASTContext* Context);
+
+// parameters are part of the signature and must stay the same in every
+// redeclaration and override, so only functions without them qualify
+bool canChangeParamTypes(const clang::FunctionDecl* FuncDecl);
+
+// collects local variables of the function and the ones whose address escapes
+// (&var, reference binding, lvalue call arguments, by-reference captures)
+class EscapedVarsVisitor
+    : public clang::RecursiveASTVisitor<EscapedVarsVisitor> {
+public:
+  explicit EscapedVarsVisitor(const clang::FunctionDecl* FuncDecl);
+
+  bool VisitVarDecl(clang::VarDecl* VDecl);
+  bool VisitUnaryOperator(clang::UnaryOperator* Unop);
+  bool VisitCallExpr(clang::CallExpr* CE);
+  bool VisitCXXConstructExpr(clang::CXXConstructExpr* CCE);
+  bool VisitInitListExpr(clang::InitListExpr* List);
+  bool VisitLambdaExpr(clang::LambdaExpr* Lambda);
+  bool VisitReturnStmt(clang::ReturnStmt* Return);
+
+  const std::vector<const clang::VarDecl*>& getLocalVars() const;
+  bool isEscaped(const clang::VarDecl* VDecl) const;
+
+private:
+  void markEscaped(const clang::Expr* Ex);
+
+private:
+  const clang::FunctionDecl* FuncDecl_;
+  std::vector<const clang::VarDecl*> LocalVars_;
+  std::unordered_set<const clang::VarDecl*> EscapedVars_;
+};
+
 namespace func_code_avail {
 
 bool hasFuncAvailCode(const clang::FunctionDecl* FuncDecl);
@@ -3,6 +3,9 @@
 #include "ArithmeticUBCheckers.h"
 #include "TypeConversionCheckers.h"
 #include "assert-message-manager/AssertMessageManager.h"
+#include "assert-message-manager/CheckEventLog.h"
+#include "assert-message-manager/CheckSite.h"
+#include "assert-message-manager/CheckToggles.h"
 #include <cstring>
 #include <sstream>
 
@@ -10,30 +13,36 @@
 #error At least C++17 is required
 #endif
 
-// Lhs and Rhs can be put in Assert-functions as strings to improve error-log
 /* Binary operations usually have equal Lhs and Rhs types, but there are some
  * exceptions like bitshift operators (can have different integer types).
- * However, return type of binary operator is always Lhs type. */
-#define ASSERT_BINOP(Operation, Lhs, Rhs, LhsType, RhsType)                    \
+ * However, return type of binary operator is always Lhs type.
+ * Column and ExprText of the check are emitted by tool for its site. */
+#define ASSERT_BINOP(Operation, Lhs, Rhs, LhsType, RhsType, Column, ExprText)  \
   ub_tester::arithm::asserts::assert##Operation<LhsType, RhsType>(             \
-      (Lhs), (Rhs), #LhsType, __FILE__, __LINE__)
-#define ASSERT_UNOP(Operation, Expr, Type)                                     \
-  ub_tester::arithm::asserts::assert##Operation<Type>((Expr), #Type, __FILE__, \
-                                                      __LINE__)
+      (Lhs), (Rhs),                                                            \
+      UB_TESTER_CHECK_SITE(Operation, Column, ExprText, #LhsType, #RhsType,    \
+                           nullptr))
+#define ASSERT_UNOP(Operation, Expr, Type, Column, ExprText)                   \
+  ub_tester::arithm::asserts::assert##Operation<Type>(                         \
+      (Expr), UB_TESTER_CHECK_SITE(Operation, Column, ExprText, #Type,         \
+                                   nullptr, nullptr))
 
 #define ASSERT_COMPASSIGNOP(Operation, Lhs, Rhs, LhsType, LhsComputationType,  \
-                            RhsType)                                           \
+                            RhsType, Column, ExprText)                         \
   ub_tester::arithm::asserts::assertCompAssignOp##Operation<                   \
       LhsType, LhsComputationType, RhsType>(                                   \
-      (Lhs), (Rhs), #LhsType, #LhsComputationType, __FILE__, __LINE__)
+      (Lhs), (Rhs),                                                            \
+      UB_TESTER_CHECK_SITE(CompAssignOp##Operation, Column, ExprText,          \
+                           #LhsType, #LhsComputationType, #RhsType))
 
-#define IMPLICIT_CAST(SubExpr, FromType, ToType)                               \
+#define IMPLICIT_CAST(SubExpr, FromType, ToType, Column, ExprText)             \
   ub_tester::arithm::asserts::casts::assertIntegralCast<FromType, ToType>(     \
-      (SubExpr), #FromType, #ToType, __FILE__, __LINE__)
+      (SubExpr), UB_TESTER_CHECK_SITE(IntegralCast, Column, ExprText,          \
+                                      #FromType, #ToType, nullptr))
 
-#define OVERFLOW_DETECTED(Type, Message)                                       \
+#define OVERFLOW_DETECTED(Type, Message, Filename, Line)                       \
   if (std::numeric_limits<Type>::is_signed) {                                  \
-    PUSH_ERROR(OVERFLOW_ERROR, (Message));                                     \
+    PUSH_ERROR(OVERFLOW_ERROR, (Message), (Filename), (Line));                 \
   } else                                                                       \
     PUSH_WARNING(UNSIGNED_OVERFLOW_WARNING, (Message))
 
@@ -48,21 +57,126 @@ using arithm::checkers::ArithmCheckRes;
 using assert_message_manager::AssertFailCode;
 using assert_message_manager::AssertMessage;
 using assert_message_manager::AssertMessageManager;
+using assert_message_manager::event_log::EventKind;
+using assert_message_manager::site::CheckSite;
+using assert_message_manager::toggles::CheckCategory;
 using type_conv::TyCoCheckRes;
+namespace event_log = assert_message_manager::event_log;
+namespace config = assert_message_manager::suppress_messages_mode;
+
+namespace support {
+
+// overflow of unsigned type can only be reported as warning
+template <typename T>
+constexpr bool isOverflowCheckNeeded(bool IsOperationDisabled) {
+  return !IsOperationDisabled &&
+         (std::numeric_limits<T>::is_signed ||
+          !assert_message_manager::checkIfMessageIsSuppressed(
+              AssertFailCode::UNSIGNED_OVERFLOW_WARNING));
+}
+
+// conversion can only be reported as warning
+constexpr bool isConvCheckNeeded(bool IsOperationDisabled) {
+  using assert_message_manager::checkIfMessageIsSuppressed;
+  return !IsOperationDisabled &&
+         !(checkIfMessageIsSuppressed(AssertFailCode::UNSAFE_CONV_WARNING) &&
+           checkIfMessageIsSuppressed(
+               AssertFailCode::IMPL_DEFINED_UNSAFE_CONV_WARNING));
+}
+
+// consulted after compile-time gates, so disabled checks do not reach it
+inline bool isCheckEnabled(CheckCategory Category, const CheckSite* Site) {
+  return assert_message_manager::toggles::isCheckEnabled(
+      Category, Site->Filename, Site->Line);
+}
+
+// errors are reported as text even if event log is enabled
+template <typename T>
+bool isErrorRes(ArithmCheckRes Res) {
+  switch (Res) {
+  case ArithmCheckRes::OVERFLOW_MAX:
+  case ArithmCheckRes::OVERFLOW_MIN:
+    return std::numeric_limits<T>::is_signed;
+  case ArithmCheckRes::IMPL_DEFINED_OPERATION:
+  case ArithmCheckRes::OVERFLOW_MAX_IN_BITSHIFT_LEFT_CXX20:
+  case ArithmCheckRes::OVERFLOW_MIN_IN_BITSHIFT_LEFT_CXX20:
+    return false;
+  default:
+    return true;
+  }
+}
+
+// errors are never skipped, so only results of warnings are mapped
+inline AssertFailCode getWarningCode(ArithmCheckRes Res) {
+  switch (Res) {
+  case ArithmCheckRes::OVERFLOW_MAX:
+  case ArithmCheckRes::OVERFLOW_MIN:
+    return AssertFailCode::UNSIGNED_OVERFLOW_WARNING;
+  case ArithmCheckRes::IMPL_DEFINED_OPERATION:
+    return AssertFailCode::IMPL_DEFINED_WARNING;
+  case ArithmCheckRes::OVERFLOW_MAX_IN_BITSHIFT_LEFT_CXX20:
+  case ArithmCheckRes::OVERFLOW_MIN_IN_BITSHIFT_LEFT_CXX20:
+    return AssertFailCode::OVERFLOW_IN_BITSHIFT_CXX20_WARNING;
+  default:
+    assert(0 && "Error ArithmCheckRes has no warning code");
+    return AssertFailCode::OVERFLOW_ERROR;
+  }
+}
+
+inline AssertFailCode getWarningCode(TyCoCheckRes Res) {
+  switch (Res) {
+  case TyCoCheckRes::EXPR_OVERFLOWS_TOTYPE_MAX_IMPL_DEFINED:
+  case TyCoCheckRes::EXPR_OVERFLOWS_TOTYPE_MIN_IMPL_DEFINED:
+    return AssertFailCode::IMPL_DEFINED_UNSAFE_CONV_WARNING;
+  case TyCoCheckRes::BOOL_CONVERSION_IS_NOT_CONSIDERED:
+    return AssertFailCode::NOT_CONSIDERED_WARNING;
+  default:
+    return AssertFailCode::UNSAFE_CONV_WARNING;
+  }
+}
+
+/* Warning is not formatted if it is suppressed, written to event log or its
+ * site has already been reported, then only counter of the site is
+ * incremented. Suppressed warnings are not logged either, so the log holds
+ * the same events as text output would. */
+template <typename... Types, typename ResType, typename... OperandTypes>
+bool skipReport(EventKind Kind, ResType Res, const char* Filename, int Line,
+                std::initializer_list<const char*> Names,
+                OperandTypes... Operands) {
+  return assert_message_manager::checkIfMessageIsSuppressed(
+             getWarningCode(Res)) ||
+         event_log::logEvent<Types...>(Kind, Res, Filename, Line, Names,
+                                       Operands...) ||
+         AssertMessageManager::isRepeatedWarning(
+             Filename, Line,
+             (static_cast<int>(Kind) << 8) | static_cast<int>(Res));
+}
+
+// type-generic checks leave names of types to their instantiation
+template <typename T>
+const char* getTypeName(const CheckSite* Site, size_t Index) {
+  const char* TypeName = Site->TypeNames[Index];
+  return TypeName ? TypeName
+                  : arithm_util::tmp_functions::getIntTypeAsString<T>();
+}
+
+} // namespace support
 
 namespace casts {
 
 template <typename FromType, typename ToType>
-ToType assertIntegralCast(FromType SubExpr, const char* FromTypeName,
-                          const char* ToTypeName, const char* Filename,
-                          int Line) {
-  static_assert(std::numeric_limits<FromType>::is_integer);
-  static_assert(std::numeric_limits<ToType>::is_integer);
+UB_TESTER_COLD void reportIntegralCast(TyCoCheckRes Res, FromType SubExpr,
+                                       const char* FromTypeName,
+                                       const char* ToTypeName,
+                                       const char* Filename, int Line) {
+  if (support::skipReport<FromType, ToType>(EventKind::IntegralCast, Res,
+                                            Filename, Line,
+                                            {FromTypeName, ToTypeName},
+                                            SubExpr))
+    return;
   ToType SubExprInToType = static_cast<ToType>(SubExpr);
   std::stringstream Message;
-
-  switch (
-      type_conv::Conversions<FromType, ToType>::checkIntegralConv(SubExpr)) {
+  switch (Res) {
   case TyCoCheckRes::NEG_VALUE_TO_UNSIGNED_TYPE_CONVERSION:
     Message << "unsafe conversion while implicit cast in " << Filename
             << " Line: " << Line << "\nlog: "
@@ -128,9 +242,25 @@ ToType assertIntegralCast(FromType SubExpr, const char* FromTypeName,
             << FromTypeName << " to " << ToTypeName << "\n";
     PUSH_WARNING(NOT_CONSIDERED_WARNING, Message.str());
     break;
+  default:
+    assert(0 && "Unexpected TyCoCheckRes from checkIntegralConv");
+  }
+}
 
-  case TyCoCheckRes::SAFE_CONVERSION:
-    break;
+template <typename FromType, typename ToType>
+ToType assertIntegralCast(FromType SubExpr, const CheckSite* Site) {
+  static_assert(std::numeric_limits<FromType>::is_integer);
+  static_assert(std::numeric_limits<ToType>::is_integer);
+  if constexpr (support::isConvCheckNeeded(
+                    config::DISABLE_IMPLICIT_CAST_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::ImplicitCast, Site))
+      return SubExpr;
+    TyCoCheckRes Res =
+        type_conv::Conversions<FromType, ToType>::checkIntegralConv(SubExpr);
+    if (UB_TESTER_UNLIKELY(Res != TyCoCheckRes::SAFE_CONVERSION))
+      reportIntegralCast<FromType, ToType>(
+          Res, SubExpr, support::getTypeName<FromType>(Site, 0),
+          support::getTypeName<ToType>(Site, 1), Site->Filename, Site->Line);
   }
   return SubExpr;
 }
@@ -138,147 +268,219 @@ ToType assertIntegralCast(FromType SubExpr, const char* FromTypeName,
 } // namespace casts
 
 template <typename LhsType, typename RhsType>
-LhsType assertSum(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
-                  const char* Filename, int Line) {
-  FLT_POINT_NOT_SUPPORTED(LhsType);
-  ARE_SAME_TYPES(LhsType, RhsType);
-  HAS_CONV_RANK_GEQ_THAN_INT(LhsType); // integral promotion is expected
+UB_TESTER_COLD void reportSum(ArithmCheckRes Res, LhsType Lhs, RhsType Rhs,
+                              const char* LhsTypeName, const char* Filename,
+                              int Line) {
+  if (!support::isErrorRes<LhsType>(Res) &&
+      support::skipReport<LhsType, RhsType>(EventKind::Sum, Res, Filename, Line,
+                                            {LhsTypeName}, Lhs, Rhs))
+    return;
   std::stringstream Message;
-
-  switch (arithm::checkers::checkSum<LhsType>(Lhs, Rhs)) {
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: " << +Lhs << " + " << +Rhs << " > "
             << +std::numeric_limits<LhsType>::max() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs + Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: " << +Lhs << " + " << +Rhs << " < "
             << +std::numeric_limits<LhsType>::lowest() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs + Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    return Lhs + Rhs;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkSum");
   }
 }
 
 template <typename LhsType, typename RhsType>
-LhsType assertDiff(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
-                   const char* Filename, int Line) {
+LhsType assertSum(LhsType Lhs, RhsType Rhs, const CheckSite* Site) {
   FLT_POINT_NOT_SUPPORTED(LhsType);
   ARE_SAME_TYPES(LhsType, RhsType);
   HAS_CONV_RANK_GEQ_THAN_INT(LhsType); // integral promotion is expected
-  std::stringstream Message;
+  if constexpr (support::isOverflowCheckNeeded<LhsType>(
+                    config::DISABLE_SUM_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs + Rhs;
+    ArithmCheckRes Res = arithm::checkers::checkSum<LhsType>(Lhs, Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportSum<LhsType, RhsType>(Res, Lhs, Rhs,
+                                  support::getTypeName<LhsType>(Site, 0),
+                                  Site->Filename, Site->Line);
+  }
+  return Lhs + Rhs;
+}
 
-  switch (arithm::checkers::checkDiff<LhsType>(Lhs, Rhs)) {
+template <typename LhsType, typename RhsType>
+UB_TESTER_COLD void reportDiff(ArithmCheckRes Res, LhsType Lhs, RhsType Rhs,
+                               const char* LhsTypeName, const char* Filename,
+                               int Line) {
+  if (!support::isErrorRes<LhsType>(Res) &&
+      support::skipReport<LhsType, RhsType>(EventKind::Diff, Res, Filename,
+                                            Line, {LhsTypeName}, Lhs, Rhs))
+    return;
+  std::stringstream Message;
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: " << +Lhs << " - " << +Rhs << " > "
             << +std::numeric_limits<LhsType>::max() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs - Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: " << +Lhs << " - " << +Rhs << " < "
             << +std::numeric_limits<LhsType>::lowest() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs - Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    return Lhs - Rhs;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkDiff");
   }
 }
 
 template <typename LhsType, typename RhsType>
-LhsType assertMul(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
-                  const char* Filename, int Line) {
+LhsType assertDiff(LhsType Lhs, RhsType Rhs, const CheckSite* Site) {
   FLT_POINT_NOT_SUPPORTED(LhsType);
   ARE_SAME_TYPES(LhsType, RhsType);
   HAS_CONV_RANK_GEQ_THAN_INT(LhsType); // integral promotion is expected
-  std::stringstream Message;
+  if constexpr (support::isOverflowCheckNeeded<LhsType>(
+                    config::DISABLE_DIFF_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs - Rhs;
+    ArithmCheckRes Res = arithm::checkers::checkDiff<LhsType>(Lhs, Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportDiff<LhsType, RhsType>(Res, Lhs, Rhs,
+                                   support::getTypeName<LhsType>(Site, 0),
+                                   Site->Filename, Site->Line);
+  }
+  return Lhs - Rhs;
+}
 
-  switch (arithm::checkers::checkMul<LhsType>(Lhs, Rhs)) {
+template <typename LhsType, typename RhsType>
+UB_TESTER_COLD void reportMul(ArithmCheckRes Res, LhsType Lhs, RhsType Rhs,
+                              const char* LhsTypeName, const char* Filename,
+                              int Line) {
+  if (!support::isErrorRes<LhsType>(Res) &&
+      support::skipReport<LhsType, RhsType>(EventKind::Mul, Res, Filename, Line,
+                                            {LhsTypeName}, Lhs, Rhs))
+    return;
+  std::stringstream Message;
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: " << +Lhs << " * " << +Rhs << " > "
             << +std::numeric_limits<LhsType>::max() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs * Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: " << +Lhs << " * " << +Rhs << " < "
             << +std::numeric_limits<LhsType>::lowest() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs * Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    return Lhs * Rhs;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkMul");
   }
 }
 
 template <typename LhsType, typename RhsType>
-LhsType assertDiv(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
-                  const char* Filename, int Line) {
+LhsType assertMul(LhsType Lhs, RhsType Rhs, const CheckSite* Site) {
   FLT_POINT_NOT_SUPPORTED(LhsType);
   ARE_SAME_TYPES(LhsType, RhsType);
   HAS_CONV_RANK_GEQ_THAN_INT(LhsType); // integral promotion is expected
+  if constexpr (support::isOverflowCheckNeeded<LhsType>(
+                    config::DISABLE_MUL_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs * Rhs;
+    ArithmCheckRes Res = arithm::checkers::checkMul<LhsType>(Lhs, Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportMul<LhsType, RhsType>(Res, Lhs, Rhs,
+                                  support::getTypeName<LhsType>(Site, 0),
+                                  Site->Filename, Site->Line);
+  }
+  return Lhs * Rhs;
+}
+
+template <typename LhsType, typename RhsType>
+UB_TESTER_COLD void reportDiv(ArithmCheckRes Res, LhsType Lhs, RhsType Rhs,
+                              const char* LhsTypeName, const char* Filename,
+                              int Line) {
+  if (!support::isErrorRes<LhsType>(Res) &&
+      support::skipReport<LhsType, RhsType>(EventKind::Div, Res, Filename, Line,
+                                            {LhsTypeName}, Lhs, Rhs))
+    return;
   std::stringstream Message;
 
   // check for flt-point in future: minLim <= (Lhs / 0-approx Rhs) <= maxLim
-  switch (arithm::checkers::checkDiv<LhsType>(Lhs, Rhs)) {
+
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: " << +Lhs << " / " << +Rhs << " > "
             << +std::numeric_limits<LhsType>::max() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs / Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: " << +Lhs << " / " << +Rhs << " < "
             << +std::numeric_limits<LhsType>::lowest() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs / Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::DIV_BY_0:
     Message << LhsTypeName << " division by 0 in " << Filename
             << " Line: " << Line << "\n";
-    PUSH_ERROR(DIVISION_BY_ZERO_ERROR, Message.str());
+    PUSH_ERROR(DIVISION_BY_ZERO_ERROR, Message.str(), Filename, Line);
+    break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    return Lhs / Rhs;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkDiv");
   }
 }
 
 template <typename LhsType, typename RhsType>
-LhsType assertMod(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
-                  const char* Filename, int Line) {
-  static_assert(std::numeric_limits<LhsType>::is_integer);
+LhsType assertDiv(LhsType Lhs, RhsType Rhs, const CheckSite* Site) {
+  FLT_POINT_NOT_SUPPORTED(LhsType);
   ARE_SAME_TYPES(LhsType, RhsType);
   HAS_CONV_RANK_GEQ_THAN_INT(LhsType); // integral promotion is expected
-  std::stringstream Message;
+  if constexpr (!config::DISABLE_DIV_CHECKS) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs / Rhs;
+    ArithmCheckRes Res = arithm::checkers::checkDiv<LhsType>(Lhs, Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportDiv<LhsType, RhsType>(Res, Lhs, Rhs,
+                                  support::getTypeName<LhsType>(Site, 0),
+                                  Site->Filename, Site->Line);
+  }
+  return Lhs / Rhs;
+}
 
-  switch (arithm::checkers::checkMod<LhsType>(Lhs, Rhs)) {
+template <typename LhsType, typename RhsType>
+UB_TESTER_COLD void reportMod(ArithmCheckRes Res, LhsType Lhs, RhsType Rhs,
+                              const char* LhsTypeName, const char* Filename,
+                              int Line) {
+  if (!support::isErrorRes<LhsType>(Res) &&
+      support::skipReport<LhsType, RhsType>(EventKind::Mod, Res, Filename, Line,
+                                            {LhsTypeName}, Lhs, Rhs))
+    return;
+  std::stringstream Message;
+  switch (Res) {
   case ArithmCheckRes::MOD_UNDEFINED_DIV_OVERFLOWS_MAX:
     Message << LhsTypeName << " mod (%) is undefined in " << Filename
             << " Line: " << Line
             << "\nlog: because division is undefined; overflow: " << +Lhs
             << " / " << +Rhs << " > " << +std::numeric_limits<LhsType>::max()
             << "\n";
-    PUSH_ERROR(UNDEFINED_MOD_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_MOD_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::MOD_UNDEFINED_DIV_OVERFLOWS_MIN:
     Message << LhsTypeName << " mod (%) is undefined in " << Filename
@@ -286,42 +488,62 @@ LhsType assertMod(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
             << "\nlog: because division is undefined; overflow: " << +Lhs
             << " / " << +Rhs << " < " << +std::numeric_limits<LhsType>::lowest()
             << "\n";
-    PUSH_ERROR(UNDEFINED_MOD_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_MOD_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::DIV_BY_0:
     Message << LhsTypeName << " mod (%) by 0 in " << Filename
             << " Line: " << Line << "\n";
-    PUSH_ERROR(DIVISION_BY_ZERO_ERROR, Message.str());
+    PUSH_ERROR(DIVISION_BY_ZERO_ERROR, Message.str(), Filename, Line);
+    break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    return Lhs % Rhs;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkMod");
   }
 }
 
 template <typename LhsType, typename RhsType>
-LhsType assertBitShiftLeft(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
-                           const char* Filename, int Line) {
+LhsType assertMod(LhsType Lhs, RhsType Rhs, const CheckSite* Site) {
   static_assert(std::numeric_limits<LhsType>::is_integer);
-  static_assert(std::numeric_limits<RhsType>::is_integer);
+  ARE_SAME_TYPES(LhsType, RhsType);
   HAS_CONV_RANK_GEQ_THAN_INT(LhsType); // integral promotion is expected
-  HAS_CONV_RANK_GEQ_THAN_INT(RhsType); // integral promotion is expected
+  if constexpr (!config::DISABLE_MOD_CHECKS) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs % Rhs;
+    ArithmCheckRes Res = arithm::checkers::checkMod<LhsType>(Lhs, Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportMod<LhsType, RhsType>(Res, Lhs, Rhs,
+                                  support::getTypeName<LhsType>(Site, 0),
+                                  Site->Filename, Site->Line);
+  }
+  return Lhs % Rhs;
+}
+
+template <typename LhsType, typename RhsType>
+UB_TESTER_COLD void reportBitShiftLeft(ArithmCheckRes Res, LhsType Lhs,
+                                       RhsType Rhs, const char* LhsTypeName,
+                                       const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsType>(Res) &&
+      support::skipReport<LhsType, RhsType>(EventKind::BitShiftLeft, Res,
+                                            Filename, Line, {LhsTypeName}, Lhs,
+                                            Rhs))
+    return;
   using UnsignedLhsType = typename std::make_unsigned<LhsType>::type;
   std::stringstream Message;
-
-  switch (arithm::checkers::checkBitShiftLeft<LhsType, RhsType>(Lhs, Rhs)) {
+  switch (Res) {
   case ArithmCheckRes::BITSHIFT_NEGATIVE_RHS:
     Message << LhsTypeName << " bitshift left (<<) is undefined in " << Filename
             << " Line: " << Line << "\nlog: negative rhs; " << +Rhs << " < 0\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::BITSHIFT_RHS_GEQ_LHSTYPE_IN_BITS:
     Message << LhsTypeName << " bitshift left (<<) is undefined in " << Filename
             << " Line: " << Line << "\nlog: rhs >= number of bits in lhs type; "
             << +Rhs << " >= " << +arithm_util::getTypeSizeInBits<LhsType>()
             << "\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str(), Filename, Line);
+    break;
 
 #if __cplusplus > 201703L // only since C++20
   case ArithmCheckRes::OVERFLOW_MAX_IN_BITSHIFT_LEFT_CXX20:
@@ -329,20 +551,21 @@ LhsType assertBitShiftLeft(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
             << "\nlog: (" << +Lhs << " << " << +Rhs << ") > "
             << +std::numeric_limits<LhsType>::max() << "\n";
     PUSH_WARNING(OVERFLOW_IN_BITSHIFT_CXX20_WARNING, Message.str());
-    return Lhs << Rhs;
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN_IN_BITSHIFT_LEFT_CXX20:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: (" << +Lhs << " << " << +Rhs << ") < "
             << +std::numeric_limits<LhsType>::min() << "\n";
     PUSH_WARNING(OVERFLOW_IN_BITSHIFT_CXX20_WARNING, Message.str());
-    return Lhs << Rhs;
+    break;
 #endif
 
   case ArithmCheckRes::BITSHIFT_LEFT_NEGATIVE_LHS:
     Message << LhsTypeName << " bitshift left (<<) is undefined in " << Filename
             << " Line: " << Line << "\nlog: negative lhs; " << +Lhs << " < 0\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::
       BITSHIFT_LEFT_RES_OVERFLOWS_UNSIGNED_MAX_WITH_NONNEG_SIGNED_LHS:
@@ -352,104 +575,170 @@ LhsType assertBitShiftLeft(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
                "representable in unsigned version of lhs type; ("
             << +Lhs << " << " << +Rhs << ") > "
             << std::numeric_limits<UnsignedLhsType>::max() << "\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: (" << +Lhs << " << " << +Rhs << ") > "
             << +std::numeric_limits<LhsType>::max() << "\n";
-    OVERFLOW_DETECTED(LhsType, Message.str());
-    return Lhs << Rhs;
+    OVERFLOW_DETECTED(LhsType, Message.str(), Filename, Line);
+    break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    return Lhs << Rhs;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkBitShiftLeft");
   }
 }
 
 template <typename LhsType, typename RhsType>
-LhsType assertBitShiftRight(LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
-                            const char* Filename, int Line) {
+LhsType assertBitShiftLeft(LhsType Lhs, RhsType Rhs, const CheckSite* Site) {
   static_assert(std::numeric_limits<LhsType>::is_integer);
   static_assert(std::numeric_limits<RhsType>::is_integer);
   HAS_CONV_RANK_GEQ_THAN_INT(LhsType); // integral promotion is expected
   HAS_CONV_RANK_GEQ_THAN_INT(RhsType); // integral promotion is expected
-  std::stringstream Message;
+  if constexpr (!config::DISABLE_BITSHIFT_LEFT_CHECKS) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs << Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkBitShiftLeft<LhsType, RhsType>(Lhs, Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportBitShiftLeft<LhsType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0),
+          Site->Filename, Site->Line);
+  }
+  return Lhs << Rhs;
+}
 
-  switch (arithm::checkers::checkBitShiftRight<LhsType, RhsType>(Lhs, Rhs)) {
+template <typename LhsType, typename RhsType>
+UB_TESTER_COLD void reportBitShiftRight(ArithmCheckRes Res, LhsType Lhs,
+                                        RhsType Rhs, const char* LhsTypeName,
+                                        const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsType>(Res) &&
+      support::skipReport<LhsType, RhsType>(EventKind::BitShiftRight, Res,
+                                            Filename, Line, {LhsTypeName}, Lhs,
+                                            Rhs))
+    return;
+  std::stringstream Message;
+  switch (Res) {
   case ArithmCheckRes::BITSHIFT_NEGATIVE_RHS:
     Message << LhsTypeName << " bitshift right (>>) is undefined in "
             << Filename << " Line: " << Line << "\nlog: negative rhs; " << +Rhs
             << " < 0\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_RIGHT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_RIGHT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::BITSHIFT_RHS_GEQ_LHSTYPE_IN_BITS:
     Message << LhsTypeName << " bitshift right (>>) is undefined in "
             << Filename << " Line: " << Line
             << "\nlog: rhs >= number of bits in lhs type; " << +Rhs
             << " >= " << +arithm_util::getTypeSizeInBits<LhsType>() << "\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_RIGHT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_RIGHT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::IMPL_DEFINED_OPERATION:
     Message << LhsTypeName
             << " bitshift right (>>) is implementation-defined in " << Filename
             << " Line: " << Line << "\nlog: negative lhs; " << +Lhs << " < 0\n";
     PUSH_WARNING(IMPL_DEFINED_WARNING, Message.str());
-    return Lhs >> Rhs;
+    break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    return Lhs >> Rhs;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkBitShiftRight");
   }
 }
 
+template <typename LhsType, typename RhsType>
+LhsType assertBitShiftRight(LhsType Lhs, RhsType Rhs, const CheckSite* Site) {
+  static_assert(std::numeric_limits<LhsType>::is_integer);
+  static_assert(std::numeric_limits<RhsType>::is_integer);
+  HAS_CONV_RANK_GEQ_THAN_INT(LhsType); // integral promotion is expected
+  HAS_CONV_RANK_GEQ_THAN_INT(RhsType); // integral promotion is expected
+  if constexpr (!config::DISABLE_BITSHIFT_RIGHT_CHECKS) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs >> Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkBitShiftRight<LhsType, RhsType>(Lhs, Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportBitShiftRight<LhsType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0), Site->Filename,
+          Site->Line);
+  }
+  return Lhs >> Rhs;
+}
+
 template <typename T>
-T assertUnaryNeg(T Expr, const char* TypeName, const char* Filename, int Line) {
-  FLT_POINT_NOT_SUPPORTED(T);
-  HAS_CONV_RANK_GEQ_THAN_INT(T); // integral promotion is expected
+UB_TESTER_COLD void reportUnaryNeg(ArithmCheckRes Res, T Expr,
+                                   const char* TypeName, const char* Filename,
+                                   int Line) {
+  if (!support::isErrorRes<T>(Res) &&
+      support::skipReport<T>(EventKind::UnaryNeg, Res, Filename, Line,
+                             {TypeName}, Expr))
+    return;
   std::stringstream Message;
-
-  switch (arithm::checkers::checkUnaryNeg<T>(Expr)) {
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << TypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: -(" << +Expr << ") > " << +std::numeric_limits<T>::max()
             << "\n";
-    OVERFLOW_DETECTED(T, Message.str());
-    return -Expr;
+    OVERFLOW_DETECTED(T, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     Message << TypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: -(" << +Expr << ") < "
             << +std::numeric_limits<T>::lowest() << "\n";
-    OVERFLOW_DETECTED(T, Message.str());
-    return -Expr;
+    OVERFLOW_DETECTED(T, Message.str(), Filename, Line);
+    break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    return -Expr;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkUnaryNeg");
   }
 }
 
+template <typename T>
+T assertUnaryNeg(T Expr, const CheckSite* Site) {
+  FLT_POINT_NOT_SUPPORTED(T);
+  HAS_CONV_RANK_GEQ_THAN_INT(T); // integral promotion is expected
+  if constexpr (support::isOverflowCheckNeeded<T>(
+                    config::DISABLE_UNARY_NEG_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return -Expr;
+    ArithmCheckRes Res = arithm::checkers::checkUnaryNeg<T>(Expr);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportUnaryNeg<T>(Res, Expr, support::getTypeName<T>(Site, 0),
+                        Site->Filename, Site->Line);
+  }
+  return -Expr;
+}
+
 namespace support {
 
+// temporary solution of getting CommonTypeName as string
+template <typename CommonType>
+std::string getCommonTypeName(const char* TypeName) {
+  std::string CommonTypeName =
+      arithm_util::tmp_functions::getIntTypeAsString<CommonType>();
+  if (CommonTypeName == "undefined type")
+    CommonTypeName = "std::common_type<" + std::string(TypeName) + ", int>";
+  return CommonTypeName;
+}
+
 template <typename Type, typename CommonType>
-void assertIncrOrDecrOpResTypeConv(Type Expr, CommonType ComputedOperationRes,
-                                   const char* OpName, const char* InnerOpName,
-                                   const char* OpAppliedOnExprName,
-                                   const char* CompAssignOpAppliedOnExprName,
-                                   const char* TypeName,
-                                   const char* CommonTypeName,
-                                   const char* Filename, int Line) {
-  static_assert(std::numeric_limits<Type>::is_integer);
-  static_assert(std::numeric_limits<CommonType>::is_integer);
+UB_TESTER_COLD void reportIncrOrDecrOpResTypeConv(
+    TyCoCheckRes Res, Type Expr, CommonType ComputedOperationRes,
+    const char* OpName, const char* InnerOpName,
+    const char* OpAppliedOnExprName, const char* CompAssignOpAppliedOnExprName,
+    const char* TypeName, const char* Filename, int Line) {
+  if (support::skipReport<Type, CommonType>(
+          EventKind::IncrOrDecrOpResTypeConv, Res, Filename, Line,
+          {OpName, InnerOpName, OpAppliedOnExprName,
+           CompAssignOpAppliedOnExprName, TypeName},
+          Expr, ComputedOperationRes))
+    return;
   CommonType ExprInCommonType = static_cast<CommonType>(Expr);
+  std::string CommonTypeName = getCommonTypeName<CommonType>(TypeName);
   std::stringstream Message;
-
-  switch (type_conv::Conversions<CommonType, Type>::checkIntegralConv(
-      ComputedOperationRes)) {
+  switch (Res) {
   case TyCoCheckRes::NEG_VALUE_TO_UNSIGNED_TYPE_CONVERSION:
     Message << "unsafe conversion while (" << OpName << ") computation in "
             << Filename << " Line: " << Line << "\nlog: " << OpAppliedOnExprName
@@ -529,12 +818,29 @@ void assertIncrOrDecrOpResTypeConv(Type Expr, CommonType ComputedOperationRes,
     assert(
         0 &&
         "bool prefix/postfix increment/decrement are deprecated since C++17");
-
-  case TyCoCheckRes::SAFE_CONVERSION:
     break;
+  default:
+    assert(0 && "Unexpected TyCoCheckRes from checkIntegralConv");
   }
 }
 
+template <typename Type, typename CommonType>
+void assertIncrOrDecrOpResTypeConv(
+    Type Expr, CommonType ComputedOperationRes, const char* OpName,
+    const char* InnerOpName, const char* OpAppliedOnExprName,
+    const char* CompAssignOpAppliedOnExprName, const CheckSite* Site) {
+  static_assert(std::numeric_limits<Type>::is_integer);
+  static_assert(std::numeric_limits<CommonType>::is_integer);
+  TyCoCheckRes Res =
+      type_conv::Conversions<CommonType, Type>::checkIntegralConv(
+          ComputedOperationRes);
+  if (UB_TESTER_UNLIKELY(Res != TyCoCheckRes::SAFE_CONVERSION))
+    reportIncrOrDecrOpResTypeConv<Type, CommonType>(
+        Res, Expr, ComputedOperationRes, OpName, InnerOpName,
+        OpAppliedOnExprName, CompAssignOpAppliedOnExprName,
+        support::getTypeName<Type>(Site, 0), Site->Filename, Site->Line);
+}
+
 } // namespace support
 
 /* computation of incr/decr operators applied on x <=> computation of x +=/-= 1:
@@ -544,27 +850,20 @@ void assertIncrOrDecrOpResTypeConv(Type Expr, CommonType ComputedOperationRes,
  * (of course, postfix operators return copy of x, but point 3) still occurs */
 
 template <typename T>
-inline T& assertPrefixIncr(T& Expr, const char* TypeName, const char* Filename,
-                           int Line) {
-  FLT_POINT_NOT_SUPPORTED(T);
+UB_TESTER_COLD void reportPrefixIncr(ArithmCheckRes Res, T Expr,
+                                     const char* TypeName, const char* Filename,
+                                     int Line) {
   using CommonType = typename std::common_type<T, int>::type;
-  HAS_CONV_RANK_GEQ_THAN_INT(CommonType);
-  assert((type_conv::Conversions<T, CommonType>::checkIntegralConv(Expr) ==
-          TyCoCheckRes::SAFE_CONVERSION));
-  assert((type_conv::Conversions<int, CommonType>::checkIntegralConv(1) ==
-          TyCoCheckRes::SAFE_CONVERSION));
+  if (!support::isErrorRes<CommonType>(Res) &&
+      support::skipReport<T>(EventKind::PrefixIncr, Res, Filename, Line,
+                             {TypeName}, Expr))
+    return;
   CommonType ExprInCommonType = static_cast<CommonType>(Expr);
-  CommonType RhsInCommonType = static_cast<CommonType>(1);
   std::stringstream Message;
-
-  // temporary solution of getting CommonTypeName as string
   std::string CommonTypeName =
-      arithm_util::tmp_functions::getIntTypeAsString<CommonType>();
-  if (CommonTypeName == "undefined type")
-    CommonTypeName = "std::common_type<" + std::string(TypeName) + ", int>";
+      support::getCommonTypeName<CommonType>(TypeName);
 
-  switch (arithm::checkers::checkSum<CommonType>(ExprInCommonType,
-                                                 RhsInCommonType)) {
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << CommonTypeName << " overflow in " << Filename
             << " Line: " << Line << "\nlog: ++(" << TypeName << " " << +Expr
@@ -572,34 +871,20 @@ inline T& assertPrefixIncr(T& Expr, const char* TypeName, const char* Filename,
             << +std::numeric_limits<T>::max()
             << "\n     ++expr is computed as expr += 1, i.e. as "
             << CommonTypeName << " expression\n";
-    OVERFLOW_DETECTED(CommonType, Message.str());
+    OVERFLOW_DETECTED(CommonType, Message.str(), Filename, Line);
     break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     assert(0 && "Prefix increment assert detected OVERFLOW_MIN");
-
-  case ArithmCheckRes::SAFE_OPERATION:
     break;
+
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkSum");
   }
-
-  support::assertIncrOrDecrOpResTypeConv<T, CommonType>(
-      Expr, ExprInCommonType + 1, "prefix ++", "+", "++expr", "expr += 1",
-      TypeName, CommonTypeName.c_str(), Filename, Line);
-
-  return ++Expr;
-}
-template <>
-inline bool& assertPrefixIncr<bool>(bool& Expr, const char* TypeName,
-                                    const char* Filename, int Line) {
-  arithm_util::UnusedArgs{Expr, TypeName, Filename, Line};
-  assert(0 && "bool prefix increment is deprecated since C++17");
 }
 
 template <typename T>
-inline T assertPostfixIncr(T& Expr, const char* TypeName, const char* Filename,
-                           int Line) {
+inline T& assertPrefixIncr(T& Expr, const CheckSite* Site) {
   FLT_POINT_NOT_SUPPORTED(T);
   using CommonType = typename std::common_type<T, int>::type;
   HAS_CONV_RANK_GEQ_THAN_INT(CommonType);
@@ -609,16 +894,48 @@ inline T assertPostfixIncr(T& Expr, const char* TypeName, const char* Filename,
           TyCoCheckRes::SAFE_CONVERSION));
   CommonType ExprInCommonType = static_cast<CommonType>(Expr);
   CommonType RhsInCommonType = static_cast<CommonType>(1);
-  std::stringstream Message;
+  if constexpr (support::isOverflowCheckNeeded<CommonType>(
+                    config::DISABLE_INCR_DECR_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return ++Expr;
+    ArithmCheckRes Res = arithm::checkers::checkSum<CommonType>(
+        ExprInCommonType, RhsInCommonType);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportPrefixIncr<T>(Res, Expr, support::getTypeName<T>(Site, 0),
+                          Site->Filename, Site->Line);
+  }
 
-  // temporary solution of getting CommonTypeName as string
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_INCR_DECR_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return ++Expr;
+    support::assertIncrOrDecrOpResTypeConv<T, CommonType>(
+        Expr, ExprInCommonType + 1, "prefix ++", "+", "++expr", "expr += 1",
+        Site);
+  }
+
+  return ++Expr;
+}
+template <>
+inline bool& assertPrefixIncr<bool>(bool& Expr, const CheckSite* Site) {
+  arithm_util::UnusedArgs{Expr, Site};
+  assert(0 && "bool prefix increment is deprecated since C++17");
+}
+
+template <typename T>
+UB_TESTER_COLD void reportPostfixIncr(ArithmCheckRes Res, T Expr,
+                                      const char* TypeName,
+                                      const char* Filename, int Line) {
+  using CommonType = typename std::common_type<T, int>::type;
+  if (!support::isErrorRes<CommonType>(Res) &&
+      support::skipReport<T>(EventKind::PostfixIncr, Res, Filename, Line,
+                             {TypeName}, Expr))
+    return;
+  CommonType ExprInCommonType = static_cast<CommonType>(Expr);
+  std::stringstream Message;
   std::string CommonTypeName =
-      arithm_util::tmp_functions::getIntTypeAsString<CommonType>();
-  if (CommonTypeName == "undefined type")
-    CommonTypeName = "std::common_type<" + std::string(TypeName) + ", int>";
+      support::getCommonTypeName<CommonType>(TypeName);
 
-  switch (arithm::checkers::checkSum<CommonType>(ExprInCommonType,
-                                                 RhsInCommonType)) {
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << CommonTypeName << " overflow in " << Filename
             << " Line: " << Line << "\nlog: (" << TypeName << " " << +Expr
@@ -626,34 +943,20 @@ inline T assertPostfixIncr(T& Expr, const char* TypeName, const char* Filename,
             << +std::numeric_limits<T>::max()
             << "\n     expr++ is computed as expr += 1, i.e. as "
             << CommonTypeName << " expression\n";
-    OVERFLOW_DETECTED(CommonType, Message.str());
+    OVERFLOW_DETECTED(CommonType, Message.str(), Filename, Line);
     break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     assert(0 && "Postfix increment assert detected OVERFLOW_MIN");
-
-  case ArithmCheckRes::SAFE_OPERATION:
     break;
+
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkSum");
   }
-
-  support::assertIncrOrDecrOpResTypeConv<T, CommonType>(
-      Expr, ExprInCommonType + 1, "postfix ++", "+", "expr++", "expr += 1",
-      TypeName, CommonTypeName.c_str(), Filename, Line);
-
-  return Expr++;
-}
-template <>
-inline bool assertPostfixIncr<bool>(bool& Expr, const char* TypeName,
-                                    const char* Filename, int Line) {
-  arithm_util::UnusedArgs{Expr, TypeName, Filename, Line};
-  assert(0 && "bool postfix increment is deprecated since C++17");
 }
 
 template <typename T>
-inline T& assertPrefixDecr(T& Expr, const char* TypeName, const char* Filename,
-                           int Line) {
+inline T assertPostfixIncr(T& Expr, const CheckSite* Site) {
   FLT_POINT_NOT_SUPPORTED(T);
   using CommonType = typename std::common_type<T, int>::type;
   HAS_CONV_RANK_GEQ_THAN_INT(CommonType);
@@ -663,18 +966,51 @@ inline T& assertPrefixDecr(T& Expr, const char* TypeName, const char* Filename,
           TyCoCheckRes::SAFE_CONVERSION));
   CommonType ExprInCommonType = static_cast<CommonType>(Expr);
   CommonType RhsInCommonType = static_cast<CommonType>(1);
-  std::stringstream Message;
+  if constexpr (support::isOverflowCheckNeeded<CommonType>(
+                    config::DISABLE_INCR_DECR_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Expr++;
+    ArithmCheckRes Res = arithm::checkers::checkSum<CommonType>(
+        ExprInCommonType, RhsInCommonType);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportPostfixIncr<T>(Res, Expr, support::getTypeName<T>(Site, 0),
+                           Site->Filename, Site->Line);
+  }
+
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_INCR_DECR_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Expr++;
+    support::assertIncrOrDecrOpResTypeConv<T, CommonType>(
+        Expr, ExprInCommonType + 1, "postfix ++", "+", "expr++", "expr += 1",
+        Site);
+  }
 
-  // temporary solution of getting CommonTypeName as string
+  return Expr++;
+}
+template <>
+inline bool assertPostfixIncr<bool>(bool& Expr, const CheckSite* Site) {
+  arithm_util::UnusedArgs{Expr, Site};
+  assert(0 && "bool postfix increment is deprecated since C++17");
+}
+
+template <typename T>
+UB_TESTER_COLD void reportPrefixDecr(ArithmCheckRes Res, T Expr,
+                                     const char* TypeName, const char* Filename,
+                                     int Line) {
+  using CommonType = typename std::common_type<T, int>::type;
+  if (!support::isErrorRes<CommonType>(Res) &&
+      support::skipReport<T>(EventKind::PrefixDecr, Res, Filename, Line,
+                             {TypeName}, Expr))
+    return;
+  CommonType ExprInCommonType = static_cast<CommonType>(Expr);
+  std::stringstream Message;
   std::string CommonTypeName =
-      arithm_util::tmp_functions::getIntTypeAsString<CommonType>();
-  if (CommonTypeName == "undefined type")
-    CommonTypeName = "std::common_type<" + std::string(TypeName) + ", int>";
+      support::getCommonTypeName<CommonType>(TypeName);
 
-  switch (arithm::checkers::checkDiff<CommonType>(ExprInCommonType,
-                                                  RhsInCommonType)) {
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     assert(0 && "Prefix decrement assert detected OVERFLOW_MAX");
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     Message << CommonTypeName << " overflow in " << Filename
@@ -683,31 +1019,16 @@ inline T& assertPrefixDecr(T& Expr, const char* TypeName, const char* Filename,
             << +std::numeric_limits<T>::lowest()
             << "\n     --expr is computed as expr -= 1, i.e. as "
             << CommonTypeName << " expression\n";
-    OVERFLOW_DETECTED(CommonType, Message.str());
+    OVERFLOW_DETECTED(CommonType, Message.str(), Filename, Line);
     break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    break;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkDiff");
   }
-
-  support::assertIncrOrDecrOpResTypeConv<T, CommonType>(
-      Expr, ExprInCommonType - 1, "prefix --", "-", "--expr", "expr -= 1",
-      TypeName, CommonTypeName.c_str(), Filename, Line);
-
-  return --Expr;
-}
-template <>
-inline bool& assertPrefixDecr<bool>(bool& Expr, const char* TypeName,
-                                    const char* Filename, int Line) {
-  arithm_util::UnusedArgs{Expr, TypeName, Filename, Line};
-  assert(0 && "bool prefix decrement is deprecated since C++17");
 }
 
 template <typename T>
-inline T assertPostfixDecr(T& Expr, const char* TypeName, const char* Filename,
-                           int Line) {
+inline T& assertPrefixDecr(T& Expr, const CheckSite* Site) {
   FLT_POINT_NOT_SUPPORTED(T);
   using CommonType = typename std::common_type<T, int>::type;
   HAS_CONV_RANK_GEQ_THAN_INT(CommonType);
@@ -717,18 +1038,52 @@ inline T assertPostfixDecr(T& Expr, const char* TypeName, const char* Filename,
           TyCoCheckRes::SAFE_CONVERSION));
   CommonType ExprInCommonType = static_cast<CommonType>(Expr);
   CommonType RhsInCommonType = static_cast<CommonType>(1);
-  std::stringstream Message;
+  if constexpr (support::isOverflowCheckNeeded<CommonType>(
+                    config::DISABLE_INCR_DECR_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return --Expr;
+    ArithmCheckRes Res =
+        arithm::checkers::checkDiff<CommonType>(ExprInCommonType,
+                                                RhsInCommonType);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportPrefixDecr<T>(Res, Expr, support::getTypeName<T>(Site, 0),
+                          Site->Filename, Site->Line);
+  }
+
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_INCR_DECR_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return --Expr;
+    support::assertIncrOrDecrOpResTypeConv<T, CommonType>(
+        Expr, ExprInCommonType - 1, "prefix --", "-", "--expr", "expr -= 1",
+        Site);
+  }
+
+  return --Expr;
+}
+template <>
+inline bool& assertPrefixDecr<bool>(bool& Expr, const CheckSite* Site) {
+  arithm_util::UnusedArgs{Expr, Site};
+  assert(0 && "bool prefix decrement is deprecated since C++17");
+}
 
-  // temporary solution of getting CommonTypeName as string
+template <typename T>
+UB_TESTER_COLD void reportPostfixDecr(ArithmCheckRes Res, T Expr,
+                                      const char* TypeName,
+                                      const char* Filename, int Line) {
+  using CommonType = typename std::common_type<T, int>::type;
+  if (!support::isErrorRes<CommonType>(Res) &&
+      support::skipReport<T>(EventKind::PostfixDecr, Res, Filename, Line,
+                             {TypeName}, Expr))
+    return;
+  CommonType ExprInCommonType = static_cast<CommonType>(Expr);
+  std::stringstream Message;
   std::string CommonTypeName =
-      arithm_util::tmp_functions::getIntTypeAsString<CommonType>();
-  if (CommonTypeName == "undefined type")
-    CommonTypeName = "std::common_type<" + std::string(TypeName) + ", int>";
+      support::getCommonTypeName<CommonType>(TypeName);
 
-  switch (arithm::checkers::checkDiff<CommonType>(ExprInCommonType,
-                                                  RhsInCommonType)) {
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     assert(0 && "Postfix decrement assert detected OVERFLOW_MAX");
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
     Message << CommonTypeName << " overflow in " << Filename
@@ -737,46 +1092,70 @@ inline T assertPostfixDecr(T& Expr, const char* TypeName, const char* Filename,
             << +std::numeric_limits<T>::lowest()
             << "\n     expr-- is computed as expr -= 1, i.e. as "
             << CommonTypeName << " expression\n";
-    OVERFLOW_DETECTED(CommonType, Message.str());
+    OVERFLOW_DETECTED(CommonType, Message.str(), Filename, Line);
     break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    break;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkDiff");
   }
+}
+
+template <typename T>
+inline T assertPostfixDecr(T& Expr, const CheckSite* Site) {
+  FLT_POINT_NOT_SUPPORTED(T);
+  using CommonType = typename std::common_type<T, int>::type;
+  HAS_CONV_RANK_GEQ_THAN_INT(CommonType);
+  assert((type_conv::Conversions<T, CommonType>::checkIntegralConv(Expr) ==
+          TyCoCheckRes::SAFE_CONVERSION));
+  assert((type_conv::Conversions<int, CommonType>::checkIntegralConv(1) ==
+          TyCoCheckRes::SAFE_CONVERSION));
+  CommonType ExprInCommonType = static_cast<CommonType>(Expr);
+  CommonType RhsInCommonType = static_cast<CommonType>(1);
+  if constexpr (support::isOverflowCheckNeeded<CommonType>(
+                    config::DISABLE_INCR_DECR_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Expr--;
+    ArithmCheckRes Res =
+        arithm::checkers::checkDiff<CommonType>(ExprInCommonType,
+                                                RhsInCommonType);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportPostfixDecr<T>(Res, Expr, support::getTypeName<T>(Site, 0),
+                           Site->Filename, Site->Line);
+  }
 
-  support::assertIncrOrDecrOpResTypeConv<T, CommonType>(
-      Expr, ExprInCommonType - 1, "postfix --", "-", "expr--", "expr -= 1",
-      TypeName, CommonTypeName.c_str(), Filename, Line);
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_INCR_DECR_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Expr--;
+    support::assertIncrOrDecrOpResTypeConv<T, CommonType>(
+        Expr, ExprInCommonType - 1, "postfix --", "-", "expr--", "expr -= 1",
+        Site);
+  }
 
   return Expr--;
 }
 template <>
-inline bool assertPostfixDecr<bool>(bool& Expr, const char* TypeName,
-                                    const char* Filename, int Line) {
-  arithm_util::UnusedArgs{Expr, TypeName, Filename, Line};
+inline bool assertPostfixDecr<bool>(bool& Expr, const CheckSite* Site) {
+  arithm_util::UnusedArgs{Expr, Site};
   assert(0 && "bool postfix decrement is deprecated since C++17");
 }
 
 namespace support {
 
 template <typename LhsType, typename LhsComputationType>
-void checkCompAssignOpResTypeConv(LhsType Lhs, LhsComputationType Rhs,
-                                  LhsComputationType ComputedOperationRes,
-                                  const char* InnerOpName,
-                                  const char* LhsTypeName,
-                                  const char* LhsComputationTypeName,
-                                  const char* Filename, int Line) {
-  static_assert(std::numeric_limits<LhsType>::is_integer);
-  static_assert(std::numeric_limits<LhsComputationType>::is_integer);
+UB_TESTER_COLD void reportCompAssignOpResTypeConv(
+    TyCoCheckRes Res, LhsType Lhs, LhsComputationType Rhs,
+    LhsComputationType ComputedOperationRes, const char* InnerOpName,
+    const char* LhsTypeName, const char* LhsComputationTypeName,
+    const char* Filename, int Line) {
+  if (support::skipReport<LhsType, LhsComputationType>(
+          EventKind::CompAssignOpResTypeConv, Res, Filename, Line,
+          {InnerOpName, LhsTypeName, LhsComputationTypeName}, Lhs, Rhs,
+          ComputedOperationRes))
+    return;
   LhsComputationType LhsInComputationType =
       static_cast<LhsComputationType>(Lhs);
   std::stringstream Message;
-
-  switch (
-      type_conv::Conversions<LhsComputationType, LhsType>::checkIntegralConv(
-          ComputedOperationRes)) {
+  switch (Res) {
   case TyCoCheckRes::NEG_VALUE_TO_UNSIGNED_TYPE_CONVERSION:
     Message << "unsafe conversion while (" << InnerOpName
             << "=) computation in " << Filename << " Line: " << Line
@@ -864,28 +1243,45 @@ void checkCompAssignOpResTypeConv(LhsType Lhs, LhsComputationType Rhs,
             << LhsComputationTypeName << " to " << LhsTypeName << "\n";
     PUSH_WARNING(NOT_CONSIDERED_WARNING, Message.str());
     break;
-
-  case TyCoCheckRes::SAFE_CONVERSION:
-    break;
+  default:
+    assert(0 && "Unexpected TyCoCheckRes from checkIntegralConv");
   }
 }
 
+template <typename LhsType, typename LhsComputationType>
+void checkCompAssignOpResTypeConv(LhsType Lhs, LhsComputationType Rhs,
+                                  LhsComputationType ComputedOperationRes,
+                                  const char* InnerOpName,
+                                  const CheckSite* Site) {
+  static_assert(std::numeric_limits<LhsType>::is_integer);
+  static_assert(std::numeric_limits<LhsComputationType>::is_integer);
+  TyCoCheckRes Res =
+      type_conv::Conversions<LhsComputationType, LhsType>::checkIntegralConv(
+          ComputedOperationRes);
+  if (UB_TESTER_UNLIKELY(Res != TyCoCheckRes::SAFE_CONVERSION))
+    reportCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Res, Lhs, Rhs, ComputedOperationRes, InnerOpName,
+        support::getTypeName<LhsType>(Site, 0),
+        support::getTypeName<LhsComputationType>(Site, 1), Site->Filename,
+        Site->Line);
+}
+
 } // namespace support
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
-LhsType& assertCompAssignOpSum(LhsType& Lhs, RhsType Rhs,
-                               const char* LhsTypeName,
-                               const char* LhsComputationTypeName,
-                               const char* Filename, int Line) {
-  FLT_POINT_NOT_SUPPORTED(LhsType);
-  FLT_POINT_NOT_SUPPORTED(LhsComputationType);
-  ARE_SAME_TYPES(LhsComputationType, RhsType);
+UB_TESTER_COLD void reportCompAssignOpSum(ArithmCheckRes Res, LhsType Lhs,
+                                          RhsType Rhs, const char* LhsTypeName,
+                                          const char* LhsComputationTypeName,
+                                          const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsComputationType>(Res) &&
+      support::skipReport<LhsType, LhsComputationType, RhsType>(
+          EventKind::CompAssignOpSum, Res, Filename, Line,
+          {LhsTypeName, LhsComputationTypeName}, Lhs, Rhs))
+    return;
   LhsComputationType LhsInComputationType =
       static_cast<LhsComputationType>(Lhs);
   std::stringstream Message;
-
-  switch (arithm::checkers::checkSum<LhsComputationType>(
-      static_cast<LhsComputationType>(Lhs), Rhs)) {
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsComputationTypeName << " overflow in " << Filename
             << " Line: " << Line << "\nlog: "
@@ -895,7 +1291,7 @@ LhsType& assertCompAssignOpSum(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::max()
             << ";\n     lhs += rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
@@ -907,39 +1303,61 @@ LhsType& assertCompAssignOpSum(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::lowest()
             << ";\n     lhs += rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    break;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkSum");
   }
+}
+
+template <typename LhsType, typename LhsComputationType, typename RhsType>
+LhsType& assertCompAssignOpSum(LhsType& Lhs, RhsType Rhs,
+                               const CheckSite* Site) {
+  FLT_POINT_NOT_SUPPORTED(LhsType);
+  FLT_POINT_NOT_SUPPORTED(LhsComputationType);
+  ARE_SAME_TYPES(LhsComputationType, RhsType);
+  LhsComputationType LhsInComputationType =
+      static_cast<LhsComputationType>(Lhs);
+  if constexpr (support::isOverflowCheckNeeded<LhsComputationType>(
+                    config::DISABLE_SUM_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs += Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkSum<LhsComputationType>(
+            static_cast<LhsComputationType>(Lhs), Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportCompAssignOpSum<LhsType, LhsComputationType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0),
+          support::getTypeName<LhsComputationType>(Site, 1), Site->Filename,
+          Site->Line);
+  }
 
   // after (LhsInComputationType + Rhs) is computed, it is converted to
   // LhsType
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, LhsInComputationType + Rhs, "+", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_SUM_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs += Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, LhsInComputationType + Rhs, "+", Site);
+  }
   return Lhs += Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
-LhsType& assertCompAssignOpDiff(LhsType& Lhs, RhsType Rhs,
-                                const char* LhsTypeName,
-                                const char* LhsComputationTypeName,
-                                const char* Filename, int Line) {
-  FLT_POINT_NOT_SUPPORTED(LhsType);
-  FLT_POINT_NOT_SUPPORTED(LhsComputationType);
-  ARE_SAME_TYPES(LhsComputationType, RhsType);
-  HAS_CONV_RANK_GEQ_THAN_INT(
-      LhsComputationType); // integral promotion is expected
+UB_TESTER_COLD void reportCompAssignOpDiff(ArithmCheckRes Res, LhsType Lhs,
+                                           RhsType Rhs, const char* LhsTypeName,
+                                           const char* LhsComputationTypeName,
+                                           const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsComputationType>(Res) &&
+      support::skipReport<LhsType, LhsComputationType, RhsType>(
+          EventKind::CompAssignOpDiff, Res, Filename, Line,
+          {LhsTypeName, LhsComputationTypeName}, Lhs, Rhs))
+    return;
   LhsComputationType LhsInComputationType =
       static_cast<LhsComputationType>(Lhs);
   std::stringstream Message;
-
-  switch (arithm::checkers::checkDiff<LhsComputationType>(
-      static_cast<LhsComputationType>(Lhs), Rhs)) {
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsComputationTypeName << " overflow in " << Filename
             << " Line: " << Line << "\nlog: "
@@ -949,7 +1367,7 @@ LhsType& assertCompAssignOpDiff(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::max()
             << ";\n     lhs -= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
@@ -961,29 +1379,17 @@ LhsType& assertCompAssignOpDiff(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::lowest()
             << ";\n     lhs -= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    break;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkDiff");
   }
-
-  // after (LhsInComputationType - Rhs) is computed, it is converted to
-  // LhsType
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, LhsInComputationType - Rhs, "-", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
-
-  return Lhs -= Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
-LhsType& assertCompAssignOpMul(LhsType& Lhs, RhsType Rhs,
-                               const char* LhsTypeName,
-                               const char* LhsComputationTypeName,
-                               const char* Filename, int Line) {
+LhsType& assertCompAssignOpDiff(LhsType& Lhs, RhsType Rhs,
+                                const CheckSite* Site) {
   FLT_POINT_NOT_SUPPORTED(LhsType);
   FLT_POINT_NOT_SUPPORTED(LhsComputationType);
   ARE_SAME_TYPES(LhsComputationType, RhsType);
@@ -991,10 +1397,46 @@ LhsType& assertCompAssignOpMul(LhsType& Lhs, RhsType Rhs,
       LhsComputationType); // integral promotion is expected
   LhsComputationType LhsInComputationType =
       static_cast<LhsComputationType>(Lhs);
-  std::stringstream Message;
+  if constexpr (support::isOverflowCheckNeeded<LhsComputationType>(
+                    config::DISABLE_DIFF_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs -= Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkDiff<LhsComputationType>(
+            static_cast<LhsComputationType>(Lhs), Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportCompAssignOpDiff<LhsType, LhsComputationType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0),
+          support::getTypeName<LhsComputationType>(Site, 1), Site->Filename,
+          Site->Line);
+  }
+
+  // after (LhsInComputationType - Rhs) is computed, it is converted to
+  // LhsType
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_DIFF_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs -= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, LhsInComputationType - Rhs, "-", Site);
+  }
 
-  switch (arithm::checkers::checkMul<LhsComputationType>(
-      static_cast<LhsComputationType>(Lhs), Rhs)) {
+  return Lhs -= Rhs;
+}
+
+template <typename LhsType, typename LhsComputationType, typename RhsType>
+UB_TESTER_COLD void reportCompAssignOpMul(ArithmCheckRes Res, LhsType Lhs,
+                                          RhsType Rhs, const char* LhsTypeName,
+                                          const char* LhsComputationTypeName,
+                                          const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsComputationType>(Res) &&
+      support::skipReport<LhsType, LhsComputationType, RhsType>(
+          EventKind::CompAssignOpMul, Res, Filename, Line,
+          {LhsTypeName, LhsComputationTypeName}, Lhs, Rhs))
+    return;
+  LhsComputationType LhsInComputationType =
+      static_cast<LhsComputationType>(Lhs);
+  std::stringstream Message;
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsComputationTypeName << " overflow in " << Filename
             << " Line: " << Line << "\nlog: "
@@ -1004,7 +1446,7 @@ LhsType& assertCompAssignOpMul(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::max()
             << ";\n     lhs *= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
@@ -1016,29 +1458,17 @@ LhsType& assertCompAssignOpMul(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::lowest()
             << ";\n     lhs *= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    break;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkMul");
   }
-
-  // after (LhsInComputationType * Rhs) is computed, it is converted to
-  // LhsType
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, LhsInComputationType * Rhs, "*", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
-
-  return Lhs *= Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
-LhsType& assertCompAssignOpDiv(LhsType& Lhs, RhsType Rhs,
-                               const char* LhsTypeName,
-                               const char* LhsComputationTypeName,
-                               const char* Filename, int Line) {
+LhsType& assertCompAssignOpMul(LhsType& Lhs, RhsType Rhs,
+                               const CheckSite* Site) {
   FLT_POINT_NOT_SUPPORTED(LhsType);
   FLT_POINT_NOT_SUPPORTED(LhsComputationType);
   ARE_SAME_TYPES(LhsComputationType, RhsType);
@@ -1046,10 +1476,46 @@ LhsType& assertCompAssignOpDiv(LhsType& Lhs, RhsType Rhs,
       LhsComputationType); // integral promotion is expected
   LhsComputationType LhsInComputationType =
       static_cast<LhsComputationType>(Lhs);
-  std::stringstream Message;
+  if constexpr (support::isOverflowCheckNeeded<LhsComputationType>(
+                    config::DISABLE_MUL_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs *= Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkMul<LhsComputationType>(
+            static_cast<LhsComputationType>(Lhs), Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportCompAssignOpMul<LhsType, LhsComputationType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0),
+          support::getTypeName<LhsComputationType>(Site, 1), Site->Filename,
+          Site->Line);
+  }
 
-  switch (arithm::checkers::checkDiv<LhsComputationType>(
-      static_cast<LhsComputationType>(Lhs), Rhs)) {
+  // after (LhsInComputationType * Rhs) is computed, it is converted to
+  // LhsType
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_MUL_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs *= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, LhsInComputationType * Rhs, "*", Site);
+  }
+
+  return Lhs *= Rhs;
+}
+
+template <typename LhsType, typename LhsComputationType, typename RhsType>
+UB_TESTER_COLD void reportCompAssignOpDiv(ArithmCheckRes Res, LhsType Lhs,
+                                          RhsType Rhs, const char* LhsTypeName,
+                                          const char* LhsComputationTypeName,
+                                          const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsComputationType>(Res) &&
+      support::skipReport<LhsType, LhsComputationType, RhsType>(
+          EventKind::CompAssignOpDiv, Res, Filename, Line,
+          {LhsTypeName, LhsComputationTypeName}, Lhs, Rhs))
+    return;
+  LhsComputationType LhsInComputationType =
+      static_cast<LhsComputationType>(Lhs);
+  std::stringstream Message;
+  switch (Res) {
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsComputationTypeName << " overflow in " << Filename
             << " Line: " << Line << "\nlog: "
@@ -1059,7 +1525,7 @@ LhsType& assertCompAssignOpDiv(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::max()
             << ";\n     lhs /= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
   case ArithmCheckRes::OVERFLOW_MIN:
@@ -1071,46 +1537,70 @@ LhsType& assertCompAssignOpDiv(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::lowest()
             << ";\n     lhs /= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
   case ArithmCheckRes::DIV_BY_0:
     Message << LhsComputationTypeName << " /= by 0 in " << Filename
             << " Line: " << Line << "\nlog: lhs /= rhs is computed as "
             << LhsComputationTypeName << " expression\n";
-    PUSH_ERROR(DIVISION_BY_ZERO_ERROR, Message.str());
-
-  case ArithmCheckRes::SAFE_OPERATION:
+    PUSH_ERROR(DIVISION_BY_ZERO_ERROR, Message.str(), Filename, Line);
     break;
+
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkDiv");
   }
+}
+
+template <typename LhsType, typename LhsComputationType, typename RhsType>
+LhsType& assertCompAssignOpDiv(LhsType& Lhs, RhsType Rhs,
+                               const CheckSite* Site) {
+  FLT_POINT_NOT_SUPPORTED(LhsType);
+  FLT_POINT_NOT_SUPPORTED(LhsComputationType);
+  ARE_SAME_TYPES(LhsComputationType, RhsType);
+  HAS_CONV_RANK_GEQ_THAN_INT(
+      LhsComputationType); // integral promotion is expected
+  LhsComputationType LhsInComputationType =
+      static_cast<LhsComputationType>(Lhs);
+  if constexpr (!config::DISABLE_DIV_CHECKS) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs /= Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkDiv<LhsComputationType>(
+            static_cast<LhsComputationType>(Lhs), Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportCompAssignOpDiv<LhsType, LhsComputationType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0),
+          support::getTypeName<LhsComputationType>(Site, 1), Site->Filename,
+          Site->Line);
+  }
 
   // after (LhsInComputationType / Rhs) is computed, it is converted to
   // LhsType
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, LhsInComputationType / Rhs, "/", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_DIV_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs /= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, LhsInComputationType / Rhs, "/", Site);
+  }
 
   return Lhs /= Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
-LhsType& assertCompAssignOpMod(LhsType& Lhs, RhsType Rhs,
-                               const char* LhsTypeName,
-                               const char* LhsComputationTypeName,
-                               const char* Filename, int Line) {
-  static_assert(std::numeric_limits<LhsType>::is_integer);
-  static_assert(std::numeric_limits<LhsComputationType>::is_integer);
-  ARE_SAME_TYPES(LhsComputationType, RhsType);
-  HAS_CONV_RANK_GEQ_THAN_INT(
-      LhsComputationType); // integral promotion is expected
+UB_TESTER_COLD void reportCompAssignOpMod(ArithmCheckRes Res, LhsType Lhs,
+                                          RhsType Rhs, const char* LhsTypeName,
+                                          const char* LhsComputationTypeName,
+                                          const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsComputationType>(Res) &&
+      support::skipReport<LhsType, LhsComputationType, RhsType>(
+          EventKind::CompAssignOpMod, Res, Filename, Line,
+          {LhsTypeName, LhsComputationTypeName}, Lhs, Rhs))
+    return;
   LhsComputationType LhsInComputationType =
       static_cast<LhsComputationType>(Lhs);
   std::stringstream Message;
-
-  switch (arithm::checkers::checkMod<LhsComputationType>(
-      static_cast<LhsComputationType>(Lhs), Rhs)) {
+  switch (Res) {
   case ArithmCheckRes::MOD_UNDEFINED_DIV_OVERFLOWS_MAX:
     Message << LhsComputationTypeName << " mod (%=) is undefined in "
             << Filename << " Line: " << Line
@@ -1120,7 +1610,8 @@ LhsType& assertCompAssignOpMod(LhsType& Lhs, RhsType Rhs,
             << " / " << +Rhs << " > " << +std::numeric_limits<LhsType>::max()
             << ";\n     lhs %= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    PUSH_ERROR(UNDEFINED_MOD_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_MOD_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::MOD_UNDEFINED_DIV_OVERFLOWS_MIN:
     Message << LhsComputationTypeName << " mod (%=) is undefined in "
@@ -1131,54 +1622,78 @@ LhsType& assertCompAssignOpMod(LhsType& Lhs, RhsType Rhs,
             << " / " << +Rhs << " < " << +std::numeric_limits<LhsType>::lowest()
             << ";\n     lhs %= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    PUSH_ERROR(UNDEFINED_MOD_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_MOD_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::DIV_BY_0:
     Message << LhsComputationTypeName << " mod (%=) by 0 in " << Filename
             << " Line: " << Line << "\nlog: lhs %= rhs is computed as "
             << LhsComputationTypeName << " expression\n";
-    PUSH_ERROR(DIVISION_BY_ZERO_ERROR, Message.str());
-
-  case ArithmCheckRes::SAFE_OPERATION:
+    PUSH_ERROR(DIVISION_BY_ZERO_ERROR, Message.str(), Filename, Line);
     break;
+
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkMod");
   }
+}
+
+template <typename LhsType, typename LhsComputationType, typename RhsType>
+LhsType& assertCompAssignOpMod(LhsType& Lhs, RhsType Rhs,
+                               const CheckSite* Site) {
+  static_assert(std::numeric_limits<LhsType>::is_integer);
+  static_assert(std::numeric_limits<LhsComputationType>::is_integer);
+  ARE_SAME_TYPES(LhsComputationType, RhsType);
+  HAS_CONV_RANK_GEQ_THAN_INT(
+      LhsComputationType); // integral promotion is expected
+  LhsComputationType LhsInComputationType =
+      static_cast<LhsComputationType>(Lhs);
+  if constexpr (!config::DISABLE_MOD_CHECKS) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs %= Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkMod<LhsComputationType>(
+            static_cast<LhsComputationType>(Lhs), Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportCompAssignOpMod<LhsType, LhsComputationType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0),
+          support::getTypeName<LhsComputationType>(Site, 1), Site->Filename,
+          Site->Line);
+  }
 
   // after (LhsInComputationType % Rhs) is computed, it is converted to
   // LhsType
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, LhsInComputationType % Rhs, "%", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
+  if constexpr (support::isConvCheckNeeded(config::DISABLE_MOD_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs %= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, LhsInComputationType % Rhs, "%", Site);
+  }
 
   return Lhs %= Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
-LhsType& assertCompAssignOpBitShiftLeft(LhsType& Lhs, RhsType Rhs,
-                                        const char* LhsTypeName,
-                                        const char* LhsComputationTypeName,
-                                        const char* Filename, int Line) {
-  static_assert(std::numeric_limits<LhsType>::is_integer);
-  static_assert(std::numeric_limits<LhsComputationType>::is_integer);
-  static_assert(std::numeric_limits<RhsType>::is_integer);
-  HAS_CONV_RANK_GEQ_THAN_INT(
-      LhsComputationType);             // integral promotion is expected
-  HAS_CONV_RANK_GEQ_THAN_INT(RhsType); // integral promotion is expected
+UB_TESTER_COLD void reportCompAssignOpBitShiftLeft(
+    ArithmCheckRes Res, LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
+    const char* LhsComputationTypeName, const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsComputationType>(Res) &&
+      support::skipReport<LhsType, LhsComputationType, RhsType>(
+          EventKind::CompAssignOpBitShiftLeft, Res, Filename, Line,
+          {LhsTypeName, LhsComputationTypeName}, Lhs, Rhs))
+    return;
   using UnsignedLhsComputationType =
       typename std::make_unsigned<LhsComputationType>::type;
   LhsComputationType LhsInComputationType =
       static_cast<LhsComputationType>(Lhs);
   std::stringstream Message;
-
-  switch (arithm::checkers::checkBitShiftLeft<LhsComputationType, RhsType>(
-      static_cast<LhsComputationType>(Lhs), Rhs)) {
+  switch (Res) {
   case ArithmCheckRes::BITSHIFT_NEGATIVE_RHS:
     Message << LhsComputationTypeName << " bitshift left (<<=) is undefined in "
             << Filename << " Line: " << Line << "\nlog: negative rhs; " << +Rhs
             << " < 0;\n     lhs <<= rhs is computed as "
             << LhsComputationTypeName << " expression\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::BITSHIFT_RHS_GEQ_LHSTYPE_IN_BITS:
     Message << LhsComputationTypeName << " bitshift left (<<=) is undefined in "
@@ -1187,7 +1702,8 @@ LhsType& assertCompAssignOpBitShiftLeft(LhsType& Lhs, RhsType Rhs,
             << " >= " << +arithm_util::getTypeSizeInBits<LhsComputationType>()
             << ";\n     lhs <<= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str(), Filename, Line);
+    break;
 
 #if __cplusplus > 201703L // only since C++20
   case ArithmCheckRes::OVERFLOW_MAX_IN_BITSHIFT_LEFT_CXX20:
@@ -1195,14 +1711,14 @@ LhsType& assertCompAssignOpBitShiftLeft(LhsType& Lhs, RhsType Rhs,
             << "\nlog: (" << +Lhs << " <<= " << +Rhs << ") > "
             << +std::numeric_limits<LhsType>::max() << "\n";
     PUSH_WARNING(OVERFLOW_IN_BITSHIFT_CXX20_WARNING, Message.str());
-    return Lhs <<= Rhs;
+    break;
 
   case ArithmCheckRes::OVERFLOW_MIN_IN_BITSHIFT_LEFT_CXX20:
     Message << LhsTypeName << " overflow in " << Filename << " Line: " << Line
             << "\nlog: (" << +Lhs << " <<= " << +Rhs << ") < "
             << +std::numeric_limits<LhsType>::min() << "\n";
     PUSH_WARNING(OVERFLOW_IN_BITSHIFT_CXX20_WARNING, Message.str());
-    return Lhs <<= Rhs;
+    break;
 #endif
 
   case ArithmCheckRes::BITSHIFT_LEFT_NEGATIVE_LHS:
@@ -1212,7 +1728,8 @@ LhsType& assertCompAssignOpBitShiftLeft(LhsType& Lhs, RhsType Rhs,
             << LhsComputationTypeName << " " << +LhsInComputationType << ")"
             << " < 0;\n     lhs <<= rhs is computed as "
             << LhsComputationTypeName << " expression\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::
       BITSHIFT_LEFT_RES_OVERFLOWS_UNSIGNED_MAX_WITH_NONNEG_SIGNED_LHS:
@@ -1226,7 +1743,8 @@ LhsType& assertCompAssignOpBitShiftLeft(LhsType& Lhs, RhsType Rhs,
             << std::numeric_limits<UnsignedLhsComputationType>::max()
             << ";\n     lhs <<= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_LEFT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::OVERFLOW_MAX:
     Message << LhsComputationTypeName << " overflow in " << Filename
@@ -1237,29 +1755,17 @@ LhsType& assertCompAssignOpBitShiftLeft(LhsType& Lhs, RhsType Rhs,
             << +std::numeric_limits<LhsComputationType>::max()
             << ";\n     lhs <<= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    OVERFLOW_DETECTED(LhsComputationType, Message.str());
+    OVERFLOW_DETECTED(LhsComputationType, Message.str(), Filename, Line);
     break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    break;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkBitShiftLeft");
   }
-
-  // after (LhsInComputationType << Rhs) is computed, it is converted to
-  // LhsType
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, LhsInComputationType << Rhs, "<<", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
-
-  return Lhs <<= Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
-LhsType& assertCompAssignOpBitShiftRight(LhsType& Lhs, RhsType Rhs,
-                                         const char* LhsTypeName,
-                                         const char* LhsComputationTypeName,
-                                         const char* Filename, int Line) {
+LhsType& assertCompAssignOpBitShiftLeft(LhsType& Lhs, RhsType Rhs,
+                                        const CheckSite* Site) {
   static_assert(std::numeric_limits<LhsType>::is_integer);
   static_assert(std::numeric_limits<LhsComputationType>::is_integer);
   static_assert(std::numeric_limits<RhsType>::is_integer);
@@ -1268,17 +1774,59 @@ LhsType& assertCompAssignOpBitShiftRight(LhsType& Lhs, RhsType Rhs,
   HAS_CONV_RANK_GEQ_THAN_INT(RhsType); // integral promotion is expected
   LhsComputationType LhsInComputationType =
       static_cast<LhsComputationType>(Lhs);
-  std::stringstream Message;
+  if constexpr (!config::DISABLE_BITSHIFT_LEFT_CHECKS) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs <<= Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkBitShiftLeft<LhsComputationType, RhsType>(
+            static_cast<LhsComputationType>(Lhs), Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION)) {
+      reportCompAssignOpBitShiftLeft<LhsType, LhsComputationType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0),
+          support::getTypeName<LhsComputationType>(Site, 1), Site->Filename,
+          Site->Line);
+#if __cplusplus > 201703L // only since C++20
+      if (Res == ArithmCheckRes::OVERFLOW_MAX_IN_BITSHIFT_LEFT_CXX20 ||
+          Res == ArithmCheckRes::OVERFLOW_MIN_IN_BITSHIFT_LEFT_CXX20)
+        return Lhs <<= Rhs;
+#endif
+    }
+  }
+
+  // after (LhsInComputationType << Rhs) is computed, it is converted to
+  // LhsType
+  if constexpr (support::isConvCheckNeeded(
+                    config::DISABLE_BITSHIFT_LEFT_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs <<= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, LhsInComputationType << Rhs, "<<", Site);
+  }
 
-  switch (arithm::checkers::checkBitShiftRight<LhsComputationType, RhsType>(
-      static_cast<LhsComputationType>(Lhs), Rhs)) {
+  return Lhs <<= Rhs;
+}
+
+template <typename LhsType, typename LhsComputationType, typename RhsType>
+UB_TESTER_COLD void reportCompAssignOpBitShiftRight(
+    ArithmCheckRes Res, LhsType Lhs, RhsType Rhs, const char* LhsTypeName,
+    const char* LhsComputationTypeName, const char* Filename, int Line) {
+  if (!support::isErrorRes<LhsComputationType>(Res) &&
+      support::skipReport<LhsType, LhsComputationType, RhsType>(
+          EventKind::CompAssignOpBitShiftRight, Res, Filename, Line,
+          {LhsTypeName, LhsComputationTypeName}, Lhs, Rhs))
+    return;
+  LhsComputationType LhsInComputationType =
+      static_cast<LhsComputationType>(Lhs);
+  std::stringstream Message;
+  switch (Res) {
   case ArithmCheckRes::BITSHIFT_NEGATIVE_RHS:
     Message << LhsComputationTypeName
             << " bitshift right (>>=) is undefined in " << Filename
             << " Line: " << Line << "\nlog: negative rhs; " << +Rhs
             << " < 0;\n     lhs >>= rhs is computed as "
             << LhsComputationTypeName << " expression\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_RIGHT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_RIGHT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::BITSHIFT_RHS_GEQ_LHSTYPE_IN_BITS:
     Message << LhsComputationTypeName
@@ -1288,7 +1836,8 @@ LhsType& assertCompAssignOpBitShiftRight(LhsType& Lhs, RhsType Rhs,
             << " >= " << +arithm_util::getTypeSizeInBits<LhsComputationType>()
             << ";\n     lhs >>= rhs is computed as " << LhsComputationTypeName
             << " expression\n";
-    PUSH_ERROR(UNDEFINED_BITSHIFT_RIGHT_ERROR, Message.str());
+    PUSH_ERROR(UNDEFINED_BITSHIFT_RIGHT_ERROR, Message.str(), Filename, Line);
+    break;
 
   case ArithmCheckRes::IMPL_DEFINED_OPERATION:
     Message << LhsTypeName
@@ -1300,26 +1849,51 @@ LhsType& assertCompAssignOpBitShiftRight(LhsType& Lhs, RhsType Rhs,
     PUSH_WARNING(IMPL_DEFINED_WARNING, Message.str());
     break;
 
-  case ArithmCheckRes::SAFE_OPERATION:
-    break;
   default:
     assert(0 && "Unexpected ArithmCheckRes from checkBitShiftRight");
   }
+}
+
+template <typename LhsType, typename LhsComputationType, typename RhsType>
+LhsType& assertCompAssignOpBitShiftRight(LhsType& Lhs, RhsType Rhs,
+                                         const CheckSite* Site) {
+  static_assert(std::numeric_limits<LhsType>::is_integer);
+  static_assert(std::numeric_limits<LhsComputationType>::is_integer);
+  static_assert(std::numeric_limits<RhsType>::is_integer);
+  HAS_CONV_RANK_GEQ_THAN_INT(
+      LhsComputationType);             // integral promotion is expected
+  HAS_CONV_RANK_GEQ_THAN_INT(RhsType); // integral promotion is expected
+  LhsComputationType LhsInComputationType =
+      static_cast<LhsComputationType>(Lhs);
+  if constexpr (!config::DISABLE_BITSHIFT_RIGHT_CHECKS) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs >>= Rhs;
+    ArithmCheckRes Res =
+        arithm::checkers::checkBitShiftRight<LhsComputationType, RhsType>(
+            static_cast<LhsComputationType>(Lhs), Rhs);
+    if (UB_TESTER_UNLIKELY(Res != ArithmCheckRes::SAFE_OPERATION))
+      reportCompAssignOpBitShiftRight<LhsType, LhsComputationType, RhsType>(
+          Res, Lhs, Rhs, support::getTypeName<LhsType>(Site, 0),
+          support::getTypeName<LhsComputationType>(Site, 1), Site->Filename,
+          Site->Line);
+  }
 
   // after (LhsInComputationType >> Rhs) is computed, it is converted to
   // LhsType
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, LhsInComputationType >> Rhs, ">>", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
+  if constexpr (support::isConvCheckNeeded(
+                    config::DISABLE_BITSHIFT_RIGHT_CHECKS)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs >>= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, LhsInComputationType >> Rhs, ">>", Site);
+  }
 
   return Lhs >>= Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
 LhsType& assertCompAssignOpLogicAnd(LhsType& Lhs, RhsType Rhs,
-                                    const char* LhsTypeName,
-                                    const char* LhsComputationTypeName,
-                                    const char* Filename, int Line) {
+                                    const CheckSite* Site) {
   static_assert(std::numeric_limits<LhsType>::is_integer);
   static_assert(std::numeric_limits<LhsComputationType>::is_integer);
   ARE_SAME_TYPES(LhsComputationType, RhsType);
@@ -1327,18 +1901,19 @@ LhsType& assertCompAssignOpLogicAnd(LhsType& Lhs, RhsType Rhs,
       LhsComputationType); // integral promotion is expected
 
   // (&=) cannot overflow or cause UB, so only conversion check is needed
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, static_cast<LhsComputationType>(Lhs) & Rhs, "&", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
+  if constexpr (support::isConvCheckNeeded(false)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs &= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, static_cast<LhsComputationType>(Lhs) & Rhs, "&", Site);
+  }
 
   return Lhs &= Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
 LhsType& assertCompAssignOpLogicOr(LhsType& Lhs, RhsType Rhs,
-                                   const char* LhsTypeName,
-                                   const char* LhsComputationTypeName,
-                                   const char* Filename, int Line) {
+                                   const CheckSite* Site) {
   static_assert(std::numeric_limits<LhsType>::is_integer);
   static_assert(std::numeric_limits<LhsComputationType>::is_integer);
   ARE_SAME_TYPES(LhsComputationType, RhsType);
@@ -1346,18 +1921,19 @@ LhsType& assertCompAssignOpLogicOr(LhsType& Lhs, RhsType Rhs,
       LhsComputationType); // integral promotion is expected
 
   // (|=) cannot overflow or cause UB, so only conversion check is needed
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, static_cast<LhsComputationType>(Lhs) | Rhs, "|", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
+  if constexpr (support::isConvCheckNeeded(false)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs |= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, static_cast<LhsComputationType>(Lhs) | Rhs, "|", Site);
+  }
 
   return Lhs |= Rhs;
 }
 
 template <typename LhsType, typename LhsComputationType, typename RhsType>
 LhsType& assertCompAssignOpLogicXor(LhsType& Lhs, RhsType Rhs,
-                                    const char* LhsTypeName,
-                                    const char* LhsComputationTypeName,
-                                    const char* Filename, int Line) {
+                                    const CheckSite* Site) {
   static_assert(std::numeric_limits<LhsType>::is_integer);
   static_assert(std::numeric_limits<LhsComputationType>::is_integer);
   ARE_SAME_TYPES(LhsComputationType, RhsType);
@@ -1365,9 +1941,12 @@ LhsType& assertCompAssignOpLogicXor(LhsType& Lhs, RhsType Rhs,
       LhsComputationType); // integral promotion is expected
 
   // (^=) cannot overflow or cause UB, so only conversion check is needed
-  support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
-      Lhs, Rhs, static_cast<LhsComputationType>(Lhs) ^ Rhs, "^", LhsTypeName,
-      LhsComputationTypeName, Filename, Line);
+  if constexpr (support::isConvCheckNeeded(false)) {
+    if (!support::isCheckEnabled(CheckCategory::Arithm, Site))
+      return Lhs ^= Rhs;
+    support::checkCompAssignOpResTypeConv<LhsType, LhsComputationType>(
+        Lhs, Rhs, static_cast<LhsComputationType>(Lhs) ^ Rhs, "^", Site);
+  }
 
   return Lhs ^= Rhs;
 }
@@ -7,6 +7,19 @@
 #define FLT_POINT_NOT_SUPPORTED(Type)                                          \
   static_assert(std::numeric_limits<Type>::is_integer)
 
+// define UB_TESTER_PORTABLE_CHECKERS to force checkers without builtins
+#ifndef UB_TESTER_PORTABLE_CHECKERS
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_add_overflow) &&                                   \
+    __has_builtin(__builtin_sub_overflow) &&                                   \
+    __has_builtin(__builtin_mul_overflow)
+#define UB_TESTER_OVERFLOW_BUILTINS
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 5
+#define UB_TESTER_OVERFLOW_BUILTINS
+#endif
+#endif
+
 namespace ub_tester {
 namespace arithm::checkers {
 
@@ -30,6 +43,8 @@ enum class ArithmCheckRes {            // can be used as return from:
  * is it warning or error: for example, unsigned overflow is detected as
  * OVERFLOW, then ArithmeticUBAsserts push warning, not error. */
 
+namespace portable {
+
 template <typename T>
 ArithmCheckRes checkSum(T Lhs, T Rhs) {
   FLT_POINT_NOT_SUPPORTED(T);
@@ -82,40 +97,6 @@ ArithmCheckRes checkMul(T Lhs, T Rhs) {
   return ArithmCheckRes::SAFE_OPERATION;
 }
 
-template <typename T>
-ArithmCheckRes checkDiv(T Lhs, T Rhs) {
-  FLT_POINT_NOT_SUPPORTED(T);
-  if (Rhs == 0)
-    return ArithmCheckRes::DIV_BY_0;
-  if (!(std::numeric_limits<T>::is_signed && Rhs == static_cast<T>(-1)))
-    return ArithmCheckRes::SAFE_OPERATION;
-
-  // only case when integer div can overflow: Rhs == -1
-  if (Lhs > 0 && std::numeric_limits<T>::lowest() + Lhs > 0)
-    return ArithmCheckRes::OVERFLOW_MIN;
-  if (Lhs < 0 && std::numeric_limits<T>::max() + Lhs < 0)
-    return ArithmCheckRes::OVERFLOW_MAX;
-
-  return ArithmCheckRes::SAFE_OPERATION;
-}
-
-template <typename T>
-ArithmCheckRes checkMod(T Lhs, T Rhs) {
-  static_assert(std::numeric_limits<T>::is_integer);
-  if (Rhs == 0)
-    return ArithmCheckRes::DIV_BY_0;
-  if (!(std::numeric_limits<T>::is_signed && Rhs == static_cast<T>(-1)))
-    return ArithmCheckRes::SAFE_OPERATION;
-
-  // only case when integer mod is undefined: Rhs == -1 (because div overflows)
-  if (Lhs > 0 && std::numeric_limits<T>::lowest() + Lhs > 0)
-    return ArithmCheckRes::MOD_UNDEFINED_DIV_OVERFLOWS_MIN;
-  if (Lhs < 0 && std::numeric_limits<T>::max() + Lhs < 0)
-    return ArithmCheckRes::MOD_UNDEFINED_DIV_OVERFLOWS_MAX;
-
-  return ArithmCheckRes::SAFE_OPERATION;
-}
-
 template <typename LhsType, typename RhsType>
 ArithmCheckRes checkBitShiftLeft(LhsType Lhs, RhsType Rhs) {
   static_assert(std::numeric_limits<LhsType>::is_integer);
@@ -158,6 +139,123 @@ ArithmCheckRes checkBitShiftLeft(LhsType Lhs, RhsType Rhs) {
   return ArithmCheckRes::SAFE_OPERATION;
 }
 
+} // namespace portable
+
+#ifdef UB_TESTER_OVERFLOW_BUILTINS
+/* Same results as portable checkers, but overflow is reported by compiler
+ * builtins (flag of add/sub/mul instruction) and shift is checked against
+ * limit shifted right, so there are no divisions on the fast path. */
+namespace builtins {
+
+template <typename T>
+ArithmCheckRes checkSum(T Lhs, T Rhs) {
+  FLT_POINT_NOT_SUPPORTED(T);
+  T Res;
+  if (!__builtin_add_overflow(Lhs, Rhs, &Res))
+    return ArithmCheckRes::SAFE_OPERATION;
+  return Rhs > 0 ? ArithmCheckRes::OVERFLOW_MAX : ArithmCheckRes::OVERFLOW_MIN;
+}
+
+template <typename T>
+ArithmCheckRes checkDiff(T Lhs, T Rhs) {
+  FLT_POINT_NOT_SUPPORTED(T);
+  T Res;
+  if (!__builtin_sub_overflow(Lhs, Rhs, &Res))
+    return ArithmCheckRes::SAFE_OPERATION;
+  return Rhs > 0 ? ArithmCheckRes::OVERFLOW_MIN : ArithmCheckRes::OVERFLOW_MAX;
+}
+
+template <typename T>
+ArithmCheckRes checkMul(T Lhs, T Rhs) {
+  FLT_POINT_NOT_SUPPORTED(T);
+  T Res;
+  if (!__builtin_mul_overflow(Lhs, Rhs, &Res))
+    return ArithmCheckRes::SAFE_OPERATION;
+  return (Lhs < 0) != (Rhs < 0) ? ArithmCheckRes::OVERFLOW_MIN
+                                : ArithmCheckRes::OVERFLOW_MAX;
+}
+
+template <typename LhsType, typename RhsType>
+ArithmCheckRes checkBitShiftLeft(LhsType Lhs, RhsType Rhs) {
+  static_assert(std::numeric_limits<LhsType>::is_integer);
+  static_assert(std::numeric_limits<RhsType>::is_integer);
+
+  if (Rhs < 0)
+    return ArithmCheckRes::BITSHIFT_NEGATIVE_RHS;
+  if (Rhs >= static_cast<RhsType>(arithm_util::getTypeSizeInBits<LhsType>()))
+    return ArithmCheckRes::BITSHIFT_RHS_GEQ_LHSTYPE_IN_BITS;
+
+#if __cplusplus > 201703L
+  // Lhs * 2^Rhs fits in LhsType iff Lhs fits in LhsType limits >> Rhs
+  if (Lhs > (std::numeric_limits<LhsType>::max() >> Rhs))
+    return ArithmCheckRes::OVERFLOW_MAX_IN_BITSHIFT_LEFT_CXX20;
+  if (Lhs < (std::numeric_limits<LhsType>::lowest() >> Rhs))
+    return ArithmCheckRes::OVERFLOW_MIN_IN_BITSHIFT_LEFT_CXX20;
+  return ArithmCheckRes::SAFE_OPERATION;
+#endif
+
+  if (Lhs < 0)
+    return ArithmCheckRes::BITSHIFT_LEFT_NEGATIVE_LHS;
+
+  using UnsignedLhsType = typename std::make_unsigned<LhsType>::type;
+  if (static_cast<UnsignedLhsType>(Lhs) >
+      (std::numeric_limits<UnsignedLhsType>::max() >> Rhs)) {
+    if (std::numeric_limits<LhsType>::is_signed) // for signed res is undefined
+      return ArithmCheckRes::
+          BITSHIFT_LEFT_RES_OVERFLOWS_UNSIGNED_MAX_WITH_NONNEG_SIGNED_LHS;
+    return ArithmCheckRes::OVERFLOW_MAX; // for unsigned occurs overflow
+  }
+
+  return ArithmCheckRes::SAFE_OPERATION;
+}
+
+} // namespace builtins
+
+using builtins::checkBitShiftLeft;
+using builtins::checkDiff;
+using builtins::checkMul;
+using builtins::checkSum;
+#else
+using portable::checkBitShiftLeft;
+using portable::checkDiff;
+using portable::checkMul;
+using portable::checkSum;
+#endif
+
+template <typename T>
+ArithmCheckRes checkDiv(T Lhs, T Rhs) {
+  FLT_POINT_NOT_SUPPORTED(T);
+  if (Rhs == 0)
+    return ArithmCheckRes::DIV_BY_0;
+  if (!(std::numeric_limits<T>::is_signed && Rhs == static_cast<T>(-1)))
+    return ArithmCheckRes::SAFE_OPERATION;
+
+  // only case when integer div can overflow: Rhs == -1
+  if (Lhs > 0 && std::numeric_limits<T>::lowest() + Lhs > 0)
+    return ArithmCheckRes::OVERFLOW_MIN;
+  if (Lhs < 0 && std::numeric_limits<T>::max() + Lhs < 0)
+    return ArithmCheckRes::OVERFLOW_MAX;
+
+  return ArithmCheckRes::SAFE_OPERATION;
+}
+
+template <typename T>
+ArithmCheckRes checkMod(T Lhs, T Rhs) {
+  static_assert(std::numeric_limits<T>::is_integer);
+  if (Rhs == 0)
+    return ArithmCheckRes::DIV_BY_0;
+  if (!(std::numeric_limits<T>::is_signed && Rhs == static_cast<T>(-1)))
+    return ArithmCheckRes::SAFE_OPERATION;
+
+  // only case when integer mod is undefined: Rhs == -1 (because div overflows)
+  if (Lhs > 0 && std::numeric_limits<T>::lowest() + Lhs > 0)
+    return ArithmCheckRes::MOD_UNDEFINED_DIV_OVERFLOWS_MIN;
+  if (Lhs < 0 && std::numeric_limits<T>::max() + Lhs < 0)
+    return ArithmCheckRes::MOD_UNDEFINED_DIV_OVERFLOWS_MAX;
+
+  return ArithmCheckRes::SAFE_OPERATION;
+}
+
 template <typename LhsType, typename RhsType>
 ArithmCheckRes checkBitShiftRight(LhsType Lhs, RhsType Rhs) {
   static_assert(std::numeric_limits<LhsType>::is_integer);
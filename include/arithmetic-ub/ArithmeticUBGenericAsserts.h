@@ -0,0 +1,202 @@
+#pragma once
+
+#include "ArithmeticUBAsserts.h"
+#include "ArithmeticUBUtility.h"
+#include <type_traits>
+#include <utility>
+
+/* Type-generic forms are emitted for type-dependent expressions in templates.
+ * Template pattern is instrumented once; operand types are deduced at each
+ * instantiation and integral operations are delegated to the asserts above,
+ * other types (floating point, classes, pointers) get plain operation. Plain
+ * operation is a lambda spelled at the call site, so its operators are looked
+ * up from the user's template as in the original expression, and not from
+ * the namespace of the asserts (global operators found only by ordinary
+ * lookup would be lost then). */
+#define ASSERT_BINOP_GENERIC(Operation, Lhs, Rhs, Column, ExprText)            \
+  ub_tester::arithm::asserts::generic::assert##Operation(                      \
+      (Lhs), (Rhs), UB_TESTER_GENERIC_PLAIN_OP(Operation),                     \
+      UB_TESTER_CHECK_SITE(Operation, Column, ExprText, nullptr, nullptr,      \
+                           nullptr))
+#define ASSERT_UNOP_GENERIC(Operation, Expr, Column, ExprText)                 \
+  ub_tester::arithm::asserts::generic::assert##Operation(                      \
+      (Expr), UB_TESTER_GENERIC_PLAIN_OP(Operation),                           \
+      UB_TESTER_CHECK_SITE(Operation, Column, ExprText, nullptr, nullptr,      \
+                           nullptr))
+#define ASSERT_COMPASSIGNOP_GENERIC(Operation, Lhs, Rhs, Column, ExprText)     \
+  ub_tester::arithm::asserts::generic::assertCompAssignOp##Operation(          \
+      (Lhs), (Rhs), UB_TESTER_GENERIC_PLAIN_OP(CompAssignOp##Operation),      \
+      UB_TESTER_CHECK_SITE(CompAssignOp##Operation, Column, ExprText, nullptr, \
+                           nullptr, nullptr))
+
+#define UB_TESTER_GENERIC_PLAIN_OP(Operation)                                  \
+  UB_TESTER_GENERIC_PLAIN_OP_##Operation
+#define UB_TESTER_GENERIC_PLAIN_BINOP(Op)                                      \
+  [](auto&& Lhs, auto&& Rhs) -> decltype(auto) {                               \
+    return std::forward<decltype(Lhs)>(Lhs) Op std::forward<decltype(Rhs)>(    \
+        Rhs);                                                                  \
+  }
+#define UB_TESTER_GENERIC_PLAIN_UNOP(PrefixOp, PostfixOp)                      \
+  [](auto&& Expr) -> decltype(auto) {                                          \
+    return PrefixOp std::forward<decltype(Expr)>(Expr) PostfixOp;              \
+  }
+
+#define UB_TESTER_GENERIC_PLAIN_OP_Sum UB_TESTER_GENERIC_PLAIN_BINOP(+)
+#define UB_TESTER_GENERIC_PLAIN_OP_Diff UB_TESTER_GENERIC_PLAIN_BINOP(-)
+#define UB_TESTER_GENERIC_PLAIN_OP_Mul UB_TESTER_GENERIC_PLAIN_BINOP(*)
+#define UB_TESTER_GENERIC_PLAIN_OP_Div UB_TESTER_GENERIC_PLAIN_BINOP(/)
+#define UB_TESTER_GENERIC_PLAIN_OP_Mod UB_TESTER_GENERIC_PLAIN_BINOP(%)
+#define UB_TESTER_GENERIC_PLAIN_OP_BitShiftLeft                                \
+  UB_TESTER_GENERIC_PLAIN_BINOP(<<)
+#define UB_TESTER_GENERIC_PLAIN_OP_BitShiftRight                               \
+  UB_TESTER_GENERIC_PLAIN_BINOP(>>)
+#define UB_TESTER_GENERIC_PLAIN_OP_UnaryNeg UB_TESTER_GENERIC_PLAIN_UNOP(-, )
+#define UB_TESTER_GENERIC_PLAIN_OP_PrefixIncr                                  \
+  UB_TESTER_GENERIC_PLAIN_UNOP(++, )
+#define UB_TESTER_GENERIC_PLAIN_OP_PostfixIncr                                 \
+  UB_TESTER_GENERIC_PLAIN_UNOP(, ++)
+#define UB_TESTER_GENERIC_PLAIN_OP_PrefixDecr                                  \
+  UB_TESTER_GENERIC_PLAIN_UNOP(--, )
+#define UB_TESTER_GENERIC_PLAIN_OP_PostfixDecr                                 \
+  UB_TESTER_GENERIC_PLAIN_UNOP(, --)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpSum                             \
+  UB_TESTER_GENERIC_PLAIN_BINOP(+=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpDiff                            \
+  UB_TESTER_GENERIC_PLAIN_BINOP(-=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpMul                             \
+  UB_TESTER_GENERIC_PLAIN_BINOP(*=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpDiv                             \
+  UB_TESTER_GENERIC_PLAIN_BINOP(/=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpMod                             \
+  UB_TESTER_GENERIC_PLAIN_BINOP(%=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpBitShiftLeft                    \
+  UB_TESTER_GENERIC_PLAIN_BINOP(<<=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpBitShiftRight                   \
+  UB_TESTER_GENERIC_PLAIN_BINOP(>>=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpLogicAnd                        \
+  UB_TESTER_GENERIC_PLAIN_BINOP(&=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpLogicOr                         \
+  UB_TESTER_GENERIC_PLAIN_BINOP(|=)
+#define UB_TESTER_GENERIC_PLAIN_OP_CompAssignOpLogicXor                        \
+  UB_TESTER_GENERIC_PLAIN_BINOP(^=)
+
+namespace ub_tester::arithm::asserts::generic {
+
+namespace support {
+
+template <typename LhsType, typename RhsType>
+constexpr bool areIntegralOperands() {
+  return std::is_integral_v<std::decay_t<LhsType>> &&
+         std::is_integral_v<std::decay_t<RhsType>>;
+}
+
+// types of operands after integral promotions and usual arithmetic conversions
+template <typename LhsType, typename RhsType, bool IsShift>
+struct ComputationTypes {
+  using Lhs = std::conditional_t<IsShift, decltype(+std::declval<LhsType>()),
+                                 decltype(std::declval<LhsType>() +
+                                          std::declval<RhsType>())>;
+  using Rhs = std::conditional_t<IsShift, decltype(+std::declval<RhsType>()),
+                                 Lhs>;
+};
+
+template <typename ToType, typename FromType>
+ToType convertOperand(FromType Operand, const CheckSite* Site) {
+  if constexpr (std::is_same_v<FromType, ToType> ||
+                std::is_same_v<FromType, bool>)
+    return static_cast<ToType>(Operand);
+  else
+    return casts::assertIntegralCast<FromType, ToType>(Operand, Site);
+}
+
+} // namespace support
+
+#define GENERIC_BINOP_ASSERT(Operation, IsShift)                               \
+  template <typename LhsType, typename RhsType, typename PlainOpType>          \
+  decltype(auto) assert##Operation(LhsType&& Lhs, RhsType&& Rhs,               \
+                                   PlainOpType PlainOp,                        \
+                                   const CheckSite* Site) {                    \
+    if constexpr (support::areIntegralOperands<LhsType, RhsType>()) {          \
+      using Types = support::ComputationTypes<std::decay_t<LhsType>,           \
+                                              std::decay_t<RhsType>, IsShift>; \
+      return arithm::asserts::assert##Operation<typename Types::Lhs,           \
+                                                typename Types::Rhs>(          \
+          support::convertOperand<typename Types::Lhs>(Lhs, Site),             \
+          support::convertOperand<typename Types::Rhs>(Rhs, Site), Site);      \
+    } else                                                                     \
+      return PlainOp(std::forward<LhsType>(Lhs), std::forward<RhsType>(Rhs));  \
+  }
+
+GENERIC_BINOP_ASSERT(Sum, false)
+GENERIC_BINOP_ASSERT(Diff, false)
+GENERIC_BINOP_ASSERT(Mul, false)
+GENERIC_BINOP_ASSERT(Div, false)
+GENERIC_BINOP_ASSERT(Mod, false)
+GENERIC_BINOP_ASSERT(BitShiftLeft, true)
+GENERIC_BINOP_ASSERT(BitShiftRight, true)
+
+#undef GENERIC_BINOP_ASSERT
+
+template <typename T, typename PlainOpType>
+decltype(auto) assertUnaryNeg(T&& Expr, PlainOpType PlainOp,
+                              const CheckSite* Site) {
+  if constexpr (support::areIntegralOperands<T, T>()) {
+    using ResType = decltype(-std::declval<std::decay_t<T>>());
+    return arithm::asserts::assertUnaryNeg<ResType>(
+        support::convertOperand<ResType>(Expr, Site), Site);
+  } else
+    return PlainOp(std::forward<T>(Expr));
+}
+
+#define GENERIC_INCR_DECR_ASSERT(Operation)                                    \
+  template <typename T, typename PlainOpType>                                  \
+  decltype(auto) assert##Operation(T&& Expr, PlainOpType PlainOp,              \
+                                   const CheckSite* Site) {                    \
+    using ValueType = std::remove_reference_t<T>;                              \
+    if constexpr (std::is_lvalue_reference_v<T> &&                             \
+                  std::is_integral_v<ValueType> &&                             \
+                  !std::is_same_v<ValueType, bool>)                            \
+      return arithm::asserts::assert##Operation<ValueType>(Expr, Site);        \
+    else                                                                       \
+      return PlainOp(std::forward<T>(Expr));                                   \
+  }
+
+GENERIC_INCR_DECR_ASSERT(PrefixIncr)
+GENERIC_INCR_DECR_ASSERT(PostfixIncr)
+GENERIC_INCR_DECR_ASSERT(PrefixDecr)
+GENERIC_INCR_DECR_ASSERT(PostfixDecr)
+
+#undef GENERIC_INCR_DECR_ASSERT
+
+#define GENERIC_COMPASSIGNOP_ASSERT(Operation, IsShift)                        \
+  template <typename LhsType, typename RhsType, typename PlainOpType>          \
+  decltype(auto) assertCompAssignOp##Operation(                                \
+      LhsType&& Lhs, RhsType&& Rhs, PlainOpType PlainOp,                       \
+      const CheckSite* Site) {                                                 \
+    using LhsValueType = std::remove_reference_t<LhsType>;                     \
+    if constexpr (std::is_lvalue_reference_v<LhsType> &&                       \
+                  support::areIntegralOperands<LhsType, RhsType>()) {          \
+      using Types =                                                            \
+          support::ComputationTypes<LhsValueType, std::decay_t<RhsType>,       \
+                                    IsShift>;                                  \
+      return arithm::asserts::assertCompAssignOp##Operation<                   \
+          LhsValueType, typename Types::Lhs, typename Types::Rhs>(             \
+          Lhs, support::convertOperand<typename Types::Rhs>(Rhs, Site), Site); \
+    } else                                                                     \
+      return PlainOp(std::forward<LhsType>(Lhs), std::forward<RhsType>(Rhs));  \
+  }
+
+GENERIC_COMPASSIGNOP_ASSERT(Sum, false)
+GENERIC_COMPASSIGNOP_ASSERT(Diff, false)
+GENERIC_COMPASSIGNOP_ASSERT(Mul, false)
+GENERIC_COMPASSIGNOP_ASSERT(Div, false)
+GENERIC_COMPASSIGNOP_ASSERT(Mod, false)
+GENERIC_COMPASSIGNOP_ASSERT(BitShiftLeft, true)
+GENERIC_COMPASSIGNOP_ASSERT(BitShiftRight, true)
+GENERIC_COMPASSIGNOP_ASSERT(LogicAnd, false)
+GENERIC_COMPASSIGNOP_ASSERT(LogicOr, false)
+GENERIC_COMPASSIGNOP_ASSERT(LogicXor, false)
+
+#undef GENERIC_COMPASSIGNOP_ASSERT
+
+} // namespace ub_tester::arithm::asserts::generic
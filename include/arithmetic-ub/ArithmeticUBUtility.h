@@ -57,6 +57,30 @@ constexpr const char* getIntTypeAsString() {
   return "undefined type";
 }
 template <>
+constexpr const char* getIntTypeAsString<bool>() {
+  return "bool";
+}
+template <>
+constexpr const char* getIntTypeAsString<char>() {
+  return "char";
+}
+template <>
+constexpr const char* getIntTypeAsString<signed char>() {
+  return "signed char";
+}
+template <>
+constexpr const char* getIntTypeAsString<unsigned char>() {
+  return "unsigned char";
+}
+template <>
+constexpr const char* getIntTypeAsString<short>() {
+  return "short";
+}
+template <>
+constexpr const char* getIntTypeAsString<unsigned short>() {
+  return "unsigned short";
+}
+template <>
 constexpr const char* getIntTypeAsString<int>() {
   return "int";
 }
@@ -76,11 +100,19 @@ template <>
 constexpr const char* getIntTypeAsString<long long>() {
   return "long long";
 }
+template <>
+constexpr const char* getIntTypeAsString<unsigned long long>() {
+  return "unsigned long long";
+}
 #ifdef __GNUC__
 template <>
 constexpr const char* getIntTypeAsString<__int128>() {
   return "__int128";
 }
+template <>
+constexpr const char* getIntTypeAsString<unsigned __int128>() {
+  return "unsigned __int128";
+}
 #endif
 
 } // namespace tmp_functions
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "clang/AST/RecursiveASTVisitor.h"
+#include <string>
 
 namespace ub_tester {
 
@@ -13,6 +14,25 @@ public:
   bool VisitUnaryOperator(clang::UnaryOperator* Unop);
   bool VisitCompoundAssignOperator(clang::CompoundAssignOperator* CompAssignOp);
   bool VisitImplicitCastExpr(clang::ImplicitCastExpr* ImplicitCast);
+  bool VisitCXXOperatorCallExpr(clang::CXXOperatorCallExpr* OpCall);
+
+  bool TraverseUnaryExprOrTypeTraitExpr(clang::UnaryExprOrTypeTraitExpr*);
+  bool TraverseCXXNoexceptExpr(clang::CXXNoexceptExpr*);
+  bool TraverseCXXTypeidExpr(clang::CXXTypeidExpr* Typeid);
+  bool TraverseDecltypeTypeLoc(clang::DecltypeTypeLoc);
+
+private:
+  std::string getCompAssignOperationName(clang::OverloadedOperatorKind);
+  std::string getCheckSiteArgs(const clang::Expr* Ex);
+  void substituteGenericBinop(const std::string& OperationName,
+                              clang::Expr* Op, clang::Expr* Lhs,
+                              clang::Expr* Rhs);
+  void substituteGenericUnop(const std::string& OperationName,
+                             const std::string& UnopName, bool IsPrefix,
+                             clang::Expr* Op, clang::Expr* SubExpr);
+  void substituteGenericCompAssignOp(const std::string& OperationName,
+                                     clang::Expr* Op, clang::Expr* Lhs,
+                                     clang::Expr* Rhs);
 
 private:
   clang::ASTContext* Context_;
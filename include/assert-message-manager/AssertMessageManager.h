@@ -4,25 +4,49 @@
 #ifdef UB_TESTER
 #include ".UBConfig.h"
 #endif
+#include "ReportFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
-#define PUSH_ERROR(FailCode, Message)                                          \
+// location of failed check is kept for records of report file
+#define PUSH_ERROR(FailCode, Message, Filename, Line)                          \
   AssertMessageManager::pushMessage(                                           \
-      AssertMessage((Message), AssertFailCode::FailCode));                     \
+      AssertMessage((Message), AssertFailCode::FailCode, (Filename),           \
+                    static_cast<int>(Line)));                                  \
   assert(0 && "Assert detected error but manager didn't handle it")
 #define PUSH_WARNING(FailCode, Message)                                        \
   AssertMessageManager::pushMessage(                                           \
       AssertMessage("warning! " + (Message), AssertFailCode::FailCode))
 
+// checks pass on the hot path, reports are built out of line
+#if defined(__GNUC__) || defined(__clang__)
+#define UB_TESTER_UNLIKELY(Cond) __builtin_expect(!!(Cond), 0)
+#define UB_TESTER_COLD __attribute__((cold, noinline))
+#else
+#define UB_TESTER_UNLIKELY(Cond) (Cond)
+#define UB_TESTER_COLD
+#endif
+
 namespace ub_tester::assert_message_manager::suppress_messages_mode {
 
+/* Generated .UBConfig.h defines all of these flags. Checks that could only
+ * report suppressed warnings and checks of disabled operations are not
+ * compiled into instrumented program. */
 #ifndef UB_TESTER
 constexpr bool SUPPRESS_ALL = false;
 constexpr bool SUPPRESS_WARNINGS = false;
-#endif
 
 constexpr bool SUPPRESS_ARITHM_WARNINGS = false;
 constexpr bool SUPPRESS_UNSIGNED_OVERFLOW_WARNING = false;
@@ -36,6 +60,18 @@ constexpr bool SUPPRESS_PTR_UB_WARNINGS = false;
 constexpr bool SUPPRESS_IMPL_DEFINED_WARNING = false;
 constexpr bool SUPPRESS_NOT_CONSIDERED_WARNING = false;
 
+constexpr bool DISABLE_SUM_CHECKS = false;
+constexpr bool DISABLE_DIFF_CHECKS = false;
+constexpr bool DISABLE_MUL_CHECKS = false;
+constexpr bool DISABLE_DIV_CHECKS = false;
+constexpr bool DISABLE_MOD_CHECKS = false;
+constexpr bool DISABLE_BITSHIFT_LEFT_CHECKS = false;
+constexpr bool DISABLE_BITSHIFT_RIGHT_CHECKS = false;
+constexpr bool DISABLE_UNARY_NEG_CHECKS = false;
+constexpr bool DISABLE_INCR_DECR_CHECKS = false;
+constexpr bool DISABLE_IMPLICIT_CAST_CHECKS = false;
+#endif
+
 }; // namespace ub_tester::assert_message_manager::suppress_messages_mode
 
 namespace ub_tester::assert_message_manager {
@@ -63,13 +99,17 @@ enum class AssertFailCode { // error code > 0, warning code < 0
 };
 
 struct AssertMessage final {
-  AssertMessage(std::string Message, AssertFailCode FailCode)
-      : Message_{Message}, FailCode_{FailCode} {}
+  AssertMessage(std::string Message, AssertFailCode FailCode,
+                const char* Filename = nullptr, int Line = 0)
+      : Message_{Message}, FailCode_{FailCode}, Filename_{Filename},
+        Line_{Line} {}
   std::string Message_;
   AssertFailCode FailCode_;
+  const char* Filename_; // nullptr if location is unknown
+  int Line_;
 };
 
-bool checkIfMessageIsSuppressed(AssertFailCode FailCode) {
+constexpr bool checkIfMessageIsSuppressed(AssertFailCode FailCode) {
   using namespace suppress_messages_mode;
   if (SUPPRESS_ALL)
     return true;
@@ -123,51 +163,454 @@ bool checkIfMessageIsSuppressed(AssertFailCode FailCode) {
     return SUPPRESS_PTR_UB_WARNINGS;
   }
   assert(0 && "Undefined AssertFailCode");
+  return false;
 }
 
+inline const char* getFailCodeName(AssertFailCode FailCode) {
+  switch (FailCode) {
+  case AssertFailCode::OVERFLOW_ERROR:
+    return "OVERFLOW_ERROR";
+  case AssertFailCode::DIVISION_BY_ZERO_ERROR:
+    return "DIVISION_BY_ZERO_ERROR";
+  case AssertFailCode::UNDEFINED_MOD_ERROR:
+    return "UNDEFINED_MOD_ERROR";
+  case AssertFailCode::UNDEFINED_BITSHIFT_LEFT_ERROR:
+    return "UNDEFINED_BITSHIFT_LEFT_ERROR";
+  case AssertFailCode::UNDEFINED_BITSHIFT_RIGHT_ERROR:
+    return "UNDEFINED_BITSHIFT_RIGHT_ERROR";
+  case AssertFailCode::UNINIT_VAR_ACCESS_ERROR:
+    return "UNINIT_VAR_ACCESS_ERROR";
+  case AssertFailCode::INDEX_OUT_OF_BOUNDS_ERROR:
+    return "INDEX_OUT_OF_BOUNDS_ERROR";
+  case AssertFailCode::INVALID_SIZE_OF_ARRAY_ERROR:
+    return "INVALID_SIZE_OF_ARRAY_ERROR";
+  case AssertFailCode::NULLPTR_DEREF_ERROR:
+    return "NULLPTR_DEREF_ERROR";
+  case AssertFailCode::UNINIT_PTR_DEREF_ERROR:
+    return "UNINIT_PTR_DEREF_ERROR";
+  case AssertFailCode::UNSIGNED_OVERFLOW_WARNING:
+    return "UNSIGNED_OVERFLOW_WARNING";
+  case AssertFailCode::OVERFLOW_IN_BITSHIFT_CXX20_WARNING:
+    return "OVERFLOW_IN_BITSHIFT_CXX20_WARNING";
+  case AssertFailCode::IMPL_DEFINED_WARNING:
+    return "IMPL_DEFINED_WARNING";
+  case AssertFailCode::UNSAFE_CONV_WARNING:
+    return "UNSAFE_CONV_WARNING";
+  case AssertFailCode::IMPL_DEFINED_UNSAFE_CONV_WARNING:
+    return "IMPL_DEFINED_UNSAFE_CONV_WARNING";
+  case AssertFailCode::NOT_CONSIDERED_WARNING:
+    return "NOT_CONSIDERED_WARNING";
+  case AssertFailCode::UNTRACKED_PTR_WARNING:
+    return "UNTRACKED_PTR_WARNING";
+  case AssertFailCode::UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING:
+    return "UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING";
+  }
+  return "UNKNOWN";
+}
+
+/* Warnings are deduplicated by site (location, check and its result): only
+ * the first hit of a site is formatted, repeated hits just increment counter
+ * of the site in fixed-capacity lock-free table. */
+class WarningSiteTable final {
+public:
+  static constexpr size_t Capacity = 4096; // power of two
+  static constexpr size_t MaxProbes = 64;
+
+  struct Entry final {
+    std::atomic<uint64_t> Key{0}; // 0 if entry is free
+    std::atomic<uint64_t> Hits{0};
+    std::atomic<uint64_t> FirstSeen{0}; // ns since start of program
+    std::atomic<uint64_t> LastSeen{0};
+    // written by thread which inserted the entry, before its message
+    const char* Filename = nullptr;
+    int Line = 0;
+  };
+
+  static uint64_t getSiteKey(const char* Filename, int Line, int Code) {
+    uint64_t Key = reinterpret_cast<uintptr_t>(Filename) ^
+                   (static_cast<uint64_t>(static_cast<uint32_t>(Line)) << 32) ^
+                   static_cast<uint32_t>(Code);
+    // splitmix64 finalizer spreads nearby lines over table
+    Key = (Key ^ (Key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    Key = (Key ^ (Key >> 27)) * 0x94d049bb133111ebULL;
+    Key ^= Key >> 31;
+    return Key ? Key : 1;
+  }
+
+  // nullptr if table is full, then site is not deduplicated
+  Entry* countHit(uint64_t Key, uint64_t& PrevHits) {
+    uint64_t Now = getTimestamp();
+    for (size_t Probe = 0, Pos = Key & (Capacity - 1); Probe < MaxProbes;
+         ++Probe, Pos = (Pos + 1) & (Capacity - 1)) {
+      Entry& Site = Entries_[Pos];
+      uint64_t SiteKey = Site.Key.load(std::memory_order_acquire);
+      if (SiteKey == 0 && Site.Key.compare_exchange_strong(SiteKey, Key)) {
+        Site.FirstSeen.store(Now, std::memory_order_relaxed);
+        SiteKey = Key;
+      }
+      if (SiteKey != Key)
+        continue;
+      Site.LastSeen.store(Now, std::memory_order_relaxed);
+      PrevHits = Site.Hits.fetch_add(1, std::memory_order_relaxed);
+      return &Site;
+    }
+    return nullptr;
+  }
+
+  // ns since start of program
+  uint64_t getTimestamp() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - Start_)
+        .count();
+  }
+
+  const std::chrono::steady_clock::time_point Start_ =
+      std::chrono::steady_clock::now();
+
+private:
+  Entry Entries_[Capacity];
+};
+
+/* Reports of each thread are queued to its own ring buffer without locks;
+ * collector moves them under mutex to the common store, when buffer is full,
+ * thread exits, error is detected or program exits. Messages are printed to
+ * stderr at exit, or written by reporter thread to report file as soon as
+ * they are collected. Manager is never destroyed and reports made after
+ * thread's buffer is destroyed or exit has begun are stored directly, so
+ * threads can report while static objects are destroyed. */
 class AssertMessageManager final {
 private:
   AssertMessageManager() = default;
 
-  void handleMessage(AssertMessage Message) {
-    if (!checkIfMessageIsSuppressed(Message.FailCode_))
+  struct StoredMessage final {
+    AssertMessage Message;
+    const WarningSiteTable::Entry* Site; // nullptr if site is not counted
+    uint64_t Timestamp;
+  };
+
+  // single producer is owning thread, single consumer is collector
+  class ThreadMessageBuffer final {
+  public:
+    explicit ThreadMessageBuffer(bool& IsDestroyed)
+        : IsDestroyed_{IsDestroyed} {
+      getInstance().registerBuffer(this);
+    }
+    ~ThreadMessageBuffer() {
+      getInstance().unregisterBuffer(this);
+      IsDestroyed_ = true;
+    }
+
+    // message is not moved if buffer is full
+    bool tryPush(StoredMessage& Message) {
+      size_t Tail = Tail_.load(std::memory_order_relaxed);
+      if (Tail - Head_.load(std::memory_order_acquire) == Capacity)
+        return false;
+      Slots_[Tail % Capacity] = std::move(Message);
+      Tail_.store(Tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    template <typename ConsumerType>
+    void drain(ConsumerType Consume) {
+      size_t Head = Head_.load(std::memory_order_relaxed);
+      size_t Tail = Tail_.load(std::memory_order_acquire);
+      for (; Head != Tail; ++Head)
+        Consume(std::move(*Slots_[Head % Capacity]));
+      Head_.store(Head, std::memory_order_release);
+    }
+
+  private:
+    static constexpr size_t Capacity = 64;
+    bool& IsDestroyed_;
+    std::optional<StoredMessage> Slots_[Capacity];
+    alignas(64) std::atomic<size_t> Head_{0};
+    alignas(64) std::atomic<size_t> Tail_{0};
+  };
+
+  /* Buffer of calling thread, nullptr once it has been destroyed: thread-local
+   * objects of main thread are destroyed before static ones, whose
+   * destructors may still report. The flag is trivially destructible, so it
+   * can be read until the thread ends. */
+  static ThreadMessageBuffer* getThreadBuffer() {
+    thread_local bool IsBufferDestroyed = false;
+    if (IsBufferDestroyed)
+      return nullptr;
+    thread_local ThreadMessageBuffer Buffer{IsBufferDestroyed};
+    return &Buffer;
+  }
+
+  void registerBuffer(ThreadMessageBuffer* Buffer) {
+    std::lock_guard<std::mutex> Lock{CollectorMutex_};
+    Buffers_.push_back(Buffer);
+  }
+
+  void unregisterBuffer(ThreadMessageBuffer* Buffer) {
+    {
+      std::lock_guard<std::mutex> Lock{CollectorMutex_};
+      Buffer->drain([this](StoredMessage&& Message) {
+        storeMessage(std::move(Message));
+      });
+      Buffers_.erase(std::find(Buffers_.begin(), Buffers_.end(), Buffer));
+    }
+    if (IsFlushedAtExit_)
+      flush();
+  }
+
+  // requires CollectorMutex_
+  void storeMessage(StoredMessage&& Message) {
+    if (static_cast<int>(Message.Message.FailCode_) > 0 ||
+        Messages_.size() < MessageCapacity)
       Messages_.push_back(std::move(Message));
-    if (static_cast<int>(Message.FailCode_) > 0) // if error
-      printMessagesNTerminate(Message.FailCode_);
+    else
+      ++DroppedMessages_;
+  }
+
+  // requires CollectorMutex_
+  void collectMessages() {
+    for (ThreadMessageBuffer* Buffer : Buffers_)
+      Buffer->drain([this](StoredMessage&& Message) {
+        storeMessage(std::move(Message));
+      });
+  }
+
+  void handleMessage(AssertMessage Message) {
+    StoredMessage Stored{std::move(Message),
+                         std::exchange(PendingSite_, nullptr),
+                         Sites_.getTimestamp()};
+    AssertFailCode FailCode = Stored.Message.FailCode_;
+    bool IsSuppressed = checkIfMessageIsSuppressed(FailCode);
+    if (static_cast<int>(FailCode) > 0) { // if error
+      {
+        std::lock_guard<std::mutex> Lock{CollectorMutex_};
+        collectMessages();
+        if (!IsSuppressed)
+          storeMessage(std::move(Stored));
+      }
+      flush();
+      terminate(FailCode);
+    }
+    if (IsSuppressed)
+      return;
+
+    // after exit has begun, messages are stored and printed directly
+    bool IsFlushedAtExit = IsFlushedAtExit_.load(std::memory_order_relaxed);
+    ThreadMessageBuffer* Buffer = IsFlushedAtExit ? nullptr : getThreadBuffer();
+    if (!Buffer || !Buffer->tryPush(Stored)) {
+      std::lock_guard<std::mutex> Lock{CollectorMutex_};
+      collectMessages();
+      storeMessage(std::move(Stored));
+    }
+    if (IsFlushedAtExit)
+      flush();
+  }
+
+  // requires OutputMutex_
+  void printMessages(const std::vector<StoredMessage>& Messages,
+                     size_t DroppedMessages) {
+    using std::chrono::milliseconds;
+    using std::chrono::nanoseconds;
+    for (const auto& [Message, Site, Timestamp] : Messages) {
+      std::cerr << Message.Message_;
+      uint64_t Hits = Site ? Site->Hits.load(std::memory_order_relaxed) : 0;
+      if (Hits > 1)
+        std::cerr << "     repeated " << Hits << " times, first at "
+                  << std::chrono::duration_cast<milliseconds>(
+                         nanoseconds{Site->FirstSeen.load()})
+                         .count()
+                  << " ms, last at "
+                  << std::chrono::duration_cast<milliseconds>(
+                         nanoseconds{Site->LastSeen.load()})
+                         .count()
+                  << " ms\n";
+      std::cerr << "\n";
+    }
+    if (DroppedMessages != 0)
+      std::cerr << DroppedMessages
+                << " more warnings were not stored, limit is "
+                << MessageCapacity << "\n\n";
+  }
+
+  static report::ReportRecord makeRecord(uint64_t Id,
+                                         const StoredMessage& Stored) {
+    const auto& [Message, Site, Timestamp] = Stored;
+    std::string Text = Message.Message_;
+    while (!Text.empty() && Text.back() == '\n')
+      Text.pop_back();
+    uint64_t TimeMs = Timestamp / 1000000;
+    report::ReportRecord Record{Id,
+                                static_cast<int>(Message.FailCode_) > 0,
+                                getFailCodeName(Message.FailCode_),
+                                std::move(Text),
+                                Message.Filename_,
+                                Message.Line_,
+                                1,
+                                TimeMs,
+                                TimeMs};
+    if (Site) {
+      Record.Filename = Site->Filename;
+      Record.Line = Site->Line;
+      Record.Hits = Site->Hits.load(std::memory_order_relaxed);
+      Record.FirstSeenMs = Site->FirstSeen.load() / 1000000;
+      Record.LastSeenMs = Site->LastSeen.load() / 1000000;
+    }
+    return Record;
+  }
+
+  // requires OutputMutex_
+  void writeMessages(const std::vector<StoredMessage>& Messages,
+                     size_t DroppedMessages) {
+    for (const auto& Stored : Messages) {
+      auto Record = makeRecord(NumRecords_++, Stored);
+      if (Record.IsError) // error terminates program, it must be visible
+        std::cerr << Stored.Message.Message_ << "\n";
+      Report_->write(Record);
+      if (Stored.Site)
+        ReportedSites_.emplace_back(std::move(Record), Stored.Site);
+    }
+    if (DroppedMessages != 0)
+      Report_->write({NumRecords_++, false, "DROPPED_MESSAGES",
+                      std::to_string(DroppedMessages) +
+                          " more warnings were not stored",
+                      nullptr, 0, DroppedMessages, 0, 0});
+    Report_->flush();
   }
 
-  void printMessagesNTerminate(AssertFailCode FailCode) {
-    for (const auto& Message : Messages_)
-      std::cerr << Message.Message_ << "\n";
-    Messages_.clear();
+  // writes again records of sites which have been hit after their records
+  void writeRepeatedSites() {
+    for (auto& [Record, Site] : ReportedSites_) {
+      uint64_t Hits = Site->Hits.load(std::memory_order_relaxed);
+      if (Hits == Record.Hits)
+        continue;
+      Record.Hits = Hits;
+      Record.LastSeenMs = Site->LastSeen.load() / 1000000;
+      Report_->write(Record);
+    }
+    Report_->flush();
+  }
+
+  void runReporter() {
+    std::unique_lock<std::mutex> Lock{ReporterMutex_};
+    while (!IsReporterStopped_) {
+      ReporterCondVar_.wait_for(Lock, ReportPeriod);
+      Lock.unlock();
+      flush();
+      Lock.lock();
+    }
+  }
+
+  void startReporter() {
+    Report_ = report::ReportFile::open();
+    if (Report_)
+      Reporter_ = std::thread{[this] { runReporter(); }};
+  }
+
+  void stopReporter() {
+    if (!Reporter_.joinable())
+      return;
+    {
+      std::lock_guard<std::mutex> Lock{ReporterMutex_};
+      IsReporterStopped_ = true;
+    }
+    ReporterCondVar_.notify_one();
+    if (Reporter_.get_id() != std::this_thread::get_id())
+      Reporter_.join();
+    else
+      Reporter_.detach();
+  }
+
+  void flushAtExit() {
+    stopReporter();
+    IsFlushedAtExit_ = true;
+    flush();
+    std::lock_guard<std::mutex> Lock{OutputMutex_};
+    if (Report_) {
+      writeRepeatedSites();
+      Report_.reset(); // later messages are printed to stderr
+    }
+  }
+
+  [[noreturn]] static void terminate(AssertFailCode FailCode) {
+    // the first detected error terminates program, others wait for it
+    static std::mutex TerminateMutex;
+    TerminateMutex.lock();
     if (!suppress_messages_mode::SUPPRESS_ALL)
       std::cerr << "error detected, aborting\n\n";
     exit(static_cast<int>(FailCode));
   }
 
 public:
-  ~AssertMessageManager() {
-    for (const auto& Message : Messages_)
-      std::cerr << Message.Message_ << "\n";
-  }
-
   static AssertMessageManager& getInstance() {
-    if (!ManagerPtr_)
-      ManagerPtr_ =
-          std::unique_ptr<AssertMessageManager>(new AssertMessageManager{});
-    return *ManagerPtr_;
+    static AssertMessageManager* Manager = [] {
+      auto* Manager = new AssertMessageManager{};
+      Manager->startReporter();
+      std::atexit([] { getInstance().flushAtExit(); });
+      return Manager;
+    }();
+    return *Manager;
   }
 
   static void pushMessage(AssertMessage Message) {
     AssertMessageManager::getInstance().handleMessage(std::move(Message));
   }
 
+  // prints or writes to report file messages of all threads reported so far
+  void flush() {
+    std::vector<StoredMessage> Messages;
+    size_t DroppedMessages = 0;
+    {
+      std::lock_guard<std::mutex> Lock{CollectorMutex_};
+      collectMessages();
+      Messages.swap(Messages_);
+      std::swap(DroppedMessages, DroppedMessages_);
+    }
+    std::lock_guard<std::mutex> Lock{OutputMutex_};
+    if (Report_)
+      writeMessages(Messages, DroppedMessages);
+    else
+      printMessages(Messages, DroppedMessages);
+  }
+
+  /* Counts hit of warning site. Returns true if site has been reported
+   * before, then warning must not be formatted. Otherwise next pushed message
+   * is considered as message of the site. */
+  static bool isRepeatedWarning(const char* Filename, int Line, int Code) {
+    uint64_t PrevHits = 0;
+    auto* Site = getInstance().Sites_.countHit(
+        WarningSiteTable::getSiteKey(Filename, Line, Code), PrevHits);
+    if (Site && PrevHits != 0)
+      return true;
+    if (Site) {
+      Site->Filename = Filename;
+      Site->Line = Line;
+    }
+    PendingSite_ = Site;
+    return false;
+  }
+
 private:
-  static std::unique_ptr<AssertMessageManager> ManagerPtr_;
-  std::vector<AssertMessage> Messages_{};
-};
+  static constexpr size_t MessageCapacity = 1024;
+  static constexpr std::chrono::milliseconds ReportPeriod{100};
+
+  static inline thread_local const WarningSiteTable::Entry* PendingSite_ =
+      nullptr;
+  std::mutex CollectorMutex_;
+  std::vector<ThreadMessageBuffer*> Buffers_{};
+  std::vector<StoredMessage> Messages_{};
+  size_t DroppedMessages_ = 0;
+  std::atomic<bool> IsFlushedAtExit_{false};
+  WarningSiteTable Sites_{};
 
-inline std::unique_ptr<AssertMessageManager> AssertMessageManager::ManagerPtr_ =
-    nullptr;
+  // guards output to stderr and report file
+  std::mutex OutputMutex_;
+  std::unique_ptr<report::ReportFile> Report_;
+  uint64_t NumRecords_ = 0;
+  std::vector<std::pair<report::ReportRecord, const WarningSiteTable::Entry*>>
+      ReportedSites_{};
+
+  std::thread Reporter_;
+  std::mutex ReporterMutex_;
+  std::condition_variable ReporterCondVar_;
+  bool IsReporterStopped_ = false;
+};
 
 } // namespace ub_tester::assert_message_manager
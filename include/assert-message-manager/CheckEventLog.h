@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+
+/* If UB_TESTER_EVENT_LOG=<file> is set, warnings are not formatted: checks
+ * append fixed-size binary records to per-thread buffers which are flushed to
+ * the file, and ub-tester-report renders the same messages offline.
+ * Errors are still printed as text, because they terminate the program. */
+
+namespace ub_tester::assert_message_manager::event_log {
+
+constexpr char LogEnvVar[] = "UB_TESTER_EVENT_LOG";
+constexpr char LogMagic[8] = {'U', 'B', 'T', 'L', 'O', 'G', '0', '1'};
+
+enum class EventKind : uint8_t {
+  Sum,
+  Diff,
+  Mul,
+  Div,
+  Mod,
+  BitShiftLeft,
+  BitShiftRight,
+  UnaryNeg,
+  PrefixIncr,
+  PostfixIncr,
+  PrefixDecr,
+  PostfixDecr,
+  IncrOrDecrOpResTypeConv,
+  CompAssignOpSum,
+  CompAssignOpDiff,
+  CompAssignOpMul,
+  CompAssignOpDiv,
+  CompAssignOpMod,
+  CompAssignOpBitShiftLeft,
+  CompAssignOpBitShiftRight,
+  CompAssignOpResTypeConv,
+  IntegralCast,
+  UntrackedPtr
+};
+
+// only these types can be restored by ub-tester-report
+enum class IntTypeId : uint8_t {
+  Bool,
+  Char,
+  SignedChar,
+  UnsignedChar,
+  Short,
+  UnsignedShort,
+  Int,
+  UnsignedInt,
+  Long,
+  UnsignedLong,
+  LongLong,
+  UnsignedLongLong,
+  Unknown
+};
+
+template <typename T>
+constexpr IntTypeId getIntTypeId() {
+  if constexpr (std::is_same_v<T, bool>)
+    return IntTypeId::Bool;
+  else if constexpr (std::is_same_v<T, char>)
+    return IntTypeId::Char;
+  else if constexpr (std::is_same_v<T, signed char>)
+    return IntTypeId::SignedChar;
+  else if constexpr (std::is_same_v<T, unsigned char>)
+    return IntTypeId::UnsignedChar;
+  else if constexpr (std::is_same_v<T, short>)
+    return IntTypeId::Short;
+  else if constexpr (std::is_same_v<T, unsigned short>)
+    return IntTypeId::UnsignedShort;
+  else if constexpr (std::is_same_v<T, int>)
+    return IntTypeId::Int;
+  else if constexpr (std::is_same_v<T, unsigned int>)
+    return IntTypeId::UnsignedInt;
+  else if constexpr (std::is_same_v<T, long>)
+    return IntTypeId::Long;
+  else if constexpr (std::is_same_v<T, unsigned long>)
+    return IntTypeId::UnsignedLong;
+  else if constexpr (std::is_same_v<T, long long>)
+    return IntTypeId::LongLong;
+  else if constexpr (std::is_same_v<T, unsigned long long>)
+    return IntTypeId::UnsignedLongLong;
+  else
+    return IntTypeId::Unknown;
+}
+
+constexpr size_t MaxTypes = 3;
+constexpr size_t MaxOperands = 3;
+constexpr uint8_t SiteTag = 'S';
+constexpr uint8_t EventTag = 'E';
+
+/* Site record is written once per site and is followed by NumStrings
+ * null-terminated strings: filename, then type and operation names. */
+struct SiteRecord {
+  uint8_t Tag;
+  EventKind Kind;
+  IntTypeId TypeIds[MaxTypes];
+  uint8_t NumStrings;
+  uint16_t Reserved;
+  uint32_t SiteId;
+  int32_t Line;
+};
+
+struct CheckEvent {
+  uint8_t Tag;
+  uint8_t CheckRes;
+  uint16_t Reserved;
+  uint32_t SiteId;
+  uint64_t Operands[MaxOperands]; // raw bits, restored by type of site
+  uint64_t Timestamp;             // ns of steady clock
+};
+
+static_assert(sizeof(SiteRecord) == 16 && sizeof(CheckEvent) == 40);
+
+// site is identified by its location and types of its instantiation
+using SiteKey = std::tuple<const char*, int, EventKind, IntTypeId, IntTypeId,
+                           IntTypeId>;
+
+inline SiteKey getSiteKey(EventKind Kind, const IntTypeId (&TypeIds)[MaxTypes],
+                          const char* Filename, int Line) {
+  return {Filename, Line, Kind, TypeIds[0], TypeIds[1], TypeIds[2]};
+}
+
+class EventLog final {
+private:
+  explicit EventLog(std::FILE* File) : File_{File} {
+    std::fwrite(LogMagic, sizeof(LogMagic), 1, File_);
+  }
+
+public:
+  ~EventLog() { std::fclose(File_); }
+
+  // nullptr if event log is not requested
+  static EventLog* getInstance() {
+    static EventLog* Instance = [] {
+      const char* Path = std::getenv(LogEnvVar);
+      if (!Path || !*Path)
+        return static_cast<EventLog*>(nullptr);
+      std::FILE* File = std::fopen(Path, "wb");
+      if (!File) {
+        std::cerr << "cannot open event log " << Path
+                  << ", messages are printed as text\n";
+        return static_cast<EventLog*>(nullptr);
+      }
+      static EventLog Log{File};
+      return &Log;
+    }();
+    return Instance;
+  }
+
+  uint32_t getSiteId(EventKind Kind, const IntTypeId (&TypeIds)[MaxTypes],
+                     const char* Filename, int Line,
+                     std::initializer_list<const char*> Names) {
+    std::lock_guard<std::mutex> Lock{Mutex_};
+    auto [It, Inserted] = SiteIds_.emplace(
+        getSiteKey(Kind, TypeIds, Filename, Line), SiteIds_.size());
+    if (!Inserted)
+      return It->second;
+    SiteRecord Site{SiteTag, Kind, {}, 0, 0, It->second, Line};
+    std::copy(std::begin(TypeIds), std::end(TypeIds), Site.TypeIds);
+    Site.NumStrings = static_cast<uint8_t>(Names.size() + 1);
+    std::fwrite(&Site, sizeof(Site), 1, File_);
+    std::fputs(Filename, File_);
+    std::fputc('\0', File_);
+    for (const char* Name : Names) {
+      std::fputs(Name, File_);
+      std::fputc('\0', File_);
+    }
+    return It->second;
+  }
+
+  void write(const CheckEvent* Events, size_t Size) {
+    std::lock_guard<std::mutex> Lock{Mutex_};
+    std::fwrite(Events, sizeof(CheckEvent), Size, File_);
+    std::fflush(File_);
+  }
+
+private:
+  std::FILE* File_;
+  std::mutex Mutex_;
+  std::map<SiteKey, uint32_t> SiteIds_;
+};
+
+class EventBuffer final {
+public:
+  ~EventBuffer() { flush(); }
+
+  void push(const CheckEvent& Event) {
+    Events_[Size_++] = Event;
+    if (Size_ == Capacity)
+      flush();
+  }
+
+  void flush() {
+    if (Size_ != 0)
+      EventLog::getInstance()->write(Events_, Size_);
+    Size_ = 0;
+  }
+
+private:
+  static constexpr size_t Capacity = 1024;
+  CheckEvent Events_[Capacity];
+  size_t Size_ = 0;
+};
+
+inline bool isEnabled() { return EventLog::getInstance() != nullptr; }
+
+/* Returns false if event is not logged (log is disabled or some of types
+ * cannot be restored), then message has to be reported as usual. */
+template <typename... Types, typename ResType, typename... OperandTypes>
+bool logEvent(EventKind Kind, ResType CheckRes, const char* Filename, int Line,
+              std::initializer_list<const char*> Names,
+              OperandTypes... Operands) {
+  static_assert(sizeof...(Types) <= MaxTypes);
+  static_assert(sizeof...(Operands) <= MaxOperands);
+  EventLog* Log = EventLog::getInstance();
+  if (!Log || ((getIntTypeId<Types>() == IntTypeId::Unknown) || ...))
+    return false;
+
+  IntTypeId TypeIds[MaxTypes] = {getIntTypeId<Types>()...};
+  std::fill(TypeIds + sizeof...(Types), TypeIds + MaxTypes, IntTypeId::Unknown);
+  thread_local std::map<SiteKey, uint32_t> CachedSiteIds;
+  SiteKey Key = getSiteKey(Kind, TypeIds, Filename, Line);
+  auto It = CachedSiteIds.find(Key);
+  if (It == CachedSiteIds.end())
+    It = CachedSiteIds
+             .emplace(Key, Log->getSiteId(Kind, TypeIds, Filename, Line, Names))
+             .first;
+
+  CheckEvent Event{EventTag, static_cast<uint8_t>(CheckRes), 0, It->second,
+                   {static_cast<uint64_t>(Operands)...},
+                   static_cast<uint64_t>(
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count())};
+  thread_local EventBuffer Buffer;
+  Buffer.push(Event);
+  return true;
+}
+
+} // namespace ub_tester::assert_message_manager::event_log
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+
+/* Each instrumented check refers to one static descriptor of its site instead
+ * of passing location and type names as separate arguments, so call site only
+ * materializes a single address. When compiled by clang for ELF targets
+ * descriptors are placed in the ub_tester_sites section and can be enumerated
+ * with getCheckSites(). GCC rejects one named section shared by descriptors of
+ * inline functions (COMDAT) and ordinary ones (section type conflict), so
+ * there the section is not used and the table is empty. */
+
+#if defined(__ELF__) && defined(__clang__)
+#define UB_TESTER_SITE_TABLE
+// user alignment prevents padding between descriptors of the section
+#define UB_TESTER_SITE_SECTION                                                 \
+  __attribute__((section("ub_tester_sites"), used, aligned(alignof(void*))))
+#else
+#define UB_TESTER_SITE_SECTION
+#endif
+
+/* Lambda gives every expansion its own descriptor (one per instantiation in
+ * templates); it is invoked immediately and folded into a constant. */
+#define UB_TESTER_CHECK_SITE(Operation, Column, ExprText, TypeName1,           \
+                             TypeName2, TypeName3)                             \
+  ([]() -> const ub_tester::assert_message_manager::site::CheckSite* {         \
+    using ub_tester::assert_message_manager::site::CheckSite;                  \
+    UB_TESTER_SITE_SECTION static constexpr CheckSite Site{                    \
+        __FILE__, __LINE__, (Column), #Operation,                              \
+        {(TypeName1), (TypeName2), (TypeName3)}, (ExprText)};                  \
+    return &Site;                                                              \
+  }())
+
+namespace ub_tester::assert_message_manager::site {
+
+constexpr size_t MaxTypeNames = 3;
+
+struct CheckSite final {
+  const char* Filename;
+  int Line;
+  int Column;
+  const char* Operation;
+  // nullptr if type is deduced at instantiation (type-generic checks)
+  const char* TypeNames[MaxTypeNames];
+  const char* ExprText; // as written in source, may be shortened by tool
+};
+
+struct CheckSiteRange final {
+  const CheckSite* begin() const { return Begin; }
+  const CheckSite* end() const { return End; }
+  const CheckSite* Begin;
+  const CheckSite* End;
+};
+
+#ifdef UB_TESTER_SITE_TABLE
+// provided by linker for sections named as C identifiers
+extern "C" {
+extern const CheckSite __start_ub_tester_sites[] __attribute__((weak));
+extern const CheckSite __stop_ub_tester_sites[] __attribute__((weak));
+}
+
+inline CheckSiteRange getCheckSites() {
+  return {__start_ub_tester_sites, __stop_ub_tester_sites};
+}
+#else
+inline CheckSiteRange getCheckSites() { return {nullptr, nullptr}; }
+#endif
+
+} // namespace ub_tester::assert_message_manager::site
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "AssertMessageManager.h"
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <csignal>
+#include <unistd.h>
+#define UB_TESTER_CONTROL_SIGNAL
+#endif
+
+/* Check categories and single sites can be disabled in running program:
+ * UB_TESTER_DISABLE lists them at startup, e.g. "cast,iob,main.cpp:42", list
+ * in UB_TESTER_CONTROL_FILE replaces it at startup and on SIGUSR1.
+ * Arithmetic checks consult the table before checking; index, pointer and
+ * uninit checks are single comparisons, so they consult it only on failure. */
+
+namespace ub_tester::assert_message_manager::toggles {
+
+constexpr char DisableEnvVar[] = "UB_TESTER_DISABLE";
+constexpr char ControlFileEnvVar[] = "UB_TESTER_CONTROL_FILE";
+
+enum class CheckCategory : uint32_t {
+  Arithm,
+  ImplicitCast,
+  IOB,
+  Pointer,
+  Uninit,
+  NumCategories
+};
+
+inline const char* const CategoryNames[] = {"arithm", "cast", "iob", "ptr",
+                                            "uninit"};
+static_assert(std::size(CategoryNames) ==
+              static_cast<size_t>(CheckCategory::NumCategories));
+
+// set if some of sites are disabled, they are looked up only then
+constexpr uint32_t DisabledSitesBit =
+    1u << static_cast<uint32_t>(CheckCategory::NumCategories);
+
+struct DisabledSite final {
+  std::string File; // matches filename or its trailing path components
+  int Line;
+};
+
+// the whole table is one cache line, which is read-only while not updated
+struct alignas(64) EnableTable final {
+  std::atomic<uint32_t> DisabledMask{0};
+  std::atomic<const std::vector<DisabledSite>*> DisabledSites{nullptr};
+};
+
+inline EnableTable Table;
+
+// tool compiles instrumented copies of files, sites name the original ones
+constexpr std::string_view InstrumentedFilePrefix = "IMPROVED_";
+
+inline bool matchesSite(const DisabledSite& Site, const char* Filename,
+                        int Line) {
+  if (Site.Line != Line)
+    return false;
+  std::string_view Name{Filename};
+  size_t BaseBegin = Name.rfind('/') + 1;
+  std::string_view Dir = Name.substr(0, BaseBegin);
+  std::string_view Base = Name.substr(BaseBegin);
+  std::string_view SiteFile{Site.File};
+  size_t SiteBaseBegin = SiteFile.rfind('/') + 1;
+  std::string_view SiteBase = SiteFile.substr(SiteBaseBegin);
+  std::string_view SiteDir = SiteFile.substr(0, SiteBaseBegin);
+  if (SiteBase != Base &&
+      (Base.substr(0, InstrumentedFilePrefix.size()) !=
+           InstrumentedFilePrefix ||
+       SiteBase != Base.substr(InstrumentedFilePrefix.size())))
+    return false;
+  if (Dir.size() < SiteDir.size() ||
+      Dir.substr(Dir.size() - SiteDir.size()) != SiteDir)
+    return false;
+  return SiteDir.empty() || Dir.size() == SiteDir.size() ||
+         Dir[Dir.size() - SiteDir.size() - 1] == '/';
+}
+
+inline bool isSiteEnabled(const char* Filename, int Line) {
+  const auto* Sites = Table.DisabledSites.load(std::memory_order_acquire);
+  if (!Sites)
+    return true;
+  for (const auto& Site : *Sites)
+    if (matchesSite(Site, Filename, Line))
+      return false;
+  return true;
+}
+
+inline bool isCheckEnabled(CheckCategory Category, const char* Filename,
+                           int Line) {
+  uint32_t CategoryBit = 1u << static_cast<uint32_t>(Category);
+  uint32_t Mask = Table.DisabledMask.load(std::memory_order_relaxed);
+  if (UB_TESTER_UNLIKELY(Mask & (CategoryBit | DisabledSitesBit)))
+    return !(Mask & CategoryBit) && isSiteEnabled(Filename, Line);
+  return true;
+}
+
+/* Replaces the table by names of categories and file:line sites separated by
+ * commas or whitespace. Previous site lists are never freed, because checks
+ * of other threads may still read them. */
+inline void setDisabledChecks(const std::string& Spec) {
+  std::string Normalized = Spec;
+  for (char& Char : Normalized)
+    if (Char == ',')
+      Char = ' ';
+  uint32_t Mask = 0;
+  auto* Sites = new std::vector<DisabledSite>{};
+  std::istringstream SStream{Normalized};
+  for (std::string Name; SStream >> Name;) {
+    size_t Category = 0;
+    while (Category < std::size(CategoryNames) &&
+           Name != CategoryNames[Category])
+      ++Category;
+    if (Category < std::size(CategoryNames)) {
+      Mask |= 1u << Category;
+      continue;
+    }
+    size_t Colon = Name.rfind(':');
+    if (Colon == std::string::npos || Colon + 1 == Name.size() ||
+        !std::isdigit(static_cast<unsigned char>(Name[Colon + 1]))) {
+      std::cerr << "ub-tester: unknown check category " << Name << "\n";
+      continue;
+    }
+    Sites->push_back({Name.substr(0, Colon), std::atoi(&Name[Colon + 1])});
+  }
+  if (!Sites->empty())
+    Mask |= DisabledSitesBit;
+  Table.DisabledSites.store(Sites->empty() ? nullptr : Sites,
+                            std::memory_order_release);
+  Table.DisabledMask.store(Mask, std::memory_order_release);
+}
+
+inline void readControlFile(const char* Path) {
+  std::ifstream Control{Path};
+  if (!Control) {
+    std::cerr << "ub-tester: cannot read control file " << Path << "\n";
+    return;
+  }
+  std::stringstream Content;
+  Content << Control.rdbuf();
+  setDisabledChecks(Content.str());
+}
+
+#ifdef UB_TESTER_CONTROL_SIGNAL
+// signal handler only wakes up reloading thread, which reads control file
+inline int ReloadPipe[2] = {-1, -1};
+
+inline void requestReload(int) {
+  char Byte = 0;
+  [[maybe_unused]] ssize_t Written = write(ReloadPipe[1], &Byte, 1);
+}
+
+inline void startControlFileReloader(const char* Path) {
+  if (pipe(ReloadPipe) != 0)
+    return;
+  std::thread{[Path] {
+    char Byte;
+    while (read(ReloadPipe[0], &Byte, 1) > 0)
+      readControlFile(Path);
+  }}.detach();
+  std::signal(SIGUSR1, requestReload);
+}
+#endif
+
+inline const bool IsSetUp = [] {
+  if (const char* Spec = std::getenv(DisableEnvVar))
+    setDisabledChecks(Spec);
+  if (const char* Path = std::getenv(ControlFileEnvVar)) {
+    readControlFile(Path);
+#ifdef UB_TESTER_CONTROL_SIGNAL
+    startControlFileReloader(Path);
+#endif
+  }
+  return true;
+}();
+
+} // namespace ub_tester::assert_message_manager::toggles
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+/* If UB_TESTER_REPORT_FILE=<file> is set, detecting threads only enqueue
+ * messages: background thread of manager writes them to the file as JSON
+ * lines or SARIF (UB_TESTER_REPORT_FORMAT=jsonl|sarif). When the file exceeds
+ * UB_TESTER_REPORT_MAX_BYTES, it is renamed to <file>.1 and older files are
+ * shifted, at most UB_TESTER_REPORT_MAX_FILES of them are kept. */
+
+namespace ub_tester::assert_message_manager::report {
+
+constexpr char FileEnvVar[] = "UB_TESTER_REPORT_FILE";
+constexpr char FormatEnvVar[] = "UB_TESTER_REPORT_FORMAT";
+constexpr char MaxBytesEnvVar[] = "UB_TESTER_REPORT_MAX_BYTES";
+constexpr char MaxFilesEnvVar[] = "UB_TESTER_REPORT_MAX_FILES";
+constexpr unsigned DefaultMaxFiles = 4;
+
+enum class ReportFormat { JsonLines, Sarif };
+
+struct ReportRecord final {
+  uint64_t Id;
+  bool IsError;
+  const char* RuleId;
+  std::string Text;
+  const char* Filename; // nullptr if location is unknown
+  int Line;
+  uint64_t Hits;
+  uint64_t FirstSeenMs; // since start of program
+  uint64_t LastSeenMs;
+};
+
+inline std::string escapeJson(const std::string& Str) {
+  std::string Escaped;
+  Escaped.reserve(Str.size());
+  for (char Char : Str) {
+    switch (Char) {
+    case '"':
+      Escaped += "\\\"";
+      break;
+    case '\\':
+      Escaped += "\\\\";
+      break;
+    case '\n':
+      Escaped += "\\n";
+      break;
+    case '\t':
+      Escaped += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(Char) < 0x20) {
+        char Code[8];
+        std::snprintf(Code, sizeof(Code), "\\u%04x", Char);
+        Escaped += Code;
+      } else
+        Escaped += Char;
+    }
+  }
+  return Escaped;
+}
+
+class ReportFile final {
+private:
+  ReportFile(std::string Path, ReportFormat Format, uint64_t MaxBytes,
+             unsigned MaxFiles)
+      : Path_{std::move(Path)}, Format_{Format}, MaxBytes_{MaxBytes},
+        MaxFiles_{MaxFiles} {}
+
+public:
+  ~ReportFile() { close(); }
+
+  // nullptr if report file is not requested or cannot be opened
+  static std::unique_ptr<ReportFile> open() {
+    const char* Path = std::getenv(FileEnvVar);
+    if (!Path || !*Path)
+      return nullptr;
+    const char* Format = std::getenv(FormatEnvVar);
+    const char* MaxBytes = std::getenv(MaxBytesEnvVar);
+    const char* MaxFiles = std::getenv(MaxFilesEnvVar);
+    std::unique_ptr<ReportFile> Report{new ReportFile{
+        Path,
+        Format && std::string{Format} == "sarif" ? ReportFormat::Sarif
+                                                 : ReportFormat::JsonLines,
+        MaxBytes ? std::strtoull(MaxBytes, nullptr, 10) : 0,
+        MaxFiles ? static_cast<unsigned>(std::strtoul(MaxFiles, nullptr, 10))
+                 : DefaultMaxFiles}};
+    if (!Report->openFile()) {
+      std::cerr << "cannot open report file " << Path
+                << ", messages are printed as text\n";
+      return nullptr;
+    }
+    return Report;
+  }
+
+  void write(const ReportRecord& Record) {
+    std::string Formatted = Format_ == ReportFormat::Sarif
+                                ? formatSarifResult(Record)
+                                : formatJsonLine(Record);
+    if (MaxBytes_ != 0 && Size_ + Formatted.size() > MaxBytes_ &&
+        NumRecords_ != 0)
+      rotate();
+    if (!File_)
+      return;
+    if (Format_ == ReportFormat::Sarif && NumRecords_ != 0)
+      writeString(",\n");
+    writeString(Formatted);
+    ++NumRecords_;
+  }
+
+  void flush() {
+    if (File_)
+      std::fflush(File_);
+  }
+
+private:
+  static std::string formatJsonLine(const ReportRecord& Record) {
+    std::string Line = "{\"id\": " + std::to_string(Record.Id) +
+                       ", \"level\": \"" +
+                       (Record.IsError ? "error" : "warning") +
+                       "\", \"rule\": \"" + Record.RuleId + "\"";
+    if (Record.Filename)
+      Line += ", \"file\": \"" + escapeJson(Record.Filename) +
+              "\", \"line\": " + std::to_string(Record.Line);
+    Line += ", \"hits\": " + std::to_string(Record.Hits) +
+            ", \"first_seen_ms\": " + std::to_string(Record.FirstSeenMs) +
+            ", \"last_seen_ms\": " + std::to_string(Record.LastSeenMs) +
+            ", \"message\": \"" + escapeJson(Record.Text) + "\"}\n";
+    return Line;
+  }
+
+  static std::string formatSarifResult(const ReportRecord& Record) {
+    std::string Result = "{\"ruleId\": \"" + std::string{Record.RuleId} +
+                         "\", \"level\": \"" +
+                         (Record.IsError ? "error" : "warning") +
+                         "\", \"message\": {\"text\": \"" +
+                         escapeJson(Record.Text) + "\"}";
+    if (Record.Filename)
+      Result += ", \"locations\": [{\"physicalLocation\": "
+                "{\"artifactLocation\": {\"uri\": \"" +
+                escapeJson(Record.Filename) +
+                "\"}, \"region\": {\"startLine\": " +
+                std::to_string(Record.Line) + "}}}]";
+    Result += ", \"occurrenceCount\": " + std::to_string(Record.Hits) +
+              ", \"properties\": {\"id\": " + std::to_string(Record.Id) +
+              ", \"firstSeenMs\": " + std::to_string(Record.FirstSeenMs) +
+              ", \"lastSeenMs\": " + std::to_string(Record.LastSeenMs) + "}}";
+    return Result;
+  }
+
+  bool openFile() {
+    File_ = std::fopen(Path_.c_str(), "w");
+    Size_ = 0;
+    NumRecords_ = 0;
+    if (File_ && Format_ == ReportFormat::Sarif)
+      writeString("{\"version\": \"2.1.0\", \"$schema\": "
+                  "\"https://json.schemastore.org/sarif-2.1.0.json\", "
+                  "\"runs\": [{\"tool\": {\"driver\": {\"name\": "
+                  "\"ub-tester\"}}, \"results\": [\n");
+    return File_ != nullptr;
+  }
+
+  void close() {
+    if (!File_)
+      return;
+    if (Format_ == ReportFormat::Sarif)
+      writeString("\n]}]}\n");
+    std::fclose(File_);
+    File_ = nullptr;
+  }
+
+  void rotate() {
+    close();
+    if (MaxFiles_ == 0)
+      std::remove(Path_.c_str());
+    else {
+      std::remove((Path_ + "." + std::to_string(MaxFiles_)).c_str());
+      for (unsigned Index = MaxFiles_ - 1; Index != 0; --Index)
+        std::rename((Path_ + "." + std::to_string(Index)).c_str(),
+                    (Path_ + "." + std::to_string(Index + 1)).c_str());
+      std::rename(Path_.c_str(), (Path_ + ".1").c_str());
+    }
+    openFile();
+  }
+
+  void writeString(const std::string& Str) {
+    std::fwrite(Str.data(), 1, Str.size(), File_);
+    Size_ += Str.size();
+  }
+
+  std::string Path_;
+  ReportFormat Format_;
+  uint64_t MaxBytes_;
+  unsigned MaxFiles_;
+  std::FILE* File_ = nullptr;
+  uint64_t Size_ = 0;
+  uint64_t NumRecords_ = 0;
+};
+
+} // namespace ub_tester::assert_message_manager::report
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "ConfigInString.h"
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <iostream>
 #include <string>
+#include <vector>
 
 namespace ub_tester::cli {
 
@@ -11,12 +15,51 @@ extern bool RunIOB;
 extern bool RunArithm;
 extern bool RunUninit;
 extern bool SuppressAllOutput;
+// malloc family of instrumented program is replaced to register blocks
+extern bool AllocRegistry;
+// uninitialized variables are wrapped in UBSafeType or tracked in shadow memory
+enum class UninitBackendKind { Wrapper, Shadow };
+extern UninitBackendKind UninitBackend;
+// profile-guided instrumentation, off if ProfileFilename is empty
+extern std::string ProfileFilename;
+extern std::string OverheadBudget;
+// globs for files and qualified function names to (not) instrument
+extern std::vector<std::string> InstrumentedFiles;
+extern std::vector<std::string> SkippedFiles;
+extern std::vector<std::string> InstrumentedFuncs;
+extern std::vector<std::string> SkippedFuncs;
+// warning categories and operations whose checks are not compiled
+extern std::vector<std::string> SuppressedWarnings;
+extern std::vector<std::string> DisabledChecks;
+
+// only wrapper backend substitutes builtin types
+inline bool wrapsUninitVars() {
+  return RunUninit && UninitBackend == UninitBackendKind::Wrapper;
+}
 
 namespace internal {
 
 enum ApplyOnly { IOB, Arithm, Uninit, All };
 extern ApplyOnly CheckToApply;
 
+inline void writeConfigFlags(std::ofstream& ConfigOStream,
+                             const consts::ConfigFlagNames& FlagNames,
+                             const std::vector<std::string>& Values,
+                             const std::string& OptionName) {
+  for (const auto& Value : Values)
+    if (std::none_of(
+            FlagNames.begin(), FlagNames.end(),
+            [&Value](const auto& Flag) { return Flag.first == Value; })) {
+      std::cerr << "Unknown value " << Value << " of -" << OptionName << "\n";
+      exit(1);
+    }
+  for (const auto& [Value, FlagName] : FlagNames) {
+    bool IsSet = std::find(Values.begin(), Values.end(), Value) != Values.end();
+    ConfigOStream << consts::ConfigFlagVariableType << " " << FlagName << " = "
+                  << (IsSet ? "true" : "false") << ";\n";
+  }
+}
+
 } // namespace internal
 
 inline void processFlags() {
@@ -49,12 +92,20 @@ inline void processFlags() {
   }
   // generate manager header
   std::ofstream ConfigOStream(ConfigName, std::ios::out);
-  ConfigOStream << "#pragma once\n\n#define UBCONFIG_H_\n\n"
-                << ConfigFlagsNamespace << " {\n";
+  ConfigOStream << "#pragma once\n\n#define UBCONFIG_H_\n\n";
+  if (AllocRegistry)
+    ConfigOStream << "#define " << ConfigAllocRegistryMacroName << "\n\n";
+  if (UninitBackend == UninitBackendKind::Shadow)
+    ConfigOStream << "#define " << ConfigUninitShadowMacroName << "\n\n";
+  ConfigOStream << ConfigFlagsNamespace << " {\n";
   ConfigOStream << ConfigSuppressAllOutputFlagVariableName << " = "
                 << (SuppressAllOutput ? "true" : "false") << ";\n";
   ConfigOStream << ConfigSuppressWarningsFlagVariableName << " = "
                 << (SuppressWarnings ? "true" : "false") << ";\n";
+  writeConfigFlags(ConfigOStream, ConfigSuppressedWarningsFlags,
+                   SuppressedWarnings, "suppress");
+  writeConfigFlags(ConfigOStream, ConfigDisabledChecksFlags, DisabledChecks,
+                   "disable-checks");
   ConfigOStream << "} // " << ConfigFlagsNamespace;
   ConfigOStream.close();
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ub_tester::cli::internal::consts {
 
@@ -11,5 +13,35 @@ inline const std::string ConfigSuppressAllOutputFlagVariableName =
     "constexpr bool SUPPRESS_ALL"; // = false;
 inline const std::string ConfigSuppressWarningsFlagVariableName =
     "constexpr bool SUPPRESS_WARNINGS"; // = false;
+inline const std::string ConfigFlagVariableType = "constexpr bool";
+inline const std::string ConfigAllocRegistryMacroName =
+    "UB_TESTER_ALLOCATION_REGISTRY";
+inline const std::string ConfigUninitShadowMacroName =
+    "UB_TESTER_UNINIT_SHADOW";
+
+using ConfigFlagNames = std::vector<std::pair<std::string, std::string>>;
+// values of -suppress and flags they set
+inline const ConfigFlagNames ConfigSuppressedWarningsFlags = {
+    {"arithm", "SUPPRESS_ARITHM_WARNINGS"},
+    {"unsigned-overflow", "SUPPRESS_UNSIGNED_OVERFLOW_WARNING"},
+    {"bitshift-cxx20", "SUPPRESS_OVERFLOW_IN_BITSHIFT_CXX20_WARNING"},
+    {"unsafe-conv", "SUPPRESS_UNSAFE_CONV_WARNING"},
+    {"impl-defined-conv", "SUPPRESS_IMPL_DEFINED_UNSAFE_CONV_WARNING"},
+    {"uninit", "SUPPRESS_UNINIT_VARS_WARNINGS"},
+    {"ptr", "SUPPRESS_PTR_UB_WARNINGS"},
+    {"impl-defined", "SUPPRESS_IMPL_DEFINED_WARNING"},
+    {"not-considered", "SUPPRESS_NOT_CONSIDERED_WARNING"}};
+// values of -disable-checks and flags they set
+inline const ConfigFlagNames ConfigDisabledChecksFlags = {
+    {"sum", "DISABLE_SUM_CHECKS"},
+    {"diff", "DISABLE_DIFF_CHECKS"},
+    {"mul", "DISABLE_MUL_CHECKS"},
+    {"div", "DISABLE_DIV_CHECKS"},
+    {"mod", "DISABLE_MOD_CHECKS"},
+    {"shl", "DISABLE_BITSHIFT_LEFT_CHECKS"},
+    {"shr", "DISABLE_BITSHIFT_RIGHT_CHECKS"},
+    {"neg", "DISABLE_UNARY_NEG_CHECKS"},
+    {"incr-decr", "DISABLE_INCR_DECR_CHECKS"},
+    {"cast", "DISABLE_IMPLICIT_CAST_CHECKS"}};
 
 } // namespace ub_tester::cli::internal::consts
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "code-injector/CodeInjector.h"
+#include "overhead-budget/InstrumentationPlanner.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/Basic/SourceManager.h"
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace ub_tester::code_injector::wrapper {
@@ -21,12 +23,29 @@ public:
   void substitute(const clang::SourceRange& Range, std::string NewString,
                   const clang::ASTContext* Context);
   void substitute(Substitution Subst, const clang::ASTContext* Context);
+  // check may be left out by planner; Fallback is applied instead if present
+  void substituteCheck(Substitution Subst, std::optional<Substitution> Fallback,
+                       budget::CheckKind Kind, clang::SourceLocation Loc,
+                       const clang::ASTContext* Context);
+
+  void setPlanner(std::unique_ptr<budget::InstrumentationPlanner> Planner);
 
 private:
   explicit InjectorASTWrapper() = default;
 
+  void applyPlannedChecks();
+
 private:
+  struct PlannedCheck {
+    size_t InjectorIdx;
+    Substitution Subst;
+    std::optional<Substitution> Fallback;
+  };
+
   std::vector<std::unique_ptr<CodeInjector>> InternalInjectors_;
+  std::unique_ptr<budget::InstrumentationPlanner> Planner_;
+  std::vector<PlannedCheck> PlannedChecks_;
+  std::vector<budget::CheckSite> CheckSites_;
 };
 
 template <typename... ExprTypes>
@@ -37,6 +56,7 @@ struct SubstitutionASTWrapper {
       : Context_{Context} {}
 
   SubstitutionASTWrapper& setLoc(clang::SourceLocation Loc) {
+    Loc_ = Loc;
     Subst_.setOffset(Context_->getSourceManager().getFileOffset(Loc));
     return *this;
   }
@@ -59,13 +79,38 @@ struct SubstitutionASTWrapper {
     return *this;
   }
 
+  // substitution is a check which may be left out under overhead budget
+  SubstitutionASTWrapper& setCheckKind(budget::CheckKind Kind) {
+    Kind_ = Kind;
+    return *this;
+  }
+
+  // output used instead of the check if it is left out
+  SubstitutionASTWrapper& setFallbackOutputFormat(std::string OutputFormat) {
+    FallbackOutputFormat_ = std::move(OutputFormat);
+    return *this;
+  }
+
   void apply() {
-    InjectorASTWrapper::getInstance().substitute(std::move(Subst_), Context_);
+    if (!Kind_.has_value()) {
+      InjectorASTWrapper::getInstance().substitute(std::move(Subst_), Context_);
+      return;
+    }
+    std::optional<Substitution> Fallback;
+    if (FallbackOutputFormat_.has_value()) {
+      Fallback = Subst_;
+      Fallback->setOutputFormat(std::move(FallbackOutputFormat_.value()));
+    }
+    InjectorASTWrapper::getInstance().substituteCheck(
+        std::move(Subst_), std::move(Fallback), Kind_.value(), Loc_, Context_);
   }
 
 private:
   const clang::ASTContext* Context_;
   Substitution Subst_;
+  clang::SourceLocation Loc_;
+  std::optional<budget::CheckKind> Kind_;
+  std::optional<std::string> FallbackOutputFormat_;
 };
 
 }; // namespace ub_tester::code_injector::wrapper
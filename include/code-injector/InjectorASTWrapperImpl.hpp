@@ -39,6 +39,14 @@ void generateArgumentsForSubstitutionHelper(const clang::ASTContext* Context,
     generateArgumentsForSubstitutionHelper(Context, Vec, Arg.value());
 }
 
+template <typename T>
+void generateArgumentsForSubstitutionHelper(const clang::ASTContext* Context,
+                                            SubstArgs& Vec,
+                                            const std::vector<T>& Args) {
+  for (const auto& Arg : Args)
+    generateArgumentsForSubstitutionHelper(Context, Vec, Arg);
+}
+
 template <typename T, typename U>
 void generateArgumentsForSubstitutionHelper(const clang::ASTContext* Context,
                                             SubstArgs& Vec, const T& Arg1,
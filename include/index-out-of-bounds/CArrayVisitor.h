@@ -3,11 +3,21 @@
 #include "clang/AST/RecursiveASTVisitor.h"
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace ub_tester {
 
+namespace iob {
+
+// variable or field whose array type is replaced by safe array, rows are
+// substituted also in types of safe pointers
+bool isSubstitutedArray(const clang::Expr* Ex,
+                        const clang::ASTContext* Context);
+
+} // namespace iob
+
 class CArrayVisitor : public clang::RecursiveASTVisitor<CArrayVisitor> {
 public:
   explicit CArrayVisitor(clang::ASTContext*);
@@ -20,16 +30,36 @@ public:
   bool VisitInitListExpr(clang::InitListExpr*);
   bool VisitStringLiteral(clang::StringLiteral*);
   bool VisitArraySubscriptExpr(clang::ArraySubscriptExpr*);
+  bool VisitImplicitCastExpr(clang::ImplicitCastExpr*);
+  bool VisitUnaryExprOrTypeTraitExpr(clang::UnaryExprOrTypeTraitExpr*);
+  bool VisitCallExpr(clang::CallExpr*);
+  bool VisitCXXForRangeStmt(clang::CXXForRangeStmt*);
 
   bool TraverseVarDecl(clang::VarDecl*);
 
 private:
   std::pair<std::string, std::string> getCtorFormats();
   std::pair<std::string, std::string> getSubscriptFormats();
+  std::pair<std::string, std::string>
+  getMultiSubscriptFormats(size_t NumIndices);
+  std::vector<clang::ArraySubscriptExpr*>
+  getSubscriptChain(clang::ArraySubscriptExpr*);
+  bool isSubscriptBase(const clang::ImplicitCastExpr* Decay);
+  bool isSizeOfSubstitutedArray(const clang::UnaryExprOrTypeTraitExpr*);
+  bool isCheckedBuffer(const clang::Expr* Arg);
+  bool isCheckedLibcCall(const clang::CallExpr* Call);
+  bool isCheckedLibcCallArg(const clang::ImplicitCastExpr* Decay);
+  bool isRangeReadOfTrackedArray(const clang::CXXForRangeStmt* RangeFor);
 
 private:
   void executeSubstitutionOfSubscript(clang::ArraySubscriptExpr*);
+  void executeSubstitutionOfMultiSubscript(
+      const std::vector<clang::ArraySubscriptExpr*>& Chain);
   void executeSubstitutionOfCtor(clang::VarDecl*);
+  void executeSubstitutionOfDecay(clang::ImplicitCastExpr* Decay);
+  void executeSubstitutionOfSizeOf(clang::UnaryExprOrTypeTraitExpr* SizeOf);
+  void executeSubstitutionOfLibcCall(clang::CallExpr* Call);
+  void executeSubstitutionOfRangeRead(clang::CXXForRangeStmt* RangeFor);
 
 private:
   struct ArrayInfo_t {
@@ -38,10 +68,13 @@ private:
     std::vector<std::string> Sizes_;
     size_t Dimension_;
     bool ShouldVisitNodes_, IsIncompleteType_, ShouldVisitImplicitCode_;
+    bool IsVariableSize_; // some of dimensions is known only at runtime
   };
 
 private:
   ArrayInfo_t Array_;
+  // inner subscripts of chains checked by ASSERT_IOB_N
+  std::unordered_set<const clang::ArraySubscriptExpr*> FusedSubscripts_;
   clang::ASTContext* Context_;
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cctype>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -9,27 +10,51 @@ namespace ub_tester::iob::names_to_inject {
 
 namespace {
 
-constexpr char SizesTypeName[] = "std::vector<int>";
 constexpr char IOBAssertName[] = "ASSERT_IOB";
+constexpr char IOBMultiAssertName[] = "ASSERT_IOB_N";
 constexpr char InvalidSizeAssertName[] = "ASSERT_INVALID_SIZE";
+constexpr char LibcCallAssertPrefix[] = "ASSERT_";
 
 } // namespace
 
+// functions of C library whose calls on safe buffers are replaced by checkers
+inline const std::vector<std::string> CheckedLibcFuncs = {
+    "memcpy", "memmove", "memset", "strcpy", "strlen", "read", "fwrite"};
+
+// e.g. ASSERT_MEMCPY(@, @, @)
+inline std::string generateLibcCallAssertName(const std::string& FuncName,
+                                              size_t NumArgs) {
+  std::stringstream SStream;
+  SStream << LibcCallAssertPrefix;
+  for (char Char : FuncName)
+    SStream << static_cast<char>(std::toupper(Char));
+  SStream << "(";
+  for (size_t I = 0; I < NumArgs; ++I)
+    SStream << (I == 0 ? "@" : ", @");
+  SStream << ")";
+  return SStream.str();
+}
+
+// Sizes are empty unless some of dimensions is runtime-sized
 inline std::string
 generateSafeArrayCtor(const std::vector<std::string>& Sizes,
                       const std::optional<std::string>& InitList) {
   std::stringstream SStream;
-  SStream << InvalidSizeAssertName << "(" << SizesTypeName << "({";
-  for (size_t I = 0, Size = Sizes.size(); I < Size; ++I) {
-    SStream << Sizes[I];
-    if (I != Size - 1) {
-      SStream << ", ";
+  if (!Sizes.empty()) {
+    SStream << InvalidSizeAssertName << "(";
+    for (size_t I = 0, Size = Sizes.size(); I < Size; ++I) {
+      SStream << Sizes[I];
+      if (I != Size - 1) {
+        SStream << ", ";
+      }
     }
+    SStream << ")";
+    if (InitList.has_value())
+      SStream << ", ";
   }
-  SStream << "}))";
 
   if (InitList.has_value()) {
-    SStream << ", " << InitList.value();
+    SStream << InitList.value();
   }
   return SStream.str();
 }
@@ -41,4 +66,15 @@ inline std::string generateIOBAssertName(const std::string& Lhs,
   return SStream.str();
 }
 
+inline std::string
+generateIOBMultiAssertName(const std::string& Array,
+                           const std::vector<std::string>& Indices) {
+  std::stringstream SStream;
+  SStream << IOBMultiAssertName << "(" << Array;
+  for (const auto& Index : Indices)
+    SStream << ", " << Index;
+  SStream << ")";
+  return SStream.str();
+}
+
 } // namespace ub_tester::iob::names_to_inject
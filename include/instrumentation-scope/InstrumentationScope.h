@@ -0,0 +1,54 @@
+#pragma once
+
+#include "clang/AST/ASTConsumer.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "llvm/Support/Error.h"
+#include <string>
+#include <vector>
+
+namespace ub_tester::scope {
+
+/* Parts of the main file left as is: files not matching -instrument-files or
+ * matching -skip-files, functions filtered the same way by qualified name,
+ * declarations annotated with [[clang::annotate("ub_tester_off")]] and
+ * regions between "// ub-tester: off" and "// ub-tester: on" comments.
+ * Globs are matched against both full path and file name. */
+llvm::Error setUpFilters(const std::vector<std::string>& InstrumentedFiles,
+                         const std::vector<std::string>& SkippedFiles,
+                         const std::vector<std::string>& InstrumentedFuncs,
+                         const std::vector<std::string>& SkippedFuncs);
+
+bool shouldInstrument(clang::SourceLocation Loc,
+                      const clang::ASTContext* Context);
+/* Written in main file, excluded regions included: uses of substituted
+ * declarations there are still rewritten to keep code well-typed, though
+ * they are not checked. */
+bool isInMainFile(clang::SourceLocation Loc, const clang::ASTContext* Context);
+// declared in main file but left as is, so keeps its original type
+bool isExcluded(const clang::Decl* D, const clang::ASTContext* Context);
+bool hasCodeToInstrument(const clang::ASTContext* Context);
+
+class InstrumentationScopeVisitor
+    : public clang::RecursiveASTVisitor<InstrumentationScopeVisitor> {
+public:
+  explicit InstrumentationScopeVisitor(clang::ASTContext* Context);
+  bool VisitDecl(clang::Decl* D);
+  bool VisitFunctionDecl(clang::FunctionDecl* FuncDecl);
+
+private:
+  void excludeRange(clang::SourceRange Range);
+
+private:
+  clang::ASTContext* Context_;
+};
+
+class InstrumentationScopeConsumer : public clang::ASTConsumer {
+public:
+  explicit InstrumentationScopeConsumer(clang::ASTContext* Context);
+  virtual void HandleTranslationUnit(clang::ASTContext& Context);
+
+private:
+  InstrumentationScopeVisitor ScopeVisitor_;
+};
+
+} // namespace ub_tester::scope
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "overhead-budget/Profile.h"
+#include "llvm/ADT/StringRef.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ub_tester::budget {
+
+enum class CheckKind { Arithm, IOB, Pointer, Uninit };
+
+struct CheckSite {
+  std::string Filename;
+  unsigned Line;
+  CheckKind Kind;
+};
+
+// "15%" or "15"
+std::optional<double> parseOverheadBudget(llvm::StringRef Budget);
+
+/* Chooses check sites to instrument so that estimated overhead stays within
+ * budget. Overhead of a site is its line's weight in the profile times the
+ * relative cost of the check; the hottest sites are left out first. Sites
+ * absent from the profile are cold and always instrumented. */
+class InstrumentationPlanner {
+public:
+  InstrumentationPlanner(Profile Prof, double BudgetInPercent);
+
+  // for each site, whether it is instrumented; choices are logged to stderr
+  std::vector<bool> plan(const std::vector<CheckSite>& Sites) const;
+
+private:
+  Profile Profile_;
+  double BudgetInPercent_;
+};
+
+} // namespace ub_tester::budget
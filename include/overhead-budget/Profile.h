@@ -0,0 +1,44 @@
+#pragma once
+
+#include "llvm/ADT/StringRef.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ub_tester::budget {
+
+/* Execution profile of the program to instrument, aggregated per source line.
+ * Two formats are accepted and may be mixed in one file:
+ *  - counters, one "path:line count" pair per line;
+ *  - `perf script -F ip,srcline` (callchains allowed) output: each sample is
+ *    attributed to the first source line printed after its IP.
+ * Files are matched by trailing path components, so relative paths match
+ * absolute ones printed by profilers. */
+class Profile {
+public:
+  static std::optional<Profile> load(const std::string& Filename);
+
+  // share of the program's execution spent on the line, in [0, 1]
+  double getLineWeight(llvm::StringRef Filename, unsigned Line) const;
+  bool empty() const;
+
+private:
+  void addCount(llvm::StringRef Filename, unsigned Line, uint64_t Count);
+  void parseLine(llvm::StringRef Line);
+
+private:
+  struct PathCount_t {
+    std::string Path_;
+    uint64_t Count_;
+  };
+
+private:
+  // keyed by "file name:line", files of the same name differ in Path_
+  std::unordered_map<std::string, std::vector<PathCount_t>> LineCounts_;
+  uint64_t TotalCount_{0};
+  bool IsCurrentSampleAttributed_{true};
+};
+
+} // namespace ub_tester::budget
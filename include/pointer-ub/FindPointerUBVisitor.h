@@ -25,6 +25,7 @@ public:
 private:
   std::pair<std::string, std::string> getCtorFormats();
   std::pair<std::string, std::string> getAssignFormats();
+  void setSizeOfDecayedArray(const clang::Expr*);
 
 private:
   void executeSubstitutionOfPointerCtor(clang::VarDecl*);
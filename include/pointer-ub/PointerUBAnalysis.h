@@ -0,0 +1,45 @@
+#pragma once
+
+#include "clang/AST/ASTConsumer.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+
+namespace ub_tester::ptr::analysis {
+
+/* Dereference is proven non-null if its operand is this, &obj or a local
+ * pointer whose address never escapes and which is non-null on every path:
+ * assigned from new or &obj, checked by if (p) / p != nullptr while already
+ * initialized, or already dereferenced. Such dereferences are left as is. */
+bool isProvenNonNullDeref(const clang::UnaryOperator* Unop,
+                          const clang::ASTContext* Context);
+bool isProvenNonNullDeref(const clang::MemberExpr* MembExpr,
+                          const clang::ASTContext* Context);
+
+/* Pointer is kept raw (not substituted with UBSafePointer) if it is an
+ * initialized local or parameter whose value is only dereferenced, compared
+ * or overwritten: never indexed, shifted, copied or escaped. Pointers
+ * declared in regions excluded from instrumentation are raw as well. */
+bool isKeptRaw(const clang::DeclaratorDecl* Decl,
+               const clang::ASTContext* Context);
+bool refersToRawPointer(const clang::Expr* Ex,
+                        const clang::ASTContext* Context);
+
+class PointerUBAnalysisVisitor
+    : public clang::RecursiveASTVisitor<PointerUBAnalysisVisitor> {
+public:
+  explicit PointerUBAnalysisVisitor(clang::ASTContext* Context);
+  bool VisitFunctionDecl(clang::FunctionDecl* FuncDecl);
+
+private:
+  clang::ASTContext* Context_;
+};
+
+class PointerUBAnalysisConsumer : public clang::ASTConsumer {
+public:
+  explicit PointerUBAnalysisConsumer(clang::ASTContext* Context);
+  virtual void HandleTranslationUnit(clang::ASTContext& Context);
+
+private:
+  PointerUBAnalysisVisitor AnalysisVisitor_;
+};
+
+} // namespace ub_tester::ptr::analysis
@@ -9,6 +9,8 @@ namespace ub_tester::ptr::names_to_inject {
 namespace {
 constexpr char AssertStarOperatorName[] = "ASSERT_STAROPERATOR";
 constexpr char AssertMemberExprName[] = "ASSERT_MEMBEREXPR";
+constexpr char AssertRawStarOperatorName[] = "ASSERT_RAW_STAROPERATOR";
+constexpr char AssertRawMemberExprName[] = "ASSERT_RAW_MEMBEREXPR";
 constexpr char SetSizeMethodName[] = "setSize";
 } // namespace
 
@@ -62,4 +64,16 @@ inline std::string getAssertMemberExprAsString(const std::string& PointerName,
   return generateAssertHelper(AssertMemberExprName, PointerName, MemberName);
 }
 
+inline std::string
+getAssertRawStarOperatorAsString(const std::string& ArgName) {
+  return generateAssertHelper(AssertRawStarOperatorName, ArgName);
+}
+
+inline std::string
+getAssertRawMemberExprAsString(const std::string& PointerName,
+                               const std::string& MemberName) {
+  return generateAssertHelper(AssertRawMemberExprName, PointerName,
+                              MemberName);
+}
+
 } // namespace ub_tester::ptr::names_to_inject
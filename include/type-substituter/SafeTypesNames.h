@@ -5,5 +5,6 @@ namespace ub_tester::typenames_to_inject {
 constexpr char SafeArrayName[] = "UBSafeCArray";
 constexpr char SafePointerName[] = "UBSafePointer";
 constexpr char SafeBuiltinVarName[] = "UBSafeType";
+constexpr char SafeFieldName[] = "UBSafeField";
 
 } // namespace ub_tester::typenames_to_inject
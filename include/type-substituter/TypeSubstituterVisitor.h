@@ -37,10 +37,12 @@ public:
 
 private:
   bool TraverseArrayTypeHelper(clang::ArrayType*);
+  bool TraverseArrayElementTypeHelper(clang::QualType ElementType);
   bool VisitDeclaratorDeclHelper(clang::DeclaratorDecl*);
 
   void substituteTypeOfTypedef(clang::TypedefNameDecl*);
   void substituteTypeOfVariable(clang::DeclaratorDecl*);
+  void substituteTypeOfPackedField(clang::FieldDecl*);
   void substituteTypeOfReturn(clang::FunctionDecl*);
 
 private:
@@ -66,6 +68,7 @@ private:
 private:
   bool IsDeclStmtParent_{false};
   bool NeedSubstitution_{false};
+  bool KeepOriginalType_{false};
   TypeInfo_t Type_;
   clang::ASTContext* Context_;
 };
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#ifdef __linux__
+#include <sys/mman.h>
+#define UB_TESTER_ALLOCATION_SHADOW
+#endif
+
+/* Registered heap blocks let checks of raw pointers, which the tool cannot
+ * track, validate accesses against bounds of their allocations. Shadow table
+ * maps every 16-byte granule of a block to the record of its allocation: top
+ * level is indexed by 4 MiB regions, and shadow of a region is mapped when
+ * first block is registered in it, so lookup is three dependent loads.
+ * With UB_TESTER_ALLOCATION_REGISTRY (set by -alloc-registry) on glibc, the
+ * malloc family is replaced and registers every block, including storage of
+ * std containers and of safe arrays. Pointers to stack, globals or memory of
+ * other allocators are not found and are reported as untracked. */
+
+namespace ub_tester::alloc_registry {
+
+struct Allocation final {
+  uintptr_t Begin;
+  size_t Size;
+};
+
+constexpr unsigned GranuleShift = 4; // alignment of malloc on 64-bit targets
+constexpr unsigned RegionShift = 22;
+constexpr unsigned AddressBits = 47; // user space of x86-64 and AArch64
+constexpr size_t RegionGranules = size_t{1} << (RegionShift - GranuleShift);
+constexpr size_t NumRegions = size_t{1} << (AddressBits - RegionShift);
+constexpr uint32_t MaxRecords = 1u << 24; // live blocks, others are untracked
+
+// index of record of allocation per granule, 0 if granule is not allocated
+using RegionShadow = std::atomic<uint32_t>;
+
+/* Registry is constant-initialized, because the first blocks are allocated
+ * before any constructor of the program runs. */
+struct Registry final {
+  std::atomic<std::atomic<RegionShadow*>*> Regions{nullptr};
+  Allocation* Records = nullptr; // set before Regions are published
+  std::atomic<bool> IsLocked{false};
+  uint32_t FreeRecord = 0; // list of free records linked through Size
+  uint32_t NumRecords = 1; // record 0 means no allocation
+};
+
+inline Registry State;
+
+#ifdef UB_TESTER_ALLOCATION_SHADOW
+inline void lock() {
+  while (State.IsLocked.exchange(true, std::memory_order_acquire))
+    ;
+}
+
+inline void unlock() { State.IsLocked.store(false, std::memory_order_release); }
+
+// pages are committed on first touch only
+inline void* mapZeroed(size_t Size) {
+  void* Memory = mmap(nullptr, Size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return Memory == MAP_FAILED ? nullptr : Memory;
+}
+
+// called under lock
+inline std::atomic<RegionShadow*>* getRegions() {
+  auto* Regions = State.Regions.load(std::memory_order_relaxed);
+  if (Regions)
+    return Regions;
+  State.Records =
+      static_cast<Allocation*>(mapZeroed(MaxRecords * sizeof(Allocation)));
+  Regions = static_cast<std::atomic<RegionShadow*>*>(
+      mapZeroed(NumRegions * sizeof(std::atomic<RegionShadow*>)));
+  if (State.Records && Regions)
+    State.Regions.store(Regions, std::memory_order_release);
+  return State.Records ? Regions : nullptr;
+}
+
+// called under lock
+inline RegionShadow* getRegionShadow(std::atomic<RegionShadow*>* Regions,
+                                     size_t Region) {
+  RegionShadow* Shadow = Regions[Region].load(std::memory_order_relaxed);
+  if (!Shadow) {
+    Shadow = static_cast<RegionShadow*>(
+        mapZeroed(RegionGranules * sizeof(RegionShadow)));
+    Regions[Region].store(Shadow, std::memory_order_release);
+  }
+  return Shadow;
+}
+
+inline bool isRegistrable(uintptr_t Begin, size_t Size) {
+  return Begin != 0 && Begin % (uintptr_t{1} << GranuleShift) == 0 &&
+         Size < (uintptr_t{1} << AddressBits) &&
+         (Begin + Size) >> AddressBits == 0;
+}
+
+// block of zero size still owns its first granule, so any access is reported
+inline void setShadow(uintptr_t Begin, size_t Size, uint32_t Record) {
+  auto* Regions = State.Regions.load(std::memory_order_acquire);
+  uintptr_t Granule = Begin >> GranuleShift;
+  uintptr_t EndGranule = (Begin + (Size ? Size : 1) - 1) >> GranuleShift;
+  for (; Granule <= EndGranule; ++Granule) {
+    RegionShadow* Shadow =
+        Regions[Granule >> (RegionShift - GranuleShift)].load(
+            std::memory_order_relaxed);
+    Shadow[Granule & (RegionGranules - 1)].store(Record,
+                                                 std::memory_order_release);
+  }
+}
+
+inline void registerAllocation(void* Pointer, size_t Size) {
+  auto Begin = reinterpret_cast<uintptr_t>(Pointer);
+  if (!isRegistrable(Begin, Size))
+    return;
+  uintptr_t EndGranule = (Begin + (Size ? Size : 1) - 1) >> GranuleShift;
+  lock();
+  auto* Regions = getRegions();
+  uint32_t Record = State.FreeRecord;
+  if (Record != 0)
+    State.FreeRecord = static_cast<uint32_t>(State.Records[Record].Size);
+  else if (Regions && State.NumRecords < MaxRecords)
+    Record = State.NumRecords++;
+  for (size_t Region = Begin >> RegionShift;
+       Record != 0 && Region <= EndGranule >> (RegionShift - GranuleShift);
+       ++Region)
+    if (!getRegionShadow(Regions, Region)) {
+      State.Records[Record].Size = State.FreeRecord;
+      State.FreeRecord = Record;
+      Record = 0;
+    }
+  unlock();
+  if (Record == 0)
+    return;
+  State.Records[Record] = {Begin, Size};
+  // granules of live blocks are disjoint, so they are filled without lock
+  setShadow(Begin, Size, Record);
+}
+
+inline const Allocation* findAllocation(const void* Pointer) {
+  auto Address = reinterpret_cast<uintptr_t>(Pointer);
+  auto* Regions = State.Regions.load(std::memory_order_acquire);
+  if (!Regions || Address >> AddressBits != 0)
+    return nullptr;
+  RegionShadow* Shadow =
+      Regions[Address >> RegionShift].load(std::memory_order_acquire);
+  if (!Shadow)
+    return nullptr;
+  uint32_t Record =
+      Shadow[(Address >> GranuleShift) & (RegionGranules - 1)].load(
+          std::memory_order_acquire);
+  return Record ? &State.Records[Record] : nullptr;
+}
+
+// returns size of the block, 0 if it is not registered
+inline size_t unregisterAllocation(void* Pointer) {
+  const Allocation* Alloc = findAllocation(Pointer);
+  if (!Alloc || Alloc->Begin != reinterpret_cast<uintptr_t>(Pointer))
+    return 0;
+  size_t Size = Alloc->Size;
+  auto Record = static_cast<uint32_t>(Alloc - State.Records);
+  setShadow(Alloc->Begin, Size, 0);
+  lock();
+  State.Records[Record].Size = State.FreeRecord;
+  State.FreeRecord = Record;
+  unlock();
+  return Size;
+}
+#else
+inline void registerAllocation(void*, size_t) {}
+inline const Allocation* findAllocation(const void*) { return nullptr; }
+inline size_t unregisterAllocation(void*) { return 0; }
+#endif
+
+} // namespace ub_tester::alloc_registry
+
+#if defined(UB_TESTER_ALLOCATION_REGISTRY) &&                                 \
+    defined(UB_TESTER_ALLOCATION_SHADOW) && defined(__GLIBC__)
+/* Replacements call allocator of glibc directly. They are weak, so that
+ * every instrumented translation unit may define them. */
+#define UB_TESTER_ALLOCATION_HOOK __attribute__((weak, visibility("default")))
+
+extern "C" {
+void* __libc_malloc(size_t Size);
+void* __libc_calloc(size_t Num, size_t Size);
+void* __libc_realloc(void* Pointer, size_t Size);
+void* __libc_memalign(size_t Alignment, size_t Size);
+void __libc_free(void* Pointer);
+
+UB_TESTER_ALLOCATION_HOOK void* malloc(size_t Size) noexcept {
+  void* Pointer = __libc_malloc(Size);
+  ub_tester::alloc_registry::registerAllocation(Pointer, Size);
+  return Pointer;
+}
+
+UB_TESTER_ALLOCATION_HOOK void* calloc(size_t Num, size_t Size) noexcept {
+  void* Pointer = __libc_calloc(Num, Size);
+  ub_tester::alloc_registry::registerAllocation(Pointer, Num * Size);
+  return Pointer;
+}
+
+// old block stays registered if it cannot be reallocated
+UB_TESTER_ALLOCATION_HOOK void* realloc(void* Pointer, size_t Size) noexcept {
+  size_t OldSize = ub_tester::alloc_registry::unregisterAllocation(Pointer);
+  void* NewPointer = __libc_realloc(Pointer, Size);
+  if (NewPointer)
+    ub_tester::alloc_registry::registerAllocation(NewPointer, Size);
+  else if (Pointer && Size != 0 && OldSize != 0)
+    ub_tester::alloc_registry::registerAllocation(Pointer, OldSize);
+  return NewPointer;
+}
+
+UB_TESTER_ALLOCATION_HOOK void* memalign(size_t Alignment,
+                                         size_t Size) noexcept {
+  void* Pointer = __libc_memalign(Alignment, Size);
+  ub_tester::alloc_registry::registerAllocation(Pointer, Size);
+  return Pointer;
+}
+
+UB_TESTER_ALLOCATION_HOOK void* aligned_alloc(size_t Alignment,
+                                              size_t Size) noexcept {
+  return memalign(Alignment, Size);
+}
+
+UB_TESTER_ALLOCATION_HOOK int posix_memalign(void** Result, size_t Alignment,
+                                             size_t Size) noexcept {
+  if (Alignment % sizeof(void*) != 0 || (Alignment & (Alignment - 1)) != 0)
+    return EINVAL;
+  void* Pointer = memalign(Alignment, Size);
+  if (!Pointer)
+    return ENOMEM;
+  *Result = Pointer;
+  return 0;
+}
+
+UB_TESTER_ALLOCATION_HOOK void free(void* Pointer) noexcept {
+  ub_tester::alloc_registry::unregisterAllocation(Pointer);
+  __libc_free(Pointer);
+}
+}
+#endif
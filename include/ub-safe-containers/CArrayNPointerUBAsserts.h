@@ -1,22 +1,45 @@
 #pragma once
 
 #include "../assert-message-manager/AssertMessageManager.h"
+#include "../assert-message-manager/CheckEventLog.h"
+#include "../assert-message-manager/CheckToggles.h"
+#include "AllocationRegistry.h"
 #include "UBSafeCArray.h"
 #include "UBSafePointer.h"
 
 #include <climits>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <initializer_list>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
-#include <vector>
+#include <type_traits>
+#include <utility>
 
 #define ASSERT_IOB(Lhs, Rhs)                                                   \
   ub_tester::carr_ptr::checkers::checkIOB((Lhs), (Rhs), __FILE__, __LINE__)
 
-#define ASSERT_INVALID_SIZE(Sizes)                                             \
-  ub_tester::carr_ptr::checkers::checkInvalidSize((Sizes), __FILE__, __LINE__)
+// a[i][j]... of multi-dimensional array
+#define ASSERT_IOB_N(Array, ...)                                               \
+  ub_tester::carr_ptr::checkers::checkMultiIOB((Array), __FILE__, __LINE__,    \
+                                               __VA_ARGS__)
+
+// only sizes of VLAs are passed, constant ones are template arguments
+#define ASSERT_INVALID_SIZE(...)                                               \
+  ub_tester::carr_ptr::checkers::checkInvalidSize(__FILE__, __LINE__,          \
+                                                  __VA_ARGS__)
+
+// arrays with tracked elements are larger than C arrays by their init bits
+#define SIZEOF_CARRAY(Expr)                                                    \
+  sizeof(typename ub_tester::ub_safe_carray::OriginalCType<                    \
+         std::remove_cv_t<std::remove_reference_t<decltype(Expr)>>>::Type)
+
+// range-for whose loop variable is a copy or a const reference
+#define ASSERT_CARRAY_RANGE_READ(Array)                                        \
+  ub_tester::carr_ptr::checkers::checkRangeRead((Array), __FILE__, __LINE__)
 
 #define ASSERT_STAROPERATOR(Pointer)                                           \
   ub_tester::carr_ptr::checkers::checkStarOperator((Pointer), __FILE__, __LINE__)
@@ -25,6 +48,16 @@
   ub_tester::carr_ptr::checkers::checkMemberExpr((Pointer), __FILE__, __LINE__)  \
       ->Member
 
+// pointers kept raw by the tool, only null is detected
+#define ASSERT_RAW_STAROPERATOR(Pointer)                                       \
+  (*ub_tester::carr_ptr::checkers::checkRawPointer((Pointer), __FILE__,        \
+                                                   __LINE__))
+
+#define ASSERT_RAW_MEMBEREXPR(Pointer, Member)                                 \
+  ub_tester::carr_ptr::checkers::checkRawPointer((Pointer), __FILE__,          \
+                                                 __LINE__)                     \
+      ->Member
+
 namespace ub_tester::carr_ptr::checkers {
 
 using namespace ub_safe_carray;
@@ -33,21 +66,42 @@ using namespace ub_safe_ptr;
 using assert_message_manager::AssertFailCode;
 using assert_message_manager::AssertMessage;
 using assert_message_manager::AssertMessageManager;
+namespace event_log = assert_message_manager::event_log;
+using assert_message_manager::toggles::CheckCategory;
+using assert_message_manager::toggles::isCheckEnabled;
 
 namespace {
 
 inline void generateAssertIOBMessage(const char* Filename, size_t Line,
                                      int Index, size_t Size) {
+  if (!isCheckEnabled(CheckCategory::IOB, Filename, static_cast<int>(Line)))
+    return;
   std::stringstream SStream;
   SStream << "Index out of "
              "bounds! "
           << " in file " << Filename << " on line " << Line << ".\n";
   SStream << "Requesting index " << Index << ", while size is " << Size << '\n';
-  PUSH_ERROR(INDEX_OUT_OF_BOUNDS_ERROR, SStream.str());
+  PUSH_ERROR(INDEX_OUT_OF_BOUNDS_ERROR, SStream.str(), Filename, Line);
+}
+
+inline void generateAssertRawPtrIOBMessage(const char* Filename, size_t Line,
+                                           int Index, intptr_t Offset,
+                                           size_t BlockSize) {
+  if (!isCheckEnabled(CheckCategory::IOB, Filename, static_cast<int>(Line)))
+    return;
+  std::stringstream SStream;
+  SStream << "Index out of "
+             "bounds! "
+          << " in file " << Filename << " on line " << Line << ".\n";
+  SStream << "Requesting index " << Index << " of pointer " << Offset
+          << " bytes into heap block of " << BlockSize << " bytes\n";
+  PUSH_ERROR(INDEX_OUT_OF_BOUNDS_ERROR, SStream.str(), Filename, Line);
 }
 
 inline void generateAssertInvalidSizeMessage(const char* Filename, size_t Line,
-                                             int InvalidDim) {
+                                             long long InvalidDim) {
+  if (!isCheckEnabled(CheckCategory::IOB, Filename, static_cast<int>(Line)))
+    return;
   std::stringstream SStream;
   SStream << "Invalid size "
              "of an array! "
@@ -55,30 +109,95 @@ inline void generateAssertInvalidSizeMessage(const char* Filename, size_t Line,
   SStream << "Trying to create "
              "an array of size "
           << InvalidDim << '\n';
-  PUSH_ERROR(INVALID_SIZE_OF_ARRAY_ERROR, SStream.str());
+  PUSH_ERROR(INVALID_SIZE_OF_ARRAY_ERROR, SStream.str(), Filename, Line);
 }
 
 inline void generateAssertNullptrDeref(const char* Filename, size_t Line) {
+  if (!isCheckEnabled(CheckCategory::Pointer, Filename, static_cast<int>(Line)))
+    return;
   std::stringstream SStream;
   SStream << "Nullptr derefing "
           << " in file " << Filename << " on line " << Line << ".\n";
-  PUSH_ERROR(NULLPTR_DEREF_ERROR, SStream.str());
+  PUSH_ERROR(NULLPTR_DEREF_ERROR, SStream.str(), Filename, Line);
 }
 
 inline void generateAssertUninitDeref(const char* Filename, size_t Line) {
+  if (!isCheckEnabled(CheckCategory::Pointer, Filename, static_cast<int>(Line)))
+    return;
   std::stringstream SStream;
   SStream << "Uninit pointer derefing "
           << " in file " << Filename << " on line " << Line << ".\n";
-  PUSH_ERROR(UNINIT_PTR_DEREF_ERROR, SStream.str());
+  PUSH_ERROR(UNINIT_PTR_DEREF_ERROR, SStream.str(), Filename, Line);
 }
 
 inline void generateUntrackedPtrMessage(const char* Filename, size_t Line) {
+  if (!isCheckEnabled(CheckCategory::Pointer, Filename, static_cast<int>(Line)))
+    return;
+  constexpr auto Kind = event_log::EventKind::UntrackedPtr;
+  if (assert_message_manager::checkIfMessageIsSuppressed(
+          AssertFailCode::UNTRACKED_PTR_WARNING) ||
+      event_log::logEvent(Kind, 0, Filename, static_cast<int>(Line), {}) ||
+      AssertMessageManager::isRepeatedWarning(Filename, static_cast<int>(Line),
+                                              static_cast<int>(Kind) << 8))
+    return;
   std::stringstream SStream;
   SStream << "Untracked pointer "
           << " in file " << Filename << " on line " << Line << ".\n";
   PUSH_WARNING(UNTRACKED_PTR_WARNING, SStream.str());
 }
 
+inline void generateUninitRangeReadMessage(const char* Filename, size_t Line,
+                                           size_t Size, size_t InitSize) {
+  if (!isCheckEnabled(CheckCategory::Uninit, Filename, static_cast<int>(Line)))
+    return;
+  std::stringstream SStream;
+  SStream << "Iterating over " << Size
+          << " elements of array, while only first " << InitSize
+          << " elements are initialized";
+  PUSH_ERROR(UNINIT_VAR_ACCESS_ERROR,
+             uninit_vars::appendInfo(SStream.str(), Filename,
+                                     static_cast<int>(Line)),
+             Filename, Line);
+}
+
+// sizeof(T) is ill-formed for functions and incomplete types
+template <typename T, typename = void>
+struct HasElementSize : std::false_type {};
+
+template <typename T>
+struct HasElementSize<T, std::enable_if_t<(sizeof(T) > 0)>>
+    : std::true_type {};
+
+/* Raw pointer into registered heap block is checked against its bounds:
+ * element Index (possibly negative) from Pointer must lie within the block.
+ * Pointer itself may lie past the end of the block, in its last granule.
+ * Function pointers and pointers to incomplete types have no element size
+ * and are left untracked. */
+template <typename T>
+void checkRawPointerAccess(T* Pointer, int Index, const char* Filename,
+                           size_t Line) {
+  if constexpr (!HasElementSize<T>::value) {
+    (void)Pointer, (void)Index;
+    generateUntrackedPtrMessage(Filename, Line);
+  } else {
+    const alloc_registry::Allocation* Alloc =
+        alloc_registry::findAllocation(Pointer);
+    if (!Alloc) {
+      generateUntrackedPtrMessage(Filename, Line);
+      return;
+    }
+    intptr_t Offset = static_cast<intptr_t>(
+        reinterpret_cast<uintptr_t>(Pointer) - Alloc->Begin);
+    intptr_t ElementOffset =
+        Offset +
+        static_cast<intptr_t>(Index) * static_cast<intptr_t>(sizeof(T));
+    if (ElementOffset < 0 ||
+        static_cast<size_t>(ElementOffset) + sizeof(T) > Alloc->Size)
+      generateAssertRawPtrIOBMessage(Filename, Line, Index, Offset,
+                                     Alloc->Size);
+  }
+}
+
 template <typename T>
 void handlePointer(const UBSafePointer<T>& Pointer, const char* Filename,
                    size_t Line) {
@@ -96,22 +215,49 @@ void handlePointer(const UBSafePointer<T>& Pointer, const char* Filename,
 
 } // namespace
 
+/* Elements are only read, so array is iterated by its const begin() and its
+ * init bits are checked at once, instead of being marked initialized as they
+ * are by mutable iteration. */
+template <typename Array>
+const Array& checkRangeRead(const Array& Range, const char*, size_t) {
+  return Range;
+}
+
 template <typename T, size_t N>
-T& checkIOB(UBSafeCArray<T, N>& SafeArray, int Index, const char* Filename,
-            size_t Line) {
+const UBSafeCArray<uninit_vars::UBSafeType<T>, N>&
+checkRangeRead(const UBSafeCArray<uninit_vars::UBSafeType<T>, N>& Array,
+               const char* Filename, size_t Line) {
+  size_t InitSize = Array.getInitPrefix(Array.getSize());
+  if (UB_TESTER_UNLIKELY(InitSize != Array.getSize()))
+    generateUninitRangeReadMessage(Filename, Line, Array.getSize(), InitSize);
+  return Array;
+}
+
+// rows of multi-dimensional arrays can be returned by value
+template <typename T, size_t N>
+decltype(auto) checkIOB(UBSafeCArray<T, N>& SafeArray, int Index,
+                        const char* Filename, size_t Line) {
   if (Index < 0 || Index >= SafeArray.getSize())
     generateAssertIOBMessage(Filename, Line, Index, SafeArray.getSize());
   return SafeArray[Index];
 }
 
 template <typename T, size_t N>
-const T& checkIOB(const UBSafeCArray<T, N>& SafeArray, int Index,
-                  const char* Filename, size_t Line) {
-  if (Index < 0 || Index >= SafeArray.size())
-    generateAssertIOBMessage(Filename, Line, Index, SafeArray.size());
+decltype(auto) checkIOB(const UBSafeCArray<T, N>& SafeArray, int Index,
+                        const char* Filename, size_t Line) {
+  if (Index < 0 || Index >= SafeArray.getSize())
+    generateAssertIOBMessage(Filename, Line, Index, SafeArray.getSize());
   return SafeArray[Index];
 }
 
+template <typename Array, bool IsConst>
+decltype(auto) checkIOB(UBSafeCArrayRow<Array, IsConst> Row, int Index,
+                        const char* Filename, size_t Line) {
+  if (Index < 0 || Index >= Row.getSize())
+    generateAssertIOBMessage(Filename, Line, Index, Row.getSize());
+  return Row[Index];
+}
+
 template <typename T, size_t N>
 T& checkIOB(T (&Array)[N], int Index, const char* Filename, size_t Line) {
   if (Index < 0 || Index >= N)
@@ -138,14 +284,17 @@ const T& checkIOB(int Index, const T (&Array)[N], const char* Filename,
   return checkIOB<T, N>(Array, Index, Filename, Line);
 }
 
-inline std::vector<size_t> checkInvalidSize(const std::vector<int>& Sizes,
-                                            const char* Filename, size_t Line) {
-  std::vector<size_t> Res;
-  for (const auto& Size : Sizes)
+template <typename... SizeTypes>
+CArraySizes checkInvalidSize(const char* Filename, size_t Line,
+                             SizeTypes... Sizes) {
+  static_assert(sizeof...(Sizes) <= CArraySizes::MaxRank,
+                "too many dimensions of array");
+  CArraySizes Res{{}, 0};
+  for (long long Size : {static_cast<long long>(Sizes)...})
     if (Size < 0)
       generateAssertInvalidSizeMessage(Filename, Line, Size);
     else
-      Res.emplace_back(Size);
+      Res.Sizes[Res.Rank++] = Size;
   return Res;
 }
 
@@ -167,14 +316,14 @@ const T& checkStarOperator(const UBSafePointer<T>& Pointer,
 
 template <typename T>
 T& checkStarOperator(T*& Pointer, const char* Filename, size_t Line) {
-  generateUntrackedPtrMessage(Filename, Line);
+  checkRawPointerAccess(Pointer, 0, Filename, Line);
   return *Pointer;
 }
 
 template <typename T>
 const T& checkStarOperator(const T*& Pointer, const char* Filename,
                            size_t Line) {
-  generateUntrackedPtrMessage(Filename, Line);
+  checkRawPointerAccess(Pointer, 0, Filename, Line);
   return *Pointer;
 }
 
@@ -194,14 +343,21 @@ const UBSafePointer<T>& checkMemberExpr(const UBSafePointer<T>& Pointer,
 
 template <typename T>
 T*& checkMemberExpr(T*& Pointer, const char* Filename, size_t Line) {
-  generateUntrackedPtrMessage(Filename, Line);
+  checkRawPointerAccess(Pointer, 0, Filename, Line);
   return Pointer;
 }
 
 template <typename T>
 const T*& checkMemberExpr(const T*& Pointer, const char* Filename,
                           size_t Line) {
-  generateUntrackedPtrMessage(Filename, Line);
+  checkRawPointerAccess(Pointer, 0, Filename, Line);
+  return Pointer;
+}
+
+template <typename T>
+T* checkRawPointer(T* Pointer, const char* Filename, size_t Line) {
+  if (Pointer == nullptr)
+    generateAssertNullptrDeref(Filename, Line);
   return Pointer;
 }
 
@@ -226,28 +382,106 @@ const T& checkIOB(const UBSafePointer<T>& Pointer, int Index,
 
 template <typename T>
 T& checkIOB(T*& Array, int Index, const char* Filename, size_t Line) {
-  generateUntrackedPtrMessage(Filename, Line);
+  checkRawPointerAccess(Array, Index, Filename, Line);
   return Array[Index];
 }
 
 template <typename T>
 const T& checkIOB(const T*& Array, int Index, const char* Filename,
                   size_t Line) {
-  generateUntrackedPtrMessage(Filename, Line);
+  checkRawPointerAccess(Array, Index, Filename, Line);
   return Array[Index];
 }
 
 template <typename T>
 T& checkIOB(int Index, T*& Array, const char* Filename, size_t Line) {
-  generateUntrackedPtrMessage(Filename, Line);
   return checkIOB(Array, Index, Filename, Line);
 }
 
 template <typename T>
 const T& checkIOB(int Index, const T*& Array, const char* Filename,
                   size_t Line) {
-  generateUntrackedPtrMessage(Filename, Line);
   return checkIOB(Array, Index, Filename, Line);
 }
 
+namespace {
+
+template <size_t Dim, typename Array>
+size_t getDimSize(const Array& SafeArray) {
+  if constexpr (std::is_array_v<Array>)
+    return std::extent_v<Array, Dim>;
+  else
+    return SafeArray.getSize(Dim);
+}
+
+template <typename Array>
+Array subscriptUnchecked(Array&& SafeArray) {
+  return std::forward<Array>(SafeArray);
+}
+
+template <typename Array, typename... IndexTypes>
+decltype(auto) subscriptUnchecked(Array&& SafeArray, int Index,
+                                  IndexTypes... Indices) {
+  return subscriptUnchecked(std::forward<Array>(SafeArray)[Index], Indices...);
+}
+
+template <typename Array, size_t... Dims, typename... IndexTypes>
+bool isAnyIndexOutOfBounds(const Array& SafeArray, std::index_sequence<Dims...>,
+                           IndexTypes... Indices) {
+  // negative index becomes huge size_t, bitwise or keeps it a single branch
+  return ((static_cast<size_t>(static_cast<int>(Indices)) >=
+           getDimSize<Dims>(SafeArray)) |
+          ...);
+}
+
+template <typename Array, size_t... Dims, typename... IndexTypes>
+UB_TESTER_COLD void reportMultiIOB(const Array& SafeArray, const char* Filename,
+                                   size_t Line, std::index_sequence<Dims...>,
+                                   IndexTypes... Indices) {
+  int IndexArr[] = {static_cast<int>(Indices)...};
+  size_t SizeArr[] = {getDimSize<Dims>(SafeArray)...};
+  for (size_t Dim = 0; Dim < sizeof...(Dims); ++Dim)
+    if (IndexArr[Dim] < 0 ||
+        static_cast<size_t>(IndexArr[Dim]) >= SizeArr[Dim]) {
+      generateAssertIOBMessage(Filename, Line, IndexArr[Dim], SizeArr[Dim]);
+      return;
+    }
+}
+
+} // namespace
+
+/* Subscripts of multi-dimensional array are fused by the tool: all indices
+ * are validated against sizes of dimensions before the element is accessed,
+ * so inner rows are not checked and materialized one by one. Explicit inline
+ * lets GCC expand the check at -O2 also in large functions. */
+template <typename Array, typename... IndexTypes>
+inline decltype(auto) checkMultiIOB(Array& SafeArray, const char* Filename,
+                                    size_t Line, IndexTypes... Indices) {
+  auto Dims = std::index_sequence_for<IndexTypes...>{};
+  if (UB_TESTER_UNLIKELY(isAnyIndexOutOfBounds(SafeArray, Dims, Indices...)))
+    reportMultiIOB(SafeArray, Filename, Line, Dims, Indices...);
+  return subscriptUnchecked(SafeArray, static_cast<int>(Indices)...);
+}
+
+template <typename T>
+struct IsTrackedArray
+    : std::bool_constant<std::is_array_v<T> || std::is_pointer_v<T>> {};
+template <typename T, size_t N>
+struct IsTrackedArray<UBSafeCArray<T, N>> : std::true_type {};
+template <typename T>
+struct IsTrackedArray<UBSafePointer<T>> : std::true_type {};
+template <typename Array, bool IsConst>
+struct IsTrackedArray<UBSafeCArrayRow<Array, IsConst>> : std::true_type {};
+
+// template patterns are instrumented once, so subscript of other types
+// (e.g. std::vector in some instantiation) is left unchecked
+template <typename Container, typename IndexType,
+          typename = std::enable_if_t<
+              !IsTrackedArray<std::decay_t<Container>>::value &&
+              !IsTrackedArray<std::decay_t<IndexType>>::value>>
+decltype(auto) checkIOB(Container&& Array, IndexType&& Index, const char*,
+                        size_t) {
+  return std::forward<Container>(Array)[std::forward<IndexType>(Index)];
+}
+
 } // namespace ub_tester::carr_ptr::checkers
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "CArrayNPointerUBAsserts.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define UB_TESTER_CHECKED_READ
+#endif
+
+/* Calls of memcpy, memset, memmove, strcpy, strlen, read and fwrite whose
+ * buffers are safe arrays or safe pointers are replaced by the tool. Range of
+ * every buffer is validated once against its size, and the libc function is
+ * called on raw storage, so elements are neither checked one by one nor
+ * copied through wrappers. Read ranges of tracked arrays must be initialized
+ * and written ones are marked initialized at once. Raw pointers are validated
+ * only if they point into registered heap block. */
+
+#define ASSERT_MEMCPY(...)                                                     \
+  ub_tester::carr_ptr::checkers::checkMemcpy(__FILE__, __LINE__, __VA_ARGS__)
+#define ASSERT_MEMMOVE(...)                                                    \
+  ub_tester::carr_ptr::checkers::checkMemmove(__FILE__, __LINE__, __VA_ARGS__)
+#define ASSERT_MEMSET(...)                                                     \
+  ub_tester::carr_ptr::checkers::checkMemset(__FILE__, __LINE__, __VA_ARGS__)
+#define ASSERT_STRCPY(...)                                                     \
+  ub_tester::carr_ptr::checkers::checkStrcpy(__FILE__, __LINE__, __VA_ARGS__)
+#define ASSERT_STRLEN(...)                                                     \
+  ub_tester::carr_ptr::checkers::checkStrlen(__FILE__, __LINE__, __VA_ARGS__)
+#define ASSERT_READ(...)                                                       \
+  ub_tester::carr_ptr::checkers::checkRead(__FILE__, __LINE__, __VA_ARGS__)
+#define ASSERT_FWRITE(...)                                                     \
+  ub_tester::carr_ptr::checkers::checkFwrite(__FILE__, __LINE__, __VA_ARGS__)
+
+namespace ub_tester::carr_ptr::checkers {
+
+namespace {
+
+constexpr size_t UnknownBufferSize = SIZE_MAX;
+
+inline void generateAssertBufferOverflowMessage(const char* Filename,
+                                                size_t Line, size_t Bytes,
+                                                size_t Size) {
+  if (!isCheckEnabled(CheckCategory::IOB, Filename, static_cast<int>(Line)))
+    return;
+  std::stringstream SStream;
+  SStream << "Buffer overflow! "
+          << " in file " << Filename << " on line " << Line << ".\n";
+  SStream << "Accessing " << Bytes << " bytes, while size is " << Size
+          << " bytes\n";
+  PUSH_ERROR(INDEX_OUT_OF_BOUNDS_ERROR, SStream.str(), Filename, Line);
+}
+
+inline void generateUninitBufferReadMessage(const char* Filename, size_t Line,
+                                            size_t Bytes, size_t InitBytes) {
+  if (!isCheckEnabled(CheckCategory::Uninit, Filename, static_cast<int>(Line)))
+    return;
+  std::stringstream SStream;
+  SStream << "Reading " << Bytes << " bytes of buffer, while only first "
+          << InitBytes << " bytes are initialized";
+  PUSH_ERROR(UNINIT_VAR_ACCESS_ERROR,
+             uninit_vars::appendInfo(SStream.str(), Filename,
+                                     static_cast<int>(Line)),
+             Filename, Line);
+}
+
+// sizes of buffers in bytes
+
+template <typename T, size_t N>
+size_t getBufferSize(const UBSafeCArray<T, N>& Array) {
+  return Array.getSize() * sizeof(*Array.data());
+}
+
+template <typename T>
+size_t getBufferSize(const UBSafePointer<T>& Pointer) {
+  if constexpr (std::is_void_v<T>)
+    return Pointer.getSize();
+  else
+    return Pointer.getSize() * sizeof(T);
+}
+
+template <typename T>
+size_t getBufferSize(T* Pointer) {
+  const alloc_registry::Allocation* Alloc =
+      alloc_registry::findAllocation(Pointer);
+  if (!Alloc)
+    return UnknownBufferSize;
+  // pointer past the end of block may still map to its last granule
+  uintptr_t End = Alloc->Begin + Alloc->Size;
+  auto Address = reinterpret_cast<uintptr_t>(Pointer);
+  return Address < End ? End - Address : 0;
+}
+
+// raw storage, elements are not marked initialized
+
+template <typename T, size_t N>
+auto* getBufferData(UBSafeCArray<T, N>& Array) {
+  return Array.data();
+}
+
+template <typename T, size_t N>
+T* getBufferData(UBSafeCArray<uninit_vars::UBSafeType<T>, N>& Array) {
+  return Array.getWriteRange(0, 0);
+}
+
+template <typename T, size_t N>
+auto* getBufferData(const UBSafeCArray<T, N>& Array) {
+  return Array.data();
+}
+
+template <typename T>
+T* getBufferData(const UBSafePointer<T>& Pointer) {
+  return Pointer.data();
+}
+
+template <typename T>
+T* getBufferData(T* Pointer) {
+  return Pointer;
+}
+
+template <typename Buffer>
+void markBufferWritten(const Buffer&, size_t) {}
+
+// element written partially is considered initialized
+template <typename T, size_t N>
+void markBufferWritten(UBSafeCArray<uninit_vars::UBSafeType<T>, N>& Array,
+                       size_t Bytes) {
+  size_t End = (Bytes + sizeof(T) - 1) / sizeof(T);
+  Array.getWriteRange(0, End < Array.getSize() ? End : Array.getSize());
+}
+
+// bytes from the beginning of buffer up to its first uninitialized element
+template <typename Buffer>
+size_t getInitBufferSize(const Buffer&, size_t Bytes) {
+  return Bytes;
+}
+
+template <typename T, size_t N>
+size_t
+getInitBufferSize(const UBSafeCArray<uninit_vars::UBSafeType<T>, N>& Array,
+                  size_t Bytes) {
+  size_t End = (Bytes + sizeof(T) - 1) / sizeof(T);
+  size_t InitBytes =
+      Array.getInitPrefix(End < Array.getSize() ? End : Array.getSize()) *
+      sizeof(T);
+  return InitBytes < Bytes ? InitBytes : Bytes;
+}
+
+template <typename Buffer>
+void checkBufferState(const Buffer&, const char*, size_t) {}
+
+template <typename T>
+void checkBufferState(const UBSafePointer<T>& Pointer, const char* Filename,
+                      size_t Line) {
+  handlePointer(Pointer, Filename, Line);
+}
+
+// Bytes from the beginning of buffer are accessed
+template <typename Buffer>
+void checkBufferAccess(const Buffer& Buf, size_t Bytes, const char* Filename,
+                       size_t Line) {
+  checkBufferState(Buf, Filename, Line);
+  size_t Size = getBufferSize(Buf);
+  if (UB_TESTER_UNLIKELY(Size != UnknownBufferSize && Bytes > Size))
+    generateAssertBufferOverflowMessage(Filename, Line, Bytes, Size);
+}
+
+// source is read, so its init state is not laundered into destination
+template <typename Buffer>
+void checkBufferRead(const Buffer& Buf, size_t Bytes, const char* Filename,
+                     size_t Line) {
+  checkBufferAccess(Buf, Bytes, Filename, Line);
+  size_t InitBytes = getInitBufferSize(Buf, Bytes);
+  if (UB_TESTER_UNLIKELY(InitBytes < Bytes))
+    generateUninitBufferReadMessage(Filename, Line, Bytes, InitBytes);
+}
+
+/* Terminating null must lie within buffer, so the string is not read past it,
+ * and within initialized elements of tracked arrays. */
+template <typename Buffer>
+size_t checkStringLength(const Buffer& Buf, const char* Filename,
+                         size_t Line) {
+  checkBufferState(Buf, Filename, Line);
+  const auto* String = static_cast<const char*>(
+      static_cast<const void*>(getBufferData(Buf)));
+  size_t Size = getBufferSize(Buf);
+  if (Size == UnknownBufferSize)
+    return std::strlen(String);
+  size_t InitSize = getInitBufferSize(Buf, Size);
+  const void* End = std::memchr(String, '\0', InitSize);
+  if (UB_TESTER_UNLIKELY(!End)) {
+    if (InitSize < Size)
+      generateUninitBufferReadMessage(Filename, Line, InitSize + 1, InitSize);
+    else
+      generateAssertBufferOverflowMessage(Filename, Line, Size + 1, Size);
+    return std::strlen(String);
+  }
+  return static_cast<const char*>(End) - String;
+}
+
+} // namespace
+
+template <typename Dst, typename Src>
+void* checkMemcpy(const char* Filename, size_t Line, Dst&& Destination,
+                  Src&& Source, size_t Count) {
+  checkBufferAccess(Destination, Count, Filename, Line);
+  checkBufferRead(Source, Count, Filename, Line);
+  markBufferWritten(Destination, Count);
+  return std::memcpy(getBufferData(Destination), getBufferData(Source), Count);
+}
+
+template <typename Dst, typename Src>
+void* checkMemmove(const char* Filename, size_t Line, Dst&& Destination,
+                   Src&& Source, size_t Count) {
+  checkBufferAccess(Destination, Count, Filename, Line);
+  checkBufferRead(Source, Count, Filename, Line);
+  markBufferWritten(Destination, Count);
+  return std::memmove(getBufferData(Destination), getBufferData(Source),
+                      Count);
+}
+
+template <typename Dst>
+void* checkMemset(const char* Filename, size_t Line, Dst&& Destination,
+                  int Value, size_t Count) {
+  checkBufferAccess(Destination, Count, Filename, Line);
+  markBufferWritten(Destination, Count);
+  return std::memset(getBufferData(Destination), Value, Count);
+}
+
+template <typename Dst, typename Src>
+char* checkStrcpy(const char* Filename, size_t Line, Dst&& Destination,
+                  Src&& Source) {
+  size_t Count = checkStringLength(Source, Filename, Line) + 1;
+  checkBufferAccess(Destination, Count, Filename, Line);
+  markBufferWritten(Destination, Count);
+  return std::strcpy(getBufferData(Destination), getBufferData(Source));
+}
+
+template <typename Src>
+size_t checkStrlen(const char* Filename, size_t Line, Src&& Source) {
+  return checkStringLength(Source, Filename, Line);
+}
+
+#ifdef UB_TESTER_CHECKED_READ
+// only bytes actually read are marked
+template <typename Dst>
+ssize_t checkRead(const char* Filename, size_t Line, int Fd,
+                  Dst&& Destination, size_t Count) {
+  checkBufferAccess(Destination, Count, Filename, Line);
+  ssize_t Read = ::read(Fd, getBufferData(Destination), Count);
+  if (Read > 0)
+    markBufferWritten(Destination, static_cast<size_t>(Read));
+  return Read;
+}
+#endif
+
+template <typename Src>
+size_t checkFwrite(const char* Filename, size_t Line, Src&& Source,
+                   size_t Size, size_t Count, std::FILE* Stream) {
+  checkBufferRead(Source, Size * Count, Filename, Line);
+  return std::fwrite(getBufferData(Source), Size, Count, Stream);
+}
+
+} // namespace ub_tester::carr_ptr::checkers
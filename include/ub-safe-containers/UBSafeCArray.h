@@ -1,52 +1,219 @@
 #pragma once
 
+#include "../uninit-variables/InitBitmap.h"
+#include <array>
 #include <cstddef>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ub_tester::ub_safe_carray {
 
+/* Elements are default-initialized, as in C, so large arrays are not filled
+ * with zeros on every declaration: values of elements which were never
+ * written are indeterminate, and their reads are reported by init bits of
+ * tracked elements. Elements past initializer of aggregate are
+ * value-initialized by constructors. Storage of static arrays is still
+ * zero-initialized, and so is storage of arrays value-initialized as members
+ * (e.g. by S X{}), since default constructors are not user-provided. */
+template <typename T>
+struct DefaultInitAllocator : std::allocator<T> {
+  template <typename U>
+  struct rebind {
+    using other = DefaultInitAllocator<U>;
+  };
+
+  DefaultInitAllocator() = default;
+  template <typename U>
+  DefaultInitAllocator(const DefaultInitAllocator<U>&) {}
+
+  template <typename U>
+  void construct(U* Pointer) {
+    ::new (static_cast<void*>(Pointer)) U;
+  }
+  template <typename U, typename... ArgTypes>
+  void construct(U* Pointer, ArgTypes&&... Args) {
+    ::new (static_cast<void*>(Pointer)) U(std::forward<ArgTypes>(Args)...);
+  }
+};
+
+/* Arrays of constant size keep their elements inline, so they have the same
+ * size and layout as C arrays and are not allocated. Only VLAs and arrays of
+ * unknown bound (N == 0) are sized at runtime. Index is checked by checkIOB,
+ * so operator[] does not check it again. */
+template <typename T, size_t N>
+using CArrayStorage =
+    std::conditional_t<N != 0, T[N != 0 ? N : 1],
+                       std::vector<T, DefaultInitAllocator<T>>>;
+
+/* Sizes of dimensions of VLA, checked by ASSERT_INVALID_SIZE. Arrays of
+ * constant size are constructed without them. */
+struct CArraySizes final {
+  static constexpr size_t MaxRank = 8;
+  size_t size() const { return Rank; }
+  size_t operator[](size_t Dim) const { return Sizes[Dim]; }
+  size_t Sizes[MaxRank];
+  size_t Rank;
+};
+
 template <typename T, size_t N = 0>
+class UBSafeCArray;
+
+template <typename T>
+struct CArrayTraits {
+  using ElementType = T;
+  static constexpr bool IsArray = false;
+  static constexpr bool IsInline = true;
+  static constexpr size_t Rank = 0;
+  static constexpr size_t getSize(size_t) { return 0; }
+};
+
+template <typename T, size_t N>
+struct CArrayTraits<UBSafeCArray<T, N>> {
+  using ElementType = typename CArrayTraits<T>::ElementType;
+  static constexpr bool IsArray = true;
+  static constexpr bool IsInline = N != 0 && CArrayTraits<T>::IsInline;
+  static constexpr size_t Rank = CArrayTraits<T>::Rank + 1;
+  // size of dimension of inline array
+  static constexpr size_t getSize(size_t Dim) {
+    return Dim == 0 ? N : CArrayTraits<T>::getSize(Dim - 1);
+  }
+};
+
+template <typename T, size_t N>
 class UBSafeCArray {
 public:
-  explicit UBSafeCArray();
-  UBSafeCArray(const std::initializer_list<T>&);
-  UBSafeCArray(const std::vector<size_t>& Sizes);
-  UBSafeCArray(const std::vector<size_t> Sizes,
-               const std::initializer_list<T>&);
+  // empty list value-initializes all elements
+  using InitListType = std::initializer_list<T>;
+
+  UBSafeCArray() = default;
+  UBSafeCArray(const InitListType&);
+  UBSafeCArray(const CArraySizes& Sizes);
+  UBSafeCArray(const CArraySizes& Sizes, const InitListType&);
 
   void setSize(size_t Size);
-  void setSize(const std::vector<size_t>& Sizes, int CurDepth = 0);
+  void setSize(const CArraySizes& Sizes, int CurDepth = 0);
 
   size_t getSize() const;
 
   T& operator[](int index);
   const T& operator[](int index) const;
 
+  /* Iterators are raw pointers to contiguous elements, so range-for and
+   * standard algorithms stay within storage without per-element checks. */
+  T* data();
+  const T* data() const;
+  size_t size() const;
+  T* begin();
+  const T* begin() const;
+  T* end();
+  const T* end() const;
+
 private:
-  std::vector<T> Data_;
+  CArrayStorage<T, N> Data_;
+};
+
+/* Rows of constant size are stored inline, so multi-dimensional array is
+ * contiguous unless some of inner dimensions is runtime-sized. Elements of
+ * such array are kept in one block with strides of each dimension instead,
+ * and indexing returns row views referring to this block. */
+template <typename Row>
+struct FlatCArrayStorage {
+  static constexpr size_t Rank = CArrayTraits<Row>::Rank + 1;
+  CArrayStorage<typename CArrayTraits<Row>::ElementType, 0> Elements;
+  std::array<size_t, Rank> Sizes{};   // of all dimensions
+  std::array<size_t, Rank> Strides{}; // numbers of elements in their rows
+};
+
+// Array is the declared type of row
+template <typename Array, bool IsConst = false>
+class UBSafeCArrayRow;
+
+template <typename T, size_t N, bool IsConst>
+class UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst> {
+public:
+  using ElementType =
+      std::conditional_t<IsConst, const typename CArrayTraits<T>::ElementType,
+                         typename CArrayTraits<T>::ElementType>;
+  using Reference = std::conditional_t<CArrayTraits<T>::IsArray,
+                                       UBSafeCArrayRow<T, IsConst>,
+                                       ElementType&>;
+
+  UBSafeCArrayRow(ElementType* Data, const size_t* Sizes,
+                  const size_t* Strides);
+
+  size_t getSize() const;
+  size_t getSize(size_t Dim) const;
+
+  Reference operator[](int index) const;
+
+  ElementType* data() const;
+  size_t size() const;
+  // only rows of elements can be iterated
+  ElementType* begin() const;
+  ElementType* end() const;
+
+private:
+  ElementType* Data_;
+  const size_t* Sizes_;   // of this and inner dimensions
+  const size_t* Strides_; // of this and inner dimensions
 };
 
 // Multi-dimensional specialization
 
 template <typename T, size_t N, size_t M>
 class UBSafeCArray<UBSafeCArray<T, N>, M> {
+  static constexpr bool IsFlat = !CArrayTraits<UBSafeCArray<T, N>>::IsInline;
+  static constexpr size_t Rank = CArrayTraits<UBSafeCArray>::Rank;
+
 public:
-  explicit UBSafeCArray();
-  UBSafeCArray(const std::initializer_list<UBSafeCArray<T, N>>&);
-  UBSafeCArray(const std::vector<size_t>& Sizes);
-  UBSafeCArray(const std::vector<size_t> Sizes,
-               const std::initializer_list<UBSafeCArray<T, N>>&);
+  using Reference =
+      std::conditional_t<IsFlat, UBSafeCArrayRow<UBSafeCArray<T, N>>,
+                         UBSafeCArray<T, N>&>;
+  using ConstReference =
+      std::conditional_t<IsFlat, UBSafeCArrayRow<UBSafeCArray<T, N>, true>,
+                         const UBSafeCArray<T, N>&>;
+  // flat array has no rows in memory, its data is the block of elements
+  using Pointer =
+      std::conditional_t<IsFlat, typename CArrayTraits<T>::ElementType*,
+                         UBSafeCArray<T, N>*>;
+  using ConstPointer =
+      std::conditional_t<IsFlat, const typename CArrayTraits<T>::ElementType*,
+                         const UBSafeCArray<T, N>*>;
+
+  using InitListType = std::initializer_list<UBSafeCArray<T, N>>;
+
+  UBSafeCArray() = default;
+  UBSafeCArray(const InitListType&);
+  UBSafeCArray(const CArraySizes& Sizes);
+  UBSafeCArray(const CArraySizes& Sizes, const InitListType&);
 
   void setSize(size_t Size);
-  void setSize(const std::vector<size_t>& Sizes, int CurDepth = 0);
+  void setSize(const CArraySizes& Sizes, int CurDepth = 0);
   size_t getSize() const;
+  // sizes of inner dimensions are equal for all rows
+  size_t getSize(size_t Dim) const;
 
-  UBSafeCArray<T, N>& operator[](int index);
-  const UBSafeCArray<T, N>& operator[](int index) const;
+  Reference operator[](int index);
+  ConstReference operator[](int index) const;
+
+  Pointer data();
+  ConstPointer data() const;
+  size_t size() const;
+  // only arrays of inline rows can be iterated
+  Pointer begin();
+  ConstPointer begin() const;
+  Pointer end();
+  ConstPointer end() const;
 
 private:
-  std::vector<UBSafeCArray<T, N>> Data_;
+  std::conditional_t<IsFlat, FlatCArrayStorage<UBSafeCArray<T, N>>,
+                     CArrayStorage<UBSafeCArray<T, N>, M>>
+      Data_;
 };
 
 // char specialization
@@ -54,23 +221,103 @@ private:
 template <size_t N>
 class UBSafeCArray<char, N> {
 public:
-  explicit UBSafeCArray();
+  using InitListType = std::initializer_list<char>;
+
+  UBSafeCArray() = default;
   UBSafeCArray(const char* StringLiteral);
-  UBSafeCArray(const std::initializer_list<char>&);
-  UBSafeCArray(const std::vector<size_t>& Sizes);
-  UBSafeCArray(const std::vector<size_t> Sizes,
-               const std::initializer_list<char>&);
-  UBSafeCArray(const std::vector<size_t> Sizes, const char* StringLiteral);
+  UBSafeCArray(const InitListType&);
+  UBSafeCArray(const CArraySizes& Sizes);
+  UBSafeCArray(const CArraySizes& Sizes, const InitListType&);
+  UBSafeCArray(const CArraySizes& Sizes, const char* StringLiteral);
 
   void setSize(size_t Size);
-  void setSize(const std::vector<size_t>& Sizes, int CurDepth = 0);
+  void setSize(const CArraySizes& Sizes, int CurDepth = 0);
   size_t getSize() const;
 
   char& operator[](int index);
   const char& operator[](int index) const;
 
+  char* data();
+  const char* data() const;
+  size_t size() const;
+  char* begin();
+  const char* begin() const;
+  char* end();
+  const char* end() const;
+
 private:
-  std::vector<char> Data_;
+  CArrayStorage<char, N> Data_;
+};
+
+/* Specialization for elements of fundamental types tracked by uninit checks:
+ * values are stored as in C array and init state in bitmap, see InitBitmap.h.
+ * Initializers of aggregates value-initialize the rest of elements, so all of
+ * them are initialized. Literal initializes arrays of characters. */
+
+template <typename T, size_t N>
+class UBSafeCArray<uninit_vars::UBSafeType<T>, N> {
+public:
+  using InitListType = std::initializer_list<T>;
+
+  UBSafeCArray() = default;
+  UBSafeCArray(const InitListType&);
+  UBSafeCArray(const T* StringLiteral);
+  UBSafeCArray(const CArraySizes& Sizes);
+  UBSafeCArray(const CArraySizes& Sizes, const InitListType&);
+  UBSafeCArray(const CArraySizes& Sizes, const T* StringLiteral);
+
+  void setSize(size_t Size);
+  void setSize(const CArraySizes& Sizes, int CurDepth = 0);
+  size_t getSize() const;
+
+  uninit_vars::UBSafeTypeRef<T> operator[](int index);
+  uninit_vars::UBSafeTypeRef<const T> operator[](int index) const;
+
+  /* Writes through raw pointers are not tracked, so all elements are marked
+   * initialized when mutable storage is taken. Range-for that only reads
+   * elements iterates const array instead, see checkRangeRead. */
+  T* data();
+  const T* data() const;
+  size_t size() const;
+  T* begin();
+  const T* begin() const;
+  T* end();
+  const T* end() const;
+
+  // storage for bulk write of elements [Begin, End), marked at once
+  T* getWriteRange(size_t Begin, size_t End);
+
+  // number of initialized elements before the first uninitialized one
+  size_t getInitPrefix(size_t End) const;
+
+private:
+  CArrayStorage<T, N> Data_;
+  uninit_vars::InitBitmap<N> InitBits_;
+};
+
+/* Type of C array replaced by safe array, sizeof of arrays with tracked
+ * elements and of their elements is computed from it. */
+template <typename T>
+struct OriginalCType {
+  using Type = T;
+};
+
+template <typename T>
+struct OriginalCType<uninit_vars::UBSafeType<T>> {
+  using Type = T;
+};
+
+template <typename T>
+struct OriginalCType<uninit_vars::UBSafeTypeRef<T>> {
+  using Type = T;
+};
+
+// storage of arrays sized at runtime is not inline
+template <typename T, size_t N>
+struct OriginalCType<UBSafeCArray<T, N>> {
+  using ElementType = typename OriginalCType<T>::Type;
+  using Type = std::conditional_t<N != 0, ElementType[N != 0 ? N : 1],
+                                  UBSafeCArray<T, N>>;
 };
 
 } // namespace ub_tester::ub_safe_carray
@@ -1,183 +1,546 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <string>
 
 namespace ub_tester::ub_safe_carray {
 
 template <typename T, size_t N>
-UBSafeCArray<T, N>::UBSafeCArray() {
-  Data_.resize(N);
-}
-
-template <typename T, size_t N>
-UBSafeCArray<T, N>::UBSafeCArray(const std::initializer_list<T>& InitList)
-    : Data_{InitList} {
-  if (N != 0)
-    setSize(N);
+UBSafeCArray<T, N>::UBSafeCArray(const InitListType& InitList) {
+  // the rest of elements is value-initialized
+  if constexpr (N != 0) {
+    size_t Count = std::min(InitList.size(), N);
+    std::copy_n(InitList.begin(), Count, Data_);
+    std::fill(Data_ + Count, Data_ + N, T{});
+  } else
+    Data_ = InitList;
 }
 
+// size of inline storage is fixed by type
 template <typename T, size_t N>
 void UBSafeCArray<T, N>::setSize(size_t Size) {
-  Data_.resize(Size);
+  if constexpr (N == 0)
+    Data_.resize(Size);
 }
 
 template <typename T, size_t N>
-void UBSafeCArray<T, N>::setSize(const std::vector<size_t>& Sizes,
-                                 int CurDepth) {
+void UBSafeCArray<T, N>::setSize(const CArraySizes& Sizes, int CurDepth) {
   setSize(Sizes[CurDepth]);
 }
 
 template <typename T, size_t N>
 size_t UBSafeCArray<T, N>::getSize() const {
-  return Data_.size();
+  if constexpr (N != 0)
+    return N;
+  else
+    return Data_.size();
 }
 
 template <typename T, size_t N>
-UBSafeCArray<T, N>::UBSafeCArray(const std::vector<size_t>& Sizes) {
+UBSafeCArray<T, N>::UBSafeCArray(const CArraySizes& Sizes) {
   setSize(Sizes);
 }
 
+// elements past initializer are value-initialized, resize does not do it
 template <typename T, size_t N>
-UBSafeCArray<T, N>::UBSafeCArray(std::vector<size_t> Sizes,
-                                 const std::initializer_list<T>& Args)
+UBSafeCArray<T, N>::UBSafeCArray(const CArraySizes& Sizes,
+                                 const InitListType& Args)
     : UBSafeCArray(Args) {
   setSize(Sizes);
+  std::fill(begin() + std::min(Args.size(), getSize()), end(), T{});
 }
 
 template <typename T, size_t N>
 const T& UBSafeCArray<T, N>::operator[](int Index) const {
-  return Data_.at(Index);
+  return Data_[Index];
 }
 
 template <typename T, size_t N>
 T& UBSafeCArray<T, N>::operator[](int Index) {
-  return Data_.at(Index);
+  return Data_[Index];
 }
 
-// Multi-dimensional specialization
+template <typename T, size_t N>
+T* UBSafeCArray<T, N>::data() {
+  return std::data(Data_);
+}
 
-template <typename T, size_t N, size_t M>
-UBSafeCArray<UBSafeCArray<T, N>, M>::UBSafeCArray() {
-  Data_.resize(M);
+template <typename T, size_t N>
+const T* UBSafeCArray<T, N>::data() const {
+  return std::data(Data_);
+}
+
+template <typename T, size_t N>
+size_t UBSafeCArray<T, N>::size() const {
+  return getSize();
+}
+
+template <typename T, size_t N>
+T* UBSafeCArray<T, N>::begin() {
+  return data();
+}
+
+template <typename T, size_t N>
+const T* UBSafeCArray<T, N>::begin() const {
+  return data();
+}
+
+template <typename T, size_t N>
+T* UBSafeCArray<T, N>::end() {
+  return data() + getSize();
+}
+
+template <typename T, size_t N>
+const T* UBSafeCArray<T, N>::end() const {
+  return data() + getSize();
+}
+
+// Row of flat multi-dimensional array
+
+template <typename T, size_t N, bool IsConst>
+UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::UBSafeCArrayRow(
+    ElementType* Data, const size_t* Sizes, const size_t* Strides)
+    : Data_{Data}, Sizes_{Sizes}, Strides_{Strides} {}
+
+template <typename T, size_t N, bool IsConst>
+size_t UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::getSize() const {
+  return Sizes_[0];
+}
+
+template <typename T, size_t N, bool IsConst>
+size_t UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::getSize(size_t Dim) const {
+  return Sizes_[Dim];
+}
+
+template <typename T, size_t N, bool IsConst>
+typename UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::Reference
+UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::operator[](int Index) const {
+  if constexpr (CArrayTraits<T>::IsArray)
+    return {Data_ + Index * Strides_[0], Sizes_ + 1, Strides_ + 1};
+  else
+    return Data_[Index];
+}
+
+template <typename T, size_t N, bool IsConst>
+typename UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::ElementType*
+UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::data() const {
+  return Data_;
+}
+
+template <typename T, size_t N, bool IsConst>
+size_t UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::size() const {
+  return Sizes_[0];
+}
+
+template <typename T, size_t N, bool IsConst>
+typename UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::ElementType*
+UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::begin() const {
+  static_assert(!CArrayTraits<T>::IsArray, "row of rows cannot be iterated");
+  return Data_;
+}
+
+template <typename T, size_t N, bool IsConst>
+typename UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::ElementType*
+UBSafeCArrayRow<UBSafeCArray<T, N>, IsConst>::end() const {
+  static_assert(!CArrayTraits<T>::IsArray, "row of rows cannot be iterated");
+  return Data_ + Sizes_[0];
 }
 
+// Multi-dimensional specialization
+
+// rows past initializer are constructed from empty lists, so all of their
+// elements are value-initialized
 template <typename T, size_t N, size_t M>
 UBSafeCArray<UBSafeCArray<T, N>, M>::UBSafeCArray(
-    const std::initializer_list<UBSafeCArray<T, N>>& InitList)
-    : Data_{InitList} {
-  if (M != 0)
-    setSize(M);
+    const InitListType& InitList) {
+  static_assert(!IsFlat, "variable-sized array cannot be initialized");
+  if constexpr (M != 0) {
+    size_t Count = std::min(InitList.size(), M);
+    std::copy_n(InitList.begin(), Count, Data_);
+    std::fill(Data_ + Count, Data_ + M,
+              UBSafeCArray<T, N>(
+                  typename UBSafeCArray<T, N>::InitListType{}));
+  } else
+    Data_ = InitList;
 }
 
+// rows of flat array are kept, only their number is changed
 template <typename T, size_t N, size_t M>
 void UBSafeCArray<UBSafeCArray<T, N>, M>::setSize(size_t Size) {
-  Data_.resize(Size);
+  if constexpr (IsFlat) {
+    Data_.Sizes[0] = Size;
+    Data_.Elements.resize(Size * Data_.Strides[0]);
+  } else if constexpr (M == 0)
+    Data_.resize(Size);
 }
 
+// inline rows need no sizes, flat array is allocated at once
 template <typename T, size_t N, size_t M>
 void UBSafeCArray<UBSafeCArray<T, N>, M>::setSize(
-    const std::vector<size_t>& Sizes, int CurDepth) {
-  setSize(Sizes[CurDepth]);
-  for (auto& Arr : Data_)
-    Arr.setSize(Sizes, CurDepth + 1);
+    const CArraySizes& Sizes, int CurDepth) {
+  if constexpr (IsFlat) {
+    for (size_t Dim = 0; Dim != Rank && CurDepth + Dim < Sizes.size(); ++Dim)
+      Data_.Sizes[Dim] = Sizes[CurDepth + Dim];
+    if constexpr (M != 0)
+      Data_.Sizes[0] = M;
+    Data_.Strides[Rank - 1] = 1;
+    for (size_t Dim = Rank - 1; Dim != 0; --Dim)
+      Data_.Strides[Dim - 1] = Data_.Strides[Dim] * Data_.Sizes[Dim];
+    Data_.Elements.clear();
+    Data_.Elements.resize(Data_.Sizes[0] * Data_.Strides[0]);
+  } else
+    setSize(Sizes[CurDepth]);
 }
 
 template <typename T, size_t N, size_t M>
 size_t UBSafeCArray<UBSafeCArray<T, N>, M>::getSize() const {
-  return Data_.size();
+  if constexpr (M != 0)
+    return M;
+  else if constexpr (IsFlat)
+    return Data_.Sizes[0];
+  else
+    return Data_.size();
 }
 
 template <typename T, size_t N, size_t M>
-UBSafeCArray<UBSafeCArray<T, N>, M>::UBSafeCArray(
-    const std::vector<size_t>& Sizes) {
+size_t UBSafeCArray<UBSafeCArray<T, N>, M>::getSize(size_t Dim) const {
+  if constexpr (IsFlat)
+    return Data_.Sizes[Dim];
+  else
+    return Dim == 0 ? getSize()
+                    : CArrayTraits<UBSafeCArray<T, N>>::getSize(Dim - 1);
+}
+
+template <typename T, size_t N, size_t M>
+UBSafeCArray<UBSafeCArray<T, N>, M>::UBSafeCArray(const CArraySizes& Sizes) {
   setSize(Sizes);
 }
 
 template <typename T, size_t N, size_t M>
-UBSafeCArray<UBSafeCArray<T, N>, M>::UBSafeCArray(
-    std::vector<size_t> Sizes,
-    const std::initializer_list<UBSafeCArray<T, N>>& Args)
-    : Data_{Args} {
+UBSafeCArray<UBSafeCArray<T, N>, M>::UBSafeCArray(const CArraySizes& Sizes,
+                                                  const InitListType& Args)
+    : UBSafeCArray(Args) {
   setSize(Sizes);
+  for (size_t Row = Args.size(); Row < getSize(); ++Row)
+    Data_[Row] =
+        UBSafeCArray<T, N>(typename UBSafeCArray<T, N>::InitListType{});
 }
 
 template <typename T, size_t N, size_t M>
-const UBSafeCArray<T, N>&
+typename UBSafeCArray<UBSafeCArray<T, N>, M>::ConstReference
 UBSafeCArray<UBSafeCArray<T, N>, M>::operator[](int Index) const {
-  return Data_.at(Index);
+  if constexpr (IsFlat)
+    return {Data_.Elements.data() + Index * Data_.Strides[0],
+            Data_.Sizes.data() + 1, Data_.Strides.data() + 1};
+  else
+    return Data_[Index];
 }
 
 template <typename T, size_t N, size_t M>
-UBSafeCArray<T, N>& UBSafeCArray<UBSafeCArray<T, N>, M>::operator[](int Index) {
-  return Data_.at(Index);
+typename UBSafeCArray<UBSafeCArray<T, N>, M>::Reference
+UBSafeCArray<UBSafeCArray<T, N>, M>::operator[](int Index) {
+  if constexpr (IsFlat)
+    return {Data_.Elements.data() + Index * Data_.Strides[0],
+            Data_.Sizes.data() + 1, Data_.Strides.data() + 1};
+  else
+    return Data_[Index];
 }
 
-// char specialization
+template <typename T, size_t N, size_t M>
+typename UBSafeCArray<UBSafeCArray<T, N>, M>::Pointer
+UBSafeCArray<UBSafeCArray<T, N>, M>::data() {
+  if constexpr (IsFlat)
+    return Data_.Elements.data();
+  else
+    return std::data(Data_);
+}
 
-template <size_t N>
-UBSafeCArray<char, N>::UBSafeCArray() {
-  Data_.resize(N);
+template <typename T, size_t N, size_t M>
+typename UBSafeCArray<UBSafeCArray<T, N>, M>::ConstPointer
+UBSafeCArray<UBSafeCArray<T, N>, M>::data() const {
+  if constexpr (IsFlat)
+    return Data_.Elements.data();
+  else
+    return std::data(Data_);
+}
+
+template <typename T, size_t N, size_t M>
+size_t UBSafeCArray<UBSafeCArray<T, N>, M>::size() const {
+  return getSize();
+}
+
+template <typename T, size_t N, size_t M>
+typename UBSafeCArray<UBSafeCArray<T, N>, M>::Pointer
+UBSafeCArray<UBSafeCArray<T, N>, M>::begin() {
+  static_assert(!IsFlat, "variable-sized rows cannot be iterated");
+  return data();
+}
+
+template <typename T, size_t N, size_t M>
+typename UBSafeCArray<UBSafeCArray<T, N>, M>::ConstPointer
+UBSafeCArray<UBSafeCArray<T, N>, M>::begin() const {
+  static_assert(!IsFlat, "variable-sized rows cannot be iterated");
+  return data();
+}
+
+template <typename T, size_t N, size_t M>
+typename UBSafeCArray<UBSafeCArray<T, N>, M>::Pointer
+UBSafeCArray<UBSafeCArray<T, N>, M>::end() {
+  static_assert(!IsFlat, "variable-sized rows cannot be iterated");
+  return data() + getSize();
+}
+
+template <typename T, size_t N, size_t M>
+typename UBSafeCArray<UBSafeCArray<T, N>, M>::ConstPointer
+UBSafeCArray<UBSafeCArray<T, N>, M>::end() const {
+  static_assert(!IsFlat, "variable-sized rows cannot be iterated");
+  return data() + getSize();
 }
 
+// char specialization
+
 template <size_t N>
-UBSafeCArray<char, N>::UBSafeCArray(const std::initializer_list<char>& InitList)
-    : Data_{InitList} {
-  if (N != 0)
-    setSize(N);
+UBSafeCArray<char, N>::UBSafeCArray(const InitListType& InitList) {
+  if constexpr (N != 0) {
+    size_t Count = std::min(InitList.size(), N);
+    std::copy_n(InitList.begin(), Count, Data_);
+    std::fill(Data_ + Count, Data_ + N, '\0');
+  } else
+    Data_ = InitList;
 }
 
 template <size_t N>
 void UBSafeCArray<char, N>::setSize(size_t Size) {
-  Data_.resize(Size);
+  if constexpr (N == 0)
+    Data_.resize(Size);
 }
 
 template <size_t N>
-void UBSafeCArray<char, N>::setSize(const std::vector<size_t>& Sizes,
-                                    int CurDepth) {
+void UBSafeCArray<char, N>::setSize(const CArraySizes& Sizes, int CurDepth) {
   setSize(Sizes[CurDepth]);
 }
 
 template <size_t N>
 size_t UBSafeCArray<char, N>::getSize() const {
-  return Data_.size();
+  if constexpr (N != 0)
+    return N;
+  else
+    return Data_.size();
 }
 
 template <size_t N>
-UBSafeCArray<char, N>::UBSafeCArray(const std::vector<size_t>& Sizes) {
+UBSafeCArray<char, N>::UBSafeCArray(const CArraySizes& Sizes) {
   setSize(Sizes);
 }
 
 template <size_t N>
-UBSafeCArray<char, N>::UBSafeCArray(std::vector<size_t> Sizes,
-                                    const std::initializer_list<char>& Args)
+UBSafeCArray<char, N>::UBSafeCArray(const CArraySizes& Sizes,
+                                    const InitListType& Args)
     : UBSafeCArray(Args) {
   setSize(Sizes);
+  std::fill(begin() + std::min(Args.size(), getSize()), end(), '\0');
 }
 
 template <size_t N>
-UBSafeCArray<char, N>::UBSafeCArray(std::vector<size_t> Sizes,
-                                    const char* StringLiteral)
-    : UBSafeCArray(StringLiteral) {
+UBSafeCArray<char, N>::UBSafeCArray(const CArraySizes& Sizes,
+                                    const char* StringLiteral) {
   setSize(Sizes);
+  size_t Count = std::min(std::strlen(StringLiteral) + 1, getSize());
+  std::memcpy(data(), StringLiteral, Count);
+  std::memset(data() + Count, 0, getSize() - Count);
 }
 
+// literal is cut to size of array and the rest is zeroed, as it is in C
 template <size_t N>
 UBSafeCArray<char, N>::UBSafeCArray(const char* StringLiteral) {
-  setSize(strlen(StringLiteral) + 1);
-  size_t i = 0;
-  while (*StringLiteral != '\0')
-    Data_[i++] = *StringLiteral;
+  size_t Length = std::strlen(StringLiteral) + 1;
+  if constexpr (N == 0)
+    setSize(Length);
+  size_t Count = std::min(Length, getSize());
+  std::memcpy(data(), StringLiteral, Count);
+  std::memset(data() + Count, 0, getSize() - Count);
 }
 
 template <size_t N>
 const char& UBSafeCArray<char, N>::operator[](int Index) const {
-  return Data_.at(Index);
+  return Data_[Index];
 }
 
 template <size_t N>
 char& UBSafeCArray<char, N>::operator[](int Index) {
-  return Data_.at(Index);
+  return Data_[Index];
+}
+
+template <size_t N>
+char* UBSafeCArray<char, N>::data() {
+  return std::data(Data_);
+}
+
+template <size_t N>
+const char* UBSafeCArray<char, N>::data() const {
+  return std::data(Data_);
+}
+
+template <size_t N>
+size_t UBSafeCArray<char, N>::size() const {
+  return getSize();
+}
+
+template <size_t N>
+char* UBSafeCArray<char, N>::begin() {
+  return data();
+}
+
+template <size_t N>
+const char* UBSafeCArray<char, N>::begin() const {
+  return data();
+}
+
+template <size_t N>
+char* UBSafeCArray<char, N>::end() {
+  return data() + getSize();
+}
+
+template <size_t N>
+const char* UBSafeCArray<char, N>::end() const {
+  return data() + getSize();
+}
+
+// specialization for tracked elements of fundamental types
+
+template <typename T, size_t N>
+UBSafeCArray<uninit_vars::UBSafeType<T>, N>::UBSafeCArray(
+    const InitListType& InitList) {
+  if constexpr (N != 0) {
+    size_t Count = std::min(InitList.size(), N);
+    std::copy_n(InitList.begin(), Count, Data_);
+    std::fill(Data_ + Count, Data_ + N, T{});
+  } else {
+    Data_ = InitList;
+    InitBits_.resize(InitList.size());
+  }
+  InitBits_.setRange(0, getSize());
+}
+
+// literal is cut to size of array and the rest is zeroed, as it is in C
+template <typename T, size_t N>
+UBSafeCArray<uninit_vars::UBSafeType<T>, N>::UBSafeCArray(
+    const T* StringLiteral) {
+  size_t Length = std::char_traits<T>::length(StringLiteral) + 1;
+  if constexpr (N == 0)
+    setSize(Length);
+  T* End = std::copy_n(StringLiteral, std::min(Length, getSize()), data());
+  std::fill(End, end(), T{});
+}
+
+template <typename T, size_t N>
+void UBSafeCArray<uninit_vars::UBSafeType<T>, N>::setSize(size_t Size) {
+  if constexpr (N == 0) {
+    Data_.resize(Size);
+    InitBits_.resize(Size);
+  }
+}
+
+template <typename T, size_t N>
+void UBSafeCArray<uninit_vars::UBSafeType<T>, N>::setSize(
+    const CArraySizes& Sizes, int CurDepth) {
+  setSize(Sizes[CurDepth]);
+}
+
+template <typename T, size_t N>
+size_t UBSafeCArray<uninit_vars::UBSafeType<T>, N>::getSize() const {
+  if constexpr (N != 0)
+    return N;
+  else
+    return Data_.size();
+}
+
+template <typename T, size_t N>
+UBSafeCArray<uninit_vars::UBSafeType<T>, N>::UBSafeCArray(
+    const CArraySizes& Sizes) {
+  setSize(Sizes);
+}
+
+template <typename T, size_t N>
+UBSafeCArray<uninit_vars::UBSafeType<T>, N>::UBSafeCArray(
+    const CArraySizes& Sizes, const InitListType& Args)
+    : UBSafeCArray(Args) {
+  setSize(Sizes);
+  std::fill(getWriteRange(0, getSize()) + std::min(Args.size(), getSize()),
+            end(), T{});
+}
+
+template <typename T, size_t N>
+UBSafeCArray<uninit_vars::UBSafeType<T>, N>::UBSafeCArray(
+    const CArraySizes& Sizes, const T* StringLiteral) {
+  setSize(Sizes);
+  size_t Length = std::char_traits<T>::length(StringLiteral) + 1;
+  T* End = std::copy_n(StringLiteral, std::min(Length, getSize()), data());
+  std::fill(End, end(), T{});
+}
+
+template <typename T, size_t N>
+uninit_vars::UBSafeTypeRef<const T>
+UBSafeCArray<uninit_vars::UBSafeType<T>, N>::operator[](int Index) const {
+  return {Data_[Index], InitBits_.getWord(Index), InitBits_.getMask(Index)};
+}
+
+template <typename T, size_t N>
+uninit_vars::UBSafeTypeRef<T>
+UBSafeCArray<uninit_vars::UBSafeType<T>, N>::operator[](int Index) {
+  return {Data_[Index], InitBits_.getWord(Index), InitBits_.getMask(Index)};
+}
+
+template <typename T, size_t N>
+T* UBSafeCArray<uninit_vars::UBSafeType<T>, N>::data() {
+  return getWriteRange(0, getSize());
+}
+
+template <typename T, size_t N>
+const T* UBSafeCArray<uninit_vars::UBSafeType<T>, N>::data() const {
+  return std::data(Data_);
+}
+
+template <typename T, size_t N>
+size_t UBSafeCArray<uninit_vars::UBSafeType<T>, N>::size() const {
+  return getSize();
+}
+
+// range is checked by callers
+template <typename T, size_t N>
+T* UBSafeCArray<uninit_vars::UBSafeType<T>, N>::getWriteRange(size_t Begin,
+                                                               size_t End) {
+  InitBits_.setRange(Begin, End);
+  return std::data(Data_);
+}
+
+template <typename T, size_t N>
+size_t
+UBSafeCArray<uninit_vars::UBSafeType<T>, N>::getInitPrefix(size_t End) const {
+  return InitBits_.getSetPrefix(End);
+}
+
+template <typename T, size_t N>
+T* UBSafeCArray<uninit_vars::UBSafeType<T>, N>::begin() {
+  return data();
+}
+
+template <typename T, size_t N>
+const T* UBSafeCArray<uninit_vars::UBSafeType<T>, N>::begin() const {
+  return data();
+}
+
+// elements are marked by begin(), end() alone is not dereferenced
+template <typename T, size_t N>
+T* UBSafeCArray<uninit_vars::UBSafeType<T>, N>::end() {
+  return std::data(Data_) + getSize();
+}
+
+template <typename T, size_t N>
+const T* UBSafeCArray<uninit_vars::UBSafeType<T>, N>::end() const {
+  return data() + getSize();
 }
 
 } // namespace ub_tester::ub_safe_carray
@@ -20,13 +20,20 @@ public:
 
   const T& operator*() const;
   T& operator*();
-  const T& operator->() const;
-  T& operator->();
+  const T* operator->() const;
+  T* operator->();
   const T& operator[](int Val) const;
   T& operator[](int Val);
 
   operator T*();
 
+  /* Range of pointer is its tracked size, so range-for and standard
+   * algorithms iterate raw pointers without per-element checks. */
+  T* data() const;
+  size_t size() const;
+  T* begin() const;
+  T* end() const;
+
   UBSafePointer<T>& setSize(size_t NewSize);
   size_t getSize() const;
   PtrStateKind getState() const;
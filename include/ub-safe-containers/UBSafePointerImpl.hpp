@@ -12,6 +12,8 @@ UBSafePointer<T>::UBSafePointer(T* Data, size_t Size)
 template <typename T>
 UBSafePointer<T>& UBSafePointer<T>::operator=(T* Data) {
   Data_ = Data;
+  Inited_ = true;
+  return *this;
 }
 
 template <typename T>
@@ -44,13 +46,13 @@ T& UBSafePointer<T>::operator*() {
 }
 
 template <typename T>
-const T& UBSafePointer<T>::operator->() const {
-  return *Data_;
+const T* UBSafePointer<T>::operator->() const {
+  return Data_;
 }
 
 template <typename T>
-T& UBSafePointer<T>::operator->() {
-  return *Data_;
+T* UBSafePointer<T>::operator->() {
+  return Data_;
 }
 
 template <typename T>
@@ -68,6 +70,26 @@ UBSafePointer<T>::operator T*() {
   return Data_;
 }
 
+template <typename T>
+T* UBSafePointer<T>::data() const {
+  return Data_;
+}
+
+template <typename T>
+size_t UBSafePointer<T>::size() const {
+  return Size_;
+}
+
+template <typename T>
+T* UBSafePointer<T>::begin() const {
+  return Data_;
+}
+
+template <typename T>
+T* UBSafePointer<T>::end() const {
+  return Data_ + Size_;
+}
+
 template <typename T>
 UBSafePointer<T>& UBSafePointer<T>::setSize(size_t NewSize) {
   Size_ = NewSize;
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "UBSafeType.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/* Safe arrays of fundamental types keep their values contiguous, in layout of
+ * C arrays, and init state of every element is a bit of separate bitmap.
+ * Elements are accessed through UBSafeTypeRef, which refers to the value and
+ * its bit and has the interface of UBSafeType, so the same asserts apply to
+ * both. Ranges of elements are marked a word of bits at a time. */
+
+namespace ub_tester::uninit_vars {
+
+using InitWord = uint64_t;
+constexpr size_t InitWordBits = 64;
+
+constexpr size_t getNumInitWords(size_t Size) {
+  return (Size + InitWordBits - 1) / InitWordBits;
+}
+
+// bits [Begin, End) of one word
+constexpr InitWord getInitMask(size_t Begin, size_t End) {
+  return (End - Begin == InitWordBits ? ~InitWord{0}
+                                      : (InitWord{1} << (End - Begin)) - 1)
+         << Begin;
+}
+
+// bits of N elements, bitmap of runtime size if N == 0
+template <size_t N>
+class InitBitmap final {
+public:
+  // bits of elements past Size are cleared, so grown bitmap has no stale ones
+  void resize(size_t Size) {
+    static_assert(N == 0, "size of inline bitmap is fixed by type");
+    Words_.resize(getNumInitWords(Size));
+    if (Size % InitWordBits != 0)
+      Words_.back() &= getInitMask(0, Size % InitWordBits);
+  }
+
+  InitWord& getWord(size_t Index) { return Words_[Index / InitWordBits]; }
+  const InitWord& getWord(size_t Index) const {
+    return Words_[Index / InitWordBits];
+  }
+
+  static InitWord getMask(size_t Index) {
+    return InitWord{1} << (Index % InitWordBits);
+  }
+
+  bool isSet(size_t Index) const { return getWord(Index) & getMask(Index); }
+  void set(size_t Index) { getWord(Index) |= getMask(Index); }
+
+  // whole words between the first and the last one are stored at once
+  void setRange(size_t Begin, size_t End) {
+    if (Begin >= End)
+      return;
+    size_t FirstWord = Begin / InitWordBits;
+    size_t LastWord = (End - 1) / InitWordBits;
+    size_t LastEnd = (End - 1) % InitWordBits + 1;
+    if (FirstWord == LastWord) {
+      Words_[FirstWord] |= getInitMask(Begin % InitWordBits, LastEnd);
+      return;
+    }
+    Words_[FirstWord] |= getInitMask(Begin % InitWordBits, InitWordBits);
+    for (size_t Word = FirstWord + 1; Word != LastWord; ++Word)
+      Words_[Word] = ~InitWord{0};
+    Words_[LastWord] |= getInitMask(0, LastEnd);
+  }
+
+  // number of leading set bits, at most End; whole words are skipped at once
+  size_t getSetPrefix(size_t End) const {
+    size_t Word = 0;
+    while (Word * InitWordBits < End && Words_[Word] == ~InitWord{0})
+      ++Word;
+    size_t Index = Word * InitWordBits;
+    while (Index < End && isSet(Index))
+      ++Index;
+    return Index < End ? Index : End;
+  }
+
+private:
+  std::conditional_t<N != 0, InitWord[getNumInitWords(N != 0 ? N : 1)],
+                     std::vector<InitWord>>
+      Words_{};
+};
+
+/* Reference to element of safe array (or to packed field, see UBSafeField.h)
+ * and to its init bit. It is returned by value, and its implicit conversion is
+ * unchecked: reads rewritten by the tool are checked by asserts, and the
+ * others (e.g. of arrays with static storage) may read zero-initialized
+ * elements. */
+template <typename T, typename Word = InitWord>
+class UBSafeTypeRef final {
+  using WordType = std::conditional_t<std::is_const_v<T>, const Word, Word>;
+  using ValueType = std::remove_const_t<T>;
+
+public:
+  UBSafeTypeRef(T& Value, WordType& Bits, Word Mask)
+      : Value_{Value}, Word_{Bits}, Mask_{Mask} {}
+  UBSafeTypeRef(const UBSafeTypeRef&) = default;
+
+  bool isInit() const { return Word_ & Mask_; }
+
+  ValueType assertGetValue_(const char* Filename, int Line) const {
+    if (UB_TESTER_UNLIKELY(!isInit()) &&
+        isCheckEnabled(CheckCategory::Uninit, Filename, Line)) {
+      PUSH_ERROR(UNINIT_VAR_ACCESS_ERROR,
+                 appendInfo("access to Value_ of uninitialized variable",
+                            Filename, Line),
+                 Filename, Line);
+    }
+    return Value_;
+  }
+
+  ValueType getValueUnchecked_() const { return Value_; }
+
+  T& getRefUnchecked_() const { return Value_; }
+
+  T& assertGetRef(const char* Filename, int Line) const {
+    if (UB_TESTER_UNLIKELY(!isInit()) &&
+        isCheckEnabled(CheckCategory::Uninit, Filename, Line)) {
+      PUSH_ERROR(UNINIT_VAR_ACCESS_ERROR,
+                 appendInfo("access to Value_ of uninitialized variable",
+                            Filename, Line),
+                 Filename, Line);
+    }
+    return Value_;
+  }
+
+  // element may be written through the reference, so it is marked initialized
+  T& assertGetRefIgnore(const char* Filename, int Line) const {
+    if (UB_TESTER_UNLIKELY(!isInit())) {
+      if (isCheckEnabled(CheckCategory::Uninit, Filename, Line) &&
+          !AssertMessageManager::isRepeatedWarning(
+              Filename, Line,
+              static_cast<int>(
+                  AssertFailCode::UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING))) {
+        PUSH_WARNING(UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING,
+                     appendInfo("variable is not being tracked anymore",
+                                Filename, Line));
+      }
+      Word_ |= Mask_;
+    }
+    return Value_;
+  }
+
+  T& setValue_(ValueType Val) const {
+    Value_ = Val;
+    if (!isInit()) // stores of bits of initialized elements are skipped
+      Word_ |= Mask_;
+    return Value_;
+  }
+
+  operator ValueType() const { return Value_; }
+
+  const UBSafeTypeRef& operator=(ValueType Val) const {
+    setValue_(Val);
+    return *this;
+  }
+
+  const UBSafeTypeRef& operator=(const UBSafeTypeRef& Other) const {
+    setValue_(Other.getValueUnchecked_());
+    return *this;
+  }
+
+  // address may be written through, so element is considered initialized
+  T* operator&() const {
+    if constexpr (!std::is_const_v<T>)
+      Word_ |= Mask_;
+    return &Value_;
+  }
+
+private:
+  T& Value_;
+  WordType& Word_;
+  Word Mask_;
+};
+
+} // namespace ub_tester::uninit_vars
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "InitBitmap.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/* Fields of aggregates made up only of fundamental fields are wrapped in
+ * UBSafeField instead of UBSafeType (see isPackedRecord()). Fields keep their
+ * values in original order and alignment, and init state of all of them is a
+ * bitmap stored before the value of the first field. The first field is
+ * constructed before the others, so it clears the bitmap, and every field
+ * initialized by aggregate initialization or default member initializer sets
+ * its bit. Other fields find the bitmap at offset computed from types of the
+ * fields preceding them, so they are accessed through the struct: copies
+ * detached from it (e.g. auto variables) keep values only, and copy of the
+ * whole struct copies the bitmap with the first field. Fields are checked
+ * through UBSafeTypeRef, like elements of safe arrays. */
+
+namespace ub_tester::uninit_vars {
+
+constexpr size_t MaxPackedFields = 64;
+
+// smallest word with a bit for every field
+template <size_t NumFields>
+using FieldInitWord = std::conditional_t<
+    NumFields <= 8, uint8_t,
+    std::conditional_t<NumFields <= 16, uint16_t,
+                       std::conditional_t<NumFields <= 32, uint32_t,
+                                          uint64_t>>>;
+
+// field of type T of struct with NumFields fields, preceded by PrevTypes
+template <size_t NumFields, typename T, typename... PrevTypes>
+class UBSafeField;
+
+namespace {
+
+template <typename FirstType, typename...>
+struct FirstFieldType {
+  using Type = FirstType;
+};
+
+constexpr size_t alignFieldOffset(size_t Offset, size_t Alignment) {
+  return (Offset + Alignment - 1) / Alignment * Alignment;
+}
+
+// fields are laid out one after another, as in standard-layout struct
+template <size_t NumFields, typename T, typename FirstType,
+          typename... MidTypes>
+constexpr size_t getFieldOffset() {
+  size_t Offset = sizeof(UBSafeField<NumFields, FirstType>);
+  ((Offset = alignFieldOffset(Offset, alignof(MidTypes)) + sizeof(MidTypes)),
+   ...);
+  return alignFieldOffset(Offset, alignof(T));
+}
+
+} // namespace
+
+/* Interface of UBSafeType, implemented through reference to the value and to
+ * its bit provided by Field::getRef_(). */
+template <typename Field, typename T>
+class UBSafeFieldBase {
+public:
+  T assertGetValue_(const char* Filename, int Line) const {
+    return getField().getRef_().assertGetValue_(Filename, Line);
+  }
+
+  T getValueUnchecked_() const { return getField().Value_; }
+
+  T& getRefUnchecked_() { return getField().Value_; }
+
+  T& assertGetRef(const char* Filename, int Line) {
+    return getField().getRef_().assertGetRef(Filename, Line);
+  }
+
+  T& assertGetRefIgnore(const char* Filename, int Line) {
+    return getField().getRef_().assertGetRefIgnore(Filename, Line);
+  }
+
+  T& setValue_(T Val) { return getField().getRef_().setValue_(Val); }
+
+  operator T() const { return assertGetValue_("unknown", -1); }
+
+  // stores of unrewritten code do not construct detached fields
+  Field& operator=(T Val) {
+    setValue_(Val);
+    return getField();
+  }
+
+  T& operator++() { return ++getField().Value_; }
+
+  T operator++(int) {
+    T Res = assertGetValue_("unknown", -1);
+    getField().Value_++;
+    return Res;
+  }
+
+  T& operator--() { return --getField().Value_; }
+
+  T operator--(int) {
+    T Res = assertGetValue_("unknown", -1);
+    getField().Value_--;
+    return Res;
+  }
+
+  // address may be written through, so field is considered initialized
+  T* operator&() { return &getField().getRef_(); }
+
+private:
+  Field& getField() { return static_cast<Field&>(*this); }
+  const Field& getField() const { return static_cast<const Field&>(*this); }
+};
+
+// the first field stores the bitmap
+template <size_t NumFields, typename T>
+class UBSafeField<NumFields, T> final
+    : public UBSafeFieldBase<UBSafeField<NumFields, T>, T> {
+  static_assert(NumFields <= MaxPackedFields, "too many fields to pack");
+  using WordType = FieldInitWord<NumFields>;
+
+public:
+  UBSafeField() : InitBits_{0}, Value_{} {}
+
+  UBSafeField(T Val) : InitBits_{1}, Value_{Val} {}
+
+  UBSafeField(const UBSafeField& Other)
+      : InitBits_{Other.InitBits_}, Value_{Other.Value_} {}
+
+  using UBSafeFieldBase<UBSafeField, T>::operator=;
+
+  UBSafeField& operator=(const UBSafeField& Other) {
+    InitBits_ = Other.InitBits_;
+    Value_ = Other.Value_;
+    return *this;
+  }
+
+private:
+  friend class UBSafeFieldBase<UBSafeField, T>;
+  template <size_t, typename, typename...>
+  friend class UBSafeField;
+
+  UBSafeTypeRef<T, WordType> getRef_() { return {Value_, InitBits_, 1}; }
+  UBSafeTypeRef<const T, WordType> getRef_() const {
+    return {Value_, InitBits_, 1};
+  }
+
+private:
+  WordType InitBits_;
+  T Value_;
+};
+
+// bits of the other fields are cleared by the first one
+template <size_t NumFields, typename T, typename... PrevTypes>
+class UBSafeField final
+    : public UBSafeFieldBase<UBSafeField<NumFields, T, PrevTypes...>, T> {
+  using WordType = FieldInitWord<NumFields>;
+  using FirstField =
+      UBSafeField<NumFields, typename FirstFieldType<PrevTypes...>::Type>;
+
+public:
+  UBSafeField() : Value_{} {}
+
+  UBSafeField(T Val) : Value_{Val} { getFirst().InitBits_ |= getMask(); }
+
+  // bit is copied with the first field
+  UBSafeField(const UBSafeField& Other) : Value_{Other.Value_} {}
+
+  using UBSafeFieldBase<UBSafeField, T>::operator=;
+
+  UBSafeField& operator=(const UBSafeField& Other) {
+    Value_ = Other.Value_;
+    return *this;
+  }
+
+private:
+  friend class UBSafeFieldBase<UBSafeField, T>;
+
+  static WordType getMask() {
+    return WordType{1} << sizeof...(PrevTypes);
+  }
+
+  FirstField& getFirst() {
+    return *reinterpret_cast<FirstField*>(reinterpret_cast<char*>(this) -
+                                          getFieldOffset<NumFields, T,
+                                                         PrevTypes...>());
+  }
+  const FirstField& getFirst() const {
+    return const_cast<UBSafeField*>(this)->getFirst();
+  }
+
+  UBSafeTypeRef<T, WordType> getRef_() {
+    return {Value_, getFirst().InitBits_, getMask()};
+  }
+  UBSafeTypeRef<const T, WordType> getRef_() const {
+    return {Value_, getFirst().InitBits_, getMask()};
+  }
+
+private:
+  T Value_;
+};
+
+} // namespace ub_tester::uninit_vars
@@ -1,19 +1,28 @@
 #pragma once
 
 #include "assert-message-manager/AssertMessageManager.h"
+#include "assert-message-manager/CheckToggles.h"
 #include <string>
 
+// shadow backend defines them in UninitShadow.h
+#ifndef UB_TESTER_UNINIT_SHADOW
 #define ASSERT_SET_VALUE(Variable, SetExpr) Variable.setValue_((SetExpr))
 #define ASSERT_GET_VALUE(Variable) Variable.assertGetValue_(__FILE__, __LINE__)
+// variable is known to have passed a check earlier on every path
+#define GET_VALUE_UNCHECKED(Variable) Variable.getValueUnchecked_()
+#define GET_REF_UNCHECKED(Variable) Variable.getRefUnchecked_()
 #define ASSERT_GET_REF(Variable) Variable.assertGetRef(__FILE__, __LINE__)
 #define ASSERT_GET_REF_IGNORE(Variable)                                        \
   Variable.assertGetRefIgnore(__FILE__, __LINE__)
+#endif
 
 namespace ub_tester::uninit_vars {
 
 using assert_message_manager::AssertFailCode;
 using assert_message_manager::AssertMessage;
 using assert_message_manager::AssertMessageManager;
+using assert_message_manager::toggles::CheckCategory;
+using assert_message_manager::toggles::isCheckEnabled;
 
 inline std::string appendInfo(std::string msg, const char* Filename, int Line) {
   return msg + " in \"" + Filename + "\" Line: \"" + std::to_string(Line) +
@@ -32,25 +41,38 @@ public:
                                                                      false} {}
 
   T assertGetValue_(const char* Filename, int Line) const {
-    if (!IsIgnored_ && !IsInit_) {
+    if (!IsIgnored_ && !IsInit_ &&
+        isCheckEnabled(CheckCategory::Uninit, Filename, Line)) {
       PUSH_ERROR(UNINIT_VAR_ACCESS_ERROR,
                  appendInfo("access to Value_ of uninitialized variable",
-                            Filename, Line));
+                            Filename, Line),
+                 Filename, Line);
     }
     return Value_;
   }
 
+  T getValueUnchecked_() const { return Value_; }
+
+  T& getRefUnchecked_() { return Value_; }
+
   T& assertGetRef(const char* Filename, int Line) {
-    if (!IsIgnored_ && !IsInit_) {
+    if (!IsIgnored_ && !IsInit_ &&
+        isCheckEnabled(CheckCategory::Uninit, Filename, Line)) {
       PUSH_ERROR(UNINIT_VAR_ACCESS_ERROR,
                  appendInfo("access to Value_ of uninitialized variable",
-                            Filename, Line));
+                            Filename, Line),
+                 Filename, Line);
     }
     return Value_;
   }
 
   T& assertGetRefIgnore(const char* Filename, int Line) {
-    if (!IsIgnored_ && !IsInit_) {
+    if (!IsIgnored_ && !IsInit_ &&
+        isCheckEnabled(CheckCategory::Uninit, Filename, Line) &&
+        !AssertMessageManager::isRepeatedWarning(
+            Filename, Line,
+            static_cast<int>(
+                AssertFailCode::UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING))) {
       PUSH_WARNING(
           UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING,
           appendInfo("variable is not being tracked anymore", Filename, Line));
@@ -94,8 +116,9 @@ public:
   T* operator&() { // ! not const
     if (!IsInit_) {
       IsIgnored_ = true;
-      PUSH_WARNING(UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING,
-                   appendInfo("releasing an uninit variable", "unknown", -1));
+      if (isCheckEnabled(CheckCategory::Uninit, "unknown", -1))
+        PUSH_WARNING(UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING,
+                     appendInfo("releasing an uninit variable", "unknown", -1));
     }
     return &Value_;
   }
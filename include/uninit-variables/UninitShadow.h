@@ -0,0 +1,184 @@
+#pragma once
+
+#include "UBSafeType.h"
+#include "assert-message-manager/AssertMessageManager.h"
+#include "assert-message-manager/CheckToggles.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#if defined(UB_TESTER_UNINIT_SHADOW) && defined(__linux__)
+#include <sys/mman.h>
+#define UB_TESTER_UNINIT_SHADOW_MEMORY
+#endif
+
+/* With UB_TESTER_UNINIT_SHADOW (set by -uninit-backend=shadow) variables keep
+ * their original types, and state of their bytes is kept in shadow memory:
+ * bit of byte at address A is bit A % 8 of shadow byte ShadowOffset + A / 8,
+ * set if the byte is uninitialized. Shadow of the whole user space is mapped
+ * at startup without reserving memory, so pages are committed only for
+ * shadow of stack. Declarations set bits of tracked variables, stores clear
+ * them and checked reads test them. If the range is occupied, checks are
+ * off. */
+
+#ifdef UB_TESTER_UNINIT_SHADOW
+#define ASSERT_SET_VALUE(Variable, SetExpr)                                    \
+  ub_tester::uninit_vars::shadow::setValue(Variable, (SetExpr))
+#define ASSERT_GET_VALUE(Variable)                                             \
+  ub_tester::uninit_vars::shadow::assertGetValue(Variable, __FILE__, __LINE__)
+#define GET_VALUE_UNCHECKED(Variable) (Variable)
+#define GET_REF_UNCHECKED(Variable) (Variable)
+#define ASSERT_GET_REF(Variable)                                               \
+  ub_tester::uninit_vars::shadow::assertGetRef(Variable, __FILE__, __LINE__)
+#define ASSERT_GET_REF_IGNORE(Variable)                                        \
+  ub_tester::uninit_vars::shadow::assertGetRefIgnore(Variable, __FILE__,      \
+                                                     __LINE__)
+// initializers of tracked variables, which refer to the declared variable
+#define DECLARE_INIT(Variable, InitExpr)                                       \
+  ub_tester::uninit_vars::shadow::declareInit(&(Variable), InitExpr)
+#define DECLARE_UNINIT(Variable)                                               \
+  ub_tester::uninit_vars::shadow::declareUninit(&(Variable))
+#endif
+
+namespace ub_tester::uninit_vars::shadow {
+
+constexpr unsigned AddressBits = 47; // user space of x86-64 and AArch64
+constexpr uintptr_t ShadowOffset = uintptr_t{1} << (AddressBits - 3);
+constexpr size_t ShadowSize = size_t{1} << (AddressBits - 3);
+
+inline uint8_t* getShadow(uintptr_t Address) {
+  return reinterpret_cast<uint8_t*>(ShadowOffset + (Address >> 3));
+}
+
+#ifdef UB_TESTER_UNINIT_SHADOW_MEMORY
+// address is only a hint, so mappings of the program are never replaced
+inline bool mapShadow() {
+  void* Hint = reinterpret_cast<void*>(ShadowOffset);
+  void* Memory = mmap(Hint, ShadowSize, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (Memory == MAP_FAILED)
+    return false;
+  if (Memory != Hint) {
+    munmap(Memory, ShadowSize);
+    return false;
+  }
+  return true;
+}
+#else
+inline bool mapShadow() { return false; }
+#endif
+
+/* Set before main, declarations run before the set-up are not tracked. Flag
+ * is not atomic, so it can be kept in register through loops. */
+inline bool IsShadowMapped = mapShadow();
+
+// bits of Size bytes at Address, which lie in one shadow byte
+inline uint8_t getMask(uintptr_t Address, size_t Size) {
+  return static_cast<uint8_t>(((1u << Size) - 1) << (Address & 7));
+}
+
+/* Applies Update to shadow bytes of object and masks of its bits. Naturally
+ * aligned fundamental types of up to 8 bytes have all bits in one byte. */
+template <typename T, typename UpdateType>
+void updateShadow(const T* Object, UpdateType Update) {
+  auto Address = reinterpret_cast<uintptr_t>(Object);
+  if constexpr (sizeof(T) <= 8 && alignof(T) == sizeof(T))
+    Update(*getShadow(Address), getMask(Address, sizeof(T)));
+  else
+    for (uintptr_t End = Address + sizeof(T); Address != End;) {
+      uintptr_t Next = (Address | 7) + 1 < End ? (Address | 7) + 1 : End;
+      Update(*getShadow(Address), getMask(Address, Next - Address));
+      Address = Next;
+    }
+}
+
+template <typename T>
+bool isPoisoned(const T* Object) {
+  if (!IsShadowMapped)
+    return false;
+  bool IsPoisoned = false;
+  updateShadow(Object, [&IsPoisoned](uint8_t& Shadow, uint8_t Mask) {
+    IsPoisoned |= (Shadow & Mask) != 0;
+  });
+  return IsPoisoned;
+}
+
+template <typename T>
+void poison(const T* Object) {
+  if (!IsShadowMapped)
+    return;
+  updateShadow(Object, [](uint8_t& Shadow, uint8_t Mask) { Shadow |= Mask; });
+}
+
+template <typename T>
+void unpoison(const T* Object) {
+  if (!IsShadowMapped)
+    return;
+  // shadow of initialized variable is only read, stores would serialize
+  // checks and updates of the same byte
+  updateShadow(Object, [](uint8_t& Shadow, uint8_t Mask) {
+    if (UB_TESTER_UNLIKELY(Shadow & Mask))
+      Shadow &= static_cast<uint8_t>(~Mask);
+  });
+}
+
+// uninitialized variable is still value-initialized, as in UBSafeType
+template <typename T>
+T declareUninit(T* Variable) {
+  poison(Variable);
+  return T{};
+}
+
+template <typename T>
+T declareInit(T* Variable, typename std::remove_cv<T>::type Value) {
+  unpoison(Variable);
+  return Value;
+}
+
+inline void reportUninitAccess(const char* Filename, int Line) {
+  if (isCheckEnabled(CheckCategory::Uninit, Filename, Line)) {
+    PUSH_ERROR(UNINIT_VAR_ACCESS_ERROR,
+               appendInfo("access to Value_ of uninitialized variable",
+                          Filename, Line),
+               Filename, Line);
+  }
+}
+
+template <typename T>
+T assertGetValue(const T& Variable, const char* Filename, int Line) {
+  if (UB_TESTER_UNLIKELY(isPoisoned(&Variable)))
+    reportUninitAccess(Filename, Line);
+  return Variable;
+}
+
+template <typename T>
+T& assertGetRef(T& Variable, const char* Filename, int Line) {
+  if (UB_TESTER_UNLIKELY(isPoisoned(&Variable)))
+    reportUninitAccess(Filename, Line);
+  return Variable;
+}
+
+template <typename T>
+T& assertGetRefIgnore(T& Variable, const char* Filename, int Line) {
+  if (UB_TESTER_UNLIKELY(isPoisoned(&Variable)) &&
+      isCheckEnabled(CheckCategory::Uninit, Filename, Line) &&
+      !AssertMessageManager::isRepeatedWarning(
+          Filename, Line,
+          static_cast<int>(
+              AssertFailCode::UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING))) {
+    PUSH_WARNING(
+        UNINIT_VAR_IS_NOT_TRACKED_ANYMORE_WARNING,
+        appendInfo("variable is not being tracked anymore", Filename, Line));
+  }
+  unpoison(&Variable);
+  return Variable;
+}
+
+template <typename T, typename ValueType>
+T& setValue(T& Variable, ValueType&& Value) {
+  unpoison(&Variable);
+  Variable = std::forward<ValueType>(Value);
+  return Variable;
+}
+
+} // namespace ub_tester::uninit_vars::shadow
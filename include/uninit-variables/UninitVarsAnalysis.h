@@ -0,0 +1,66 @@
+#pragma once
+
+#include "clang/AST/ASTConsumer.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+
+namespace ub_tester::uninit::analysis {
+
+/* Variable is proven initialized if Clang's uninitialized-values analysis
+ * finds no possibly uninitialized read of it and its address never escapes
+ * (&var, reference binding, by-reference capture). Such variables keep their
+ * original type and are not instrumented by uninit checks. */
+bool isProvenInitialized(const clang::DeclaratorDecl* Decl,
+                         const clang::ASTContext* Context);
+void setIsProvenInitialized(const clang::VarDecl* VDecl,
+                            const clang::ASTContext* Context);
+
+/* Shadow backend tracks only local variables that may be read uninitialized
+ * and whose address never escapes, so that every store to them is
+ * instrumented and their declarations reset their shadow bits. Reads of other
+ * variables are not checked, because their shadow may be left from previous
+ * frames. */
+bool isShadowTracked(const clang::VarDecl* VDecl,
+                     const clang::ASTContext* Context);
+void setIsShadowTracked(const clang::VarDecl* VDecl,
+                        const clang::ASTContext* Context);
+
+/* Read of a still wrapped variable is unchecked if on every path to it the
+ * variable has already passed a check (read, assignment or initialization)
+ * since its declaration was last executed. IsInit_ of UBSafeType can be reset
+ * only through address of the variable, e.g. by memcpy or by implicit copy
+ * assignment in code that is not rewritten, so reads of escaped variables are
+ * always checked. */
+bool isUncheckedRead(const clang::DeclRefExpr* DRExpr,
+                     const clang::ASTContext* Context);
+
+/* With IOB checks and wrapper backend, safe arrays of fundamental types track
+ * init state of their elements in bitmaps, element type of their declarations
+ * is wrapped in UBSafeType. Elements of const arrays are always initialized. */
+bool isTrackedElementType(clang::QualType ElementType);
+
+/* With wrapper backend, fields of aggregates made up only of fundamental
+ * fields are wrapped in UBSafeField: values keep layout of the struct and init
+ * state of fields is a bitmap stored with the first one. */
+bool isPackedRecord(const clang::RecordDecl* RDecl,
+                    const clang::ASTContext* Context);
+
+class UninitVarsAnalysisVisitor
+    : public clang::RecursiveASTVisitor<UninitVarsAnalysisVisitor> {
+public:
+  explicit UninitVarsAnalysisVisitor(clang::ASTContext* Context);
+  bool VisitFunctionDecl(clang::FunctionDecl* FuncDecl);
+
+private:
+  clang::ASTContext* Context_;
+};
+
+class UninitVarsAnalysisConsumer : public clang::ASTConsumer {
+public:
+  explicit UninitVarsAnalysisConsumer(clang::ASTContext* Context);
+  virtual void HandleTranslationUnit(clang::ASTContext& Context);
+
+private:
+  UninitVarsAnalysisVisitor AnalysisVisitor_;
+};
+
+} // namespace ub_tester::uninit::analysis
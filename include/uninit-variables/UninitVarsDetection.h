@@ -20,6 +20,7 @@ class FindSafeTypeAccessesVisitor
 public:
   explicit FindSafeTypeAccessesVisitor(clang::ASTContext* Context);
   bool VisitDeclRefExpr(clang::DeclRefExpr* DRExpr);
+  bool VisitArraySubscriptExpr(clang::ArraySubscriptExpr* SubscriptExpr);
 
 private:
   clang::ASTContext* Context_;
@@ -4,6 +4,7 @@
 #include "clang/Lex/Lexer.h"
 #include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <sstream>
 
 using namespace clang;
@@ -22,6 +23,28 @@ std::string getRangeAsString(const SourceRange& Range,
       .str();
 }
 
+std::string getExprAsStringLiteral(const Expr* Ex, const ASTContext* Context) {
+  constexpr size_t MaxLength = 64;
+  std::string Text = getExprAsString(Ex, Context);
+  std::string Literal = "\"";
+  size_t Length = 0;
+  bool IsPrevSpace = false;
+  for (char Symb : Text) {
+    bool IsSpace = std::isspace(static_cast<unsigned char>(Symb));
+    if (IsSpace && IsPrevSpace)
+      continue;
+    IsPrevSpace = IsSpace;
+    if (Length++ == MaxLength) {
+      Literal += "...";
+      break;
+    }
+    if (Symb == '"' || Symb == '\\')
+      Literal += '\\';
+    Literal += IsSpace ? ' ' : Symb;
+  }
+  return Literal + "\"";
+}
+
 std::string getExprLineNCol(const Expr* Expression, const ASTContext* Context) {
   FullSourceLoc FullLocation = Context->getFullLoc(Expression->getBeginLoc());
   std::stringstream res;
@@ -100,6 +123,113 @@ std::string getFuncNameWithArgsAsString(const clang::FunctionDecl* FuncDecl) {
   return Ans;
 }
 
+std::string getLocAsKey(SourceLocation Loc, const ASTContext* Context) {
+  const auto& SM = Context->getSourceManager();
+  SourceLocation SpellingLoc = SM.getSpellingLoc(Loc);
+  std::stringstream Res;
+  Res << SM.getFilename(SpellingLoc).str() << ":"
+      << SM.getFileOffset(SpellingLoc);
+  return Res.str();
+}
+
+bool canChangeParamTypes(const FunctionDecl* FuncDecl) {
+  if (!FuncDecl->isFirstDecl())
+    return false;
+  if (const auto* Method = dyn_cast<CXXMethodDecl>(FuncDecl))
+    return !Method->isVirtual();
+  return true;
+}
+
+EscapedVarsVisitor::EscapedVarsVisitor(const FunctionDecl* FuncDecl)
+    : FuncDecl_{FuncDecl} {}
+
+bool EscapedVarsVisitor::VisitVarDecl(VarDecl* VDecl) {
+  if (VDecl->getDeclContext() == FuncDecl_)
+    LocalVars_.push_back(VDecl);
+  if (VDecl->getType()->isReferenceType() && VDecl->hasInit())
+    markEscaped(VDecl->getInit());
+  return true;
+}
+
+bool EscapedVarsVisitor::VisitUnaryOperator(UnaryOperator* Unop) {
+  if (Unop->getOpcode() == UnaryOperator::Opcode::UO_AddrOf)
+    markEscaped(Unop->getSubExpr());
+  return true;
+}
+
+// lvalue arguments are bound to reference parameters
+bool EscapedVarsVisitor::VisitCallExpr(CallExpr* CE) {
+  for (Expr* Arg : CE->arguments())
+    markEscaped(Arg);
+  return true;
+}
+
+bool EscapedVarsVisitor::VisitCXXConstructExpr(CXXConstructExpr* CCE) {
+  for (Expr* Arg : CCE->arguments())
+    markEscaped(Arg);
+  return true;
+}
+
+bool EscapedVarsVisitor::VisitInitListExpr(InitListExpr* List) {
+  for (Expr* Init : List->inits())
+    markEscaped(Init);
+  return true;
+}
+
+bool EscapedVarsVisitor::VisitLambdaExpr(LambdaExpr* Lambda) {
+  for (const LambdaCapture& Capture : Lambda->captures())
+    if (Capture.capturesVariable() &&
+        Capture.getCaptureKind() == LambdaCaptureKind::LCK_ByRef)
+      EscapedVars_.insert(Capture.getCapturedVar());
+  return true;
+}
+
+bool EscapedVarsVisitor::VisitReturnStmt(ReturnStmt* Return) {
+  if (Return->getRetValue() && FuncDecl_->getReturnType()->isReferenceType())
+    markEscaped(Return->getRetValue());
+  return true;
+}
+
+const std::vector<const VarDecl*>& EscapedVarsVisitor::getLocalVars() const {
+  return LocalVars_;
+}
+
+bool EscapedVarsVisitor::isEscaped(const VarDecl* VDecl) const {
+  return EscapedVars_.find(VDecl) != EscapedVars_.end();
+}
+
+// marks variable if Ex designates it as lvalue (no lvalue-to-rvalue cast)
+void EscapedVarsVisitor::markEscaped(const Expr* Ex) {
+  if (!Ex)
+    return;
+  Ex = Ex->IgnoreParens();
+  if (const auto* ImplicitCast = dyn_cast<ImplicitCastExpr>(Ex)) {
+    if (ImplicitCast->getCastKind() == CastKind::CK_NoOp)
+      markEscaped(ImplicitCast->getSubExpr());
+    return;
+  }
+  if (const auto* CondOp = dyn_cast<AbstractConditionalOperator>(Ex)) {
+    markEscaped(CondOp->getTrueExpr());
+    markEscaped(CondOp->getFalseExpr());
+    return;
+  }
+  if (const auto* Binop = dyn_cast<BinaryOperator>(Ex)) {
+    if (Binop->isAssignmentOp())
+      markEscaped(Binop->getLHS());
+    else if (Binop->isCommaOp())
+      markEscaped(Binop->getRHS());
+    return;
+  }
+  if (const auto* Unop = dyn_cast<UnaryOperator>(Ex)) {
+    if (Unop->isPrefix() && Unop->isIncrementDecrementOp())
+      markEscaped(Unop->getSubExpr());
+    return;
+  }
+  if (const auto* DRExpr = dyn_cast<DeclRefExpr>(Ex))
+    if (const auto* VDecl = dyn_cast<VarDecl>(DRExpr->getDecl()))
+      EscapedVars_.insert(VDecl);
+}
+
 namespace func_code_avail {
 
 std::unordered_set<std::string> FuncsWithAvailCode;
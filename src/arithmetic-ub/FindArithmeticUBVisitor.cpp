@@ -1,6 +1,7 @@
 #include "arithmetic-ub/FindArithmeticUBVisitor.h"
 #include "UBUtility.h"
 #include "code-injector/InjectorASTWrapper.h"
+#include "instrumentation-scope/InstrumentationScope.h"
 #include "clang/Basic/SourceManager.h"
 #include <cassert>
 
@@ -14,16 +15,16 @@ FindArithmeticUBVisitor::FindArithmeticUBVisitor(ASTContext* Context)
     : Context_(Context) {}
 
 bool FindArithmeticUBVisitor::VisitBinaryOperator(BinaryOperator* Binop) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(Binop->getBeginLoc()))
+  if (!scope::shouldInstrument(Binop->getBeginLoc(), Context_))
     return true;
 
   QualType BinopType = Binop->getType();
-  if (BinopType->isDependentType())
-    return true; // templates are not supported yet
-  if (BinopType->isFloatingType())
-    return true; // floating point types are not supported yet
-  if (!BinopType->isFundamentalType())
-    return true; // only fundamental type arithmetic is supported
+  if (!Binop->isTypeDependent()) {
+    if (BinopType->isFloatingType())
+      return true; // floating point types are not supported yet
+    if (!BinopType->isFundamentalType())
+      return true; // only fundamental type arithmetic is supported
+  }
 
   std::string OperationName = "undefined";
   switch (Binop->getOpcode()) {
@@ -52,6 +53,12 @@ bool FindArithmeticUBVisitor::VisitBinaryOperator(BinaryOperator* Binop) {
     return true;
   }
 
+  if (Binop->isTypeDependent()) {
+    substituteGenericBinop(OperationName, Binop, Binop->getLHS(),
+                           Binop->getRHS());
+    return true;
+  }
+
   // check BinopType assumption
   assert(!BinopType.hasQualifiers());
   // remove any typedefs
@@ -77,9 +84,11 @@ bool FindArithmeticUBVisitor::VisitBinaryOperator(BinaryOperator* Binop) {
   SubstitutionASTWrapper(Context_)
       .setLoc(Binop->getBeginLoc())
       .setPrior(SubstPriorityKind::Shallow)
+      .setCheckKind(budget::CheckKind::Arithm)
       .setFormats("@#@", "ASSERT_BINOP(" + OperationName + ", @, @, " +
                              LhsType.getAsString() + ", " +
-                             RhsType.getAsString() + ")")
+                             RhsType.getAsString() + ", " +
+                             getCheckSiteArgs(Binop) + ")")
       .setArguments(Lhs, Rhs)
       .apply();
 
@@ -87,18 +96,18 @@ bool FindArithmeticUBVisitor::VisitBinaryOperator(BinaryOperator* Binop) {
 }
 
 bool FindArithmeticUBVisitor::VisitUnaryOperator(UnaryOperator* Unop) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(Unop->getBeginLoc()))
+  if (!scope::shouldInstrument(Unop->getBeginLoc(), Context_))
     return true;
   /*if (!Unop->canOverflow())
     return true;*/ // can't use canOverflow(), it causes ignored warnings
 
   QualType UnopType = Unop->getType();
-  if (UnopType->isDependentType())
-    return true; // templates are not supported yet
-  if (UnopType->isFloatingType())
-    return true; // floating point types are not supported yet
-  if (!UnopType->isFundamentalType())
-    return true; // only fundamental type arithmetic is supported
+  if (!Unop->isTypeDependent()) {
+    if (UnopType->isFloatingType())
+      return true; // floating point types are not supported yet
+    if (!UnopType->isFundamentalType())
+      return true; // only fundamental type arithmetic is supported
+  }
 
   std::string UnopName = UnaryOperator::getOpcodeStr(Unop->getOpcode()).str();
   std::string OperationName = "undefined";
@@ -119,11 +128,17 @@ bool FindArithmeticUBVisitor::VisitUnaryOperator(UnaryOperator* Unop) {
     OperationName = "PostfixDecr";
     break;
   default:
-    if (Unop->canOverflow())
+    if (!Unop->isTypeDependent() && Unop->canOverflow())
       llvm_unreachable("Not known unary operator can overflow");
     return true;
   }
 
+  if (Unop->isTypeDependent()) {
+    substituteGenericUnop(OperationName, UnopName, Unop->isPrefix(), Unop,
+                          Unop->getSubExpr());
+    return true;
+  }
+
   // check UnopType assumption
   assert(!UnopType.hasQualifiers());
   // remove any typedefs
@@ -141,10 +156,12 @@ bool FindArithmeticUBVisitor::VisitUnaryOperator(UnaryOperator* Unop) {
   SubstitutionASTWrapper(Context_)
       .setLoc(Unop->getBeginLoc())
       .setPrior(SubstPriorityKind::Shallow)
+      .setCheckKind(budget::CheckKind::Arithm)
       .setFormats(Unop->isPrefix() || UnopName == "-" ? UnopName + "#@"
                                                       : "@#" + UnopName,
                   "ASSERT_UNOP(" + OperationName + ", @, " +
-                      UnopType.getAsString() + ")")
+                      UnopType.getAsString() + ", " + getCheckSiteArgs(Unop) +
+                      ")")
       .setArguments(SubExpr)
       .apply();
 
@@ -153,8 +170,7 @@ bool FindArithmeticUBVisitor::VisitUnaryOperator(UnaryOperator* Unop) {
 
 bool FindArithmeticUBVisitor::VisitCompoundAssignOperator(
     CompoundAssignOperator* CompAssignOp) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(
-          CompAssignOp->getBeginLoc()))
+  if (!scope::shouldInstrument(CompAssignOp->getBeginLoc(), Context_))
     return true;
 
   /* for (lhs CompAssignOp rhs): lhs is converted to
@@ -169,16 +185,16 @@ bool FindArithmeticUBVisitor::VisitCompoundAssignOperator(
   QualType CompAssignOpType = CompAssignOp->getType();
   QualType LhsComputationType = CompAssignOp->getComputationLHSType();
 
-  if (CompAssignOpType->isDependentType())
-    return true; // templates are not supported yet
-  if (CompAssignOpType->isFloatingType())
-    return true; // floating point types are not supported yet
-  if (!CompAssignOpType->isFundamentalType())
-    return true; // only fundamental type arithmetic is supported
-  // should be automatically true for LhsComputationType too
-  assert(!LhsComputationType->isDependentType());
-  assert(!LhsComputationType->isFloatingType());
-  assert(LhsComputationType->isFundamentalType());
+  if (!CompAssignOp->isTypeDependent()) {
+    if (CompAssignOpType->isFloatingType())
+      return true; // floating point types are not supported yet
+    if (!CompAssignOpType->isFundamentalType())
+      return true; // only fundamental type arithmetic is supported
+    // should be automatically true for LhsComputationType too
+    assert(!LhsComputationType->isDependentType());
+    assert(!LhsComputationType->isFloatingType());
+    assert(LhsComputationType->isFundamentalType());
+  }
 
   std::string CompAssignOpName = CompAssignOp->getOpcodeStr().str();
   std::string OperationName = "undefined";
@@ -217,6 +233,13 @@ bool FindArithmeticUBVisitor::VisitCompoundAssignOperator(
     return true;
   }
 
+  if (CompAssignOp->isTypeDependent()) {
+    substituteGenericCompAssignOp(OperationName, CompAssignOp->getBeginLoc(),
+                                  CompAssignOp->getLHS(),
+                                  CompAssignOp->getRHS());
+    return true;
+  }
+
   // check CompAssignOpType and LhsComputationType assumption
   assert(!CompAssignOpType.hasQualifiers());
   assert(!LhsComputationType.hasQualifiers());
@@ -246,19 +269,188 @@ bool FindArithmeticUBVisitor::VisitCompoundAssignOperator(
   SubstitutionASTWrapper(Context_)
       .setLoc(CompAssignOp->getBeginLoc())
       .setPrior(SubstPriorityKind::Shallow)
+      .setCheckKind(budget::CheckKind::Arithm)
       .setFormats("@#@", "ASSERT_COMPASSIGNOP(" + OperationName + ", @, @, " +
                              LhsTypeName + ", " +
                              LhsComputationType.getAsString() + ", " +
-                             RhsType.getAsString() + ")")
+                             RhsType.getAsString() + ", " +
+                             getCheckSiteArgs(CompAssignOp) + ")")
       .setArguments(Lhs, Rhs)
       .apply();
   return true;
 }
 
+/* In template patterns operators on dependent operands are either
+ * BinaryOperator/UnaryOperator with dependent type or, if some operator
+ * overloads are visible, CXXOperatorCallExpr with unresolved callee. */
+bool FindArithmeticUBVisitor::VisitCXXOperatorCallExpr(
+    CXXOperatorCallExpr* OpCall) {
+  if (!scope::shouldInstrument(OpCall->getBeginLoc(), Context_))
+    return true;
+  if (!OpCall->isTypeDependent() ||
+      !isa<UnresolvedLookupExpr>(OpCall->getCallee()->IgnoreImpCasts()))
+    return true;
+
+  bool IsBinary = OpCall->getNumArgs() == 2;
+  std::string OperationName = "undefined";
+  switch (OpCall->getOperator()) {
+  case OverloadedOperatorKind::OO_Plus:
+    OperationName = IsBinary ? "Sum" : "undefined";
+    break;
+  case OverloadedOperatorKind::OO_Minus:
+    OperationName = IsBinary ? "Diff" : "UnaryNeg";
+    break;
+  case OverloadedOperatorKind::OO_Star:
+    OperationName = IsBinary ? "Mul" : "undefined";
+    break;
+  case OverloadedOperatorKind::OO_Slash:
+    OperationName = "Div";
+    break;
+  case OverloadedOperatorKind::OO_Percent:
+    OperationName = "Mod";
+    break;
+  case OverloadedOperatorKind::OO_LessLess:
+    OperationName = "BitShiftLeft";
+    break;
+  case OverloadedOperatorKind::OO_GreaterGreater:
+    OperationName = "BitShiftRight";
+    break;
+  case OverloadedOperatorKind::OO_PlusPlus:
+    // postfix form has additional dummy argument
+    substituteGenericUnop(IsBinary ? "PostfixIncr" : "PrefixIncr", "++",
+                          !IsBinary, OpCall, OpCall->getArg(0));
+    return true;
+  case OverloadedOperatorKind::OO_MinusMinus:
+    substituteGenericUnop(IsBinary ? "PostfixDecr" : "PrefixDecr", "--",
+                          !IsBinary, OpCall, OpCall->getArg(0));
+    return true;
+  case OverloadedOperatorKind::OO_PlusEqual:
+  case OverloadedOperatorKind::OO_MinusEqual:
+  case OverloadedOperatorKind::OO_StarEqual:
+  case OverloadedOperatorKind::OO_SlashEqual:
+  case OverloadedOperatorKind::OO_PercentEqual:
+  case OverloadedOperatorKind::OO_LessLessEqual:
+  case OverloadedOperatorKind::OO_GreaterGreaterEqual:
+  case OverloadedOperatorKind::OO_AmpEqual:
+  case OverloadedOperatorKind::OO_PipeEqual:
+  case OverloadedOperatorKind::OO_CaretEqual:
+    substituteGenericCompAssignOp(
+        getCompAssignOperationName(OpCall->getOperator()), OpCall,
+        OpCall->getArg(0), OpCall->getArg(1));
+    return true;
+  default:
+    return true;
+  }
+  if (OperationName == "undefined")
+    return true;
+
+  if (IsBinary)
+    substituteGenericBinop(OperationName, OpCall, OpCall->getArg(0),
+                           OpCall->getArg(1));
+  else
+    substituteGenericUnop(OperationName, "-", /*IsPrefix=*/true, OpCall,
+                          OpCall->getArg(0));
+  return true;
+}
+
+std::string FindArithmeticUBVisitor::getCompAssignOperationName(
+    OverloadedOperatorKind Operator) {
+  switch (Operator) {
+  case OverloadedOperatorKind::OO_PlusEqual:
+    return "Sum";
+  case OverloadedOperatorKind::OO_MinusEqual:
+    return "Diff";
+  case OverloadedOperatorKind::OO_StarEqual:
+    return "Mul";
+  case OverloadedOperatorKind::OO_SlashEqual:
+    return "Div";
+  case OverloadedOperatorKind::OO_PercentEqual:
+    return "Mod";
+  case OverloadedOperatorKind::OO_LessLessEqual:
+    return "BitShiftLeft";
+  case OverloadedOperatorKind::OO_GreaterGreaterEqual:
+    return "BitShiftRight";
+  case OverloadedOperatorKind::OO_AmpEqual:
+    return "LogicAnd";
+  case OverloadedOperatorKind::OO_PipeEqual:
+    return "LogicOr";
+  case OverloadedOperatorKind::OO_CaretEqual:
+    return "LogicXor";
+  default:
+    llvm_unreachable("Not compound assignment operator");
+  }
+}
+
+// column and source text of the check are stored in its site descriptor
+std::string FindArithmeticUBVisitor::getCheckSiteArgs(const Expr* Ex) {
+  unsigned Column =
+      Context_->getSourceManager().getExpansionColumnNumber(Ex->getBeginLoc());
+  return std::to_string(Column) + ", " + getExprAsStringLiteral(Ex, Context_);
+}
+
+/* Lambda of check site descriptor is not allowed in unevaluated operands
+ * until C++20, and nothing is computed there anyway. */
+bool FindArithmeticUBVisitor::TraverseUnaryExprOrTypeTraitExpr(
+    UnaryExprOrTypeTraitExpr*) {
+  return true;
+}
+
+bool FindArithmeticUBVisitor::TraverseCXXNoexceptExpr(CXXNoexceptExpr*) {
+  return true;
+}
+
+bool FindArithmeticUBVisitor::TraverseCXXTypeidExpr(CXXTypeidExpr* Typeid) {
+  return !Typeid->isPotentiallyEvaluated() ||
+         RecursiveASTVisitor<FindArithmeticUBVisitor>::TraverseCXXTypeidExpr(
+             Typeid);
+}
+
+bool FindArithmeticUBVisitor::TraverseDecltypeTypeLoc(DecltypeTypeLoc) {
+  return true;
+}
+
+// operand types are deduced by runtime at each instantiation
+void FindArithmeticUBVisitor::substituteGenericBinop(
+    const std::string& OperationName, Expr* Op, Expr* Lhs, Expr* Rhs) {
+  SubstitutionASTWrapper(Context_)
+      .setLoc(Op->getBeginLoc())
+      .setPrior(SubstPriorityKind::Shallow)
+      .setCheckKind(budget::CheckKind::Arithm)
+      .setFormats("@#@", "ASSERT_BINOP_GENERIC(" + OperationName + ", @, @, " +
+                             getCheckSiteArgs(Op) + ")")
+      .setArguments(Lhs, Rhs)
+      .apply();
+}
+
+void FindArithmeticUBVisitor::substituteGenericUnop(
+    const std::string& OperationName, const std::string& UnopName,
+    bool IsPrefix, Expr* Op, Expr* SubExpr) {
+  SubstitutionASTWrapper(Context_)
+      .setLoc(Op->getBeginLoc())
+      .setPrior(SubstPriorityKind::Shallow)
+      .setCheckKind(budget::CheckKind::Arithm)
+      .setFormats(IsPrefix ? UnopName + "#@" : "@#" + UnopName,
+                  "ASSERT_UNOP_GENERIC(" + OperationName + ", @, " +
+                      getCheckSiteArgs(Op) + ")")
+      .setArguments(SubExpr)
+      .apply();
+}
+
+void FindArithmeticUBVisitor::substituteGenericCompAssignOp(
+    const std::string& OperationName, Expr* Op, Expr* Lhs, Expr* Rhs) {
+  SubstitutionASTWrapper(Context_)
+      .setLoc(Op->getBeginLoc())
+      .setPrior(SubstPriorityKind::Shallow)
+      .setCheckKind(budget::CheckKind::Arithm)
+      .setFormats("@#@", "ASSERT_COMPASSIGNOP_GENERIC(" + OperationName +
+                             ", @, @, " + getCheckSiteArgs(Op) + ")")
+      .setArguments(Lhs, Rhs)
+      .apply();
+}
+
 bool FindArithmeticUBVisitor::VisitImplicitCastExpr(
     ImplicitCastExpr* ImplicitCast) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(
-          ImplicitCast->getBeginLoc()))
+  if (!scope::shouldInstrument(ImplicitCast->getBeginLoc(), Context_))
     return true;
 
   switch (ImplicitCast->getCastKind()) {
@@ -310,8 +502,10 @@ bool FindArithmeticUBVisitor::VisitImplicitCastExpr(
   SubstitutionASTWrapper(Context_)
       .setLoc(ImplicitCast->getBeginLoc())
       .setPrior(SubstPriorityKind::Shallow)
+      .setCheckKind(budget::CheckKind::Arithm)
       .setFormats("#@", "IMPLICIT_CAST(@, " + SubExprTypeAsString + ", " +
-                            ImplicitCastTypeAsString + ")")
+                            ImplicitCastTypeAsString + ", " +
+                            getCheckSiteArgs(ImplicitCast) + ")")
       .setArguments(ImplicitCast)
       .apply();
   return true;
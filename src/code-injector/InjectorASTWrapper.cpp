@@ -72,7 +72,29 @@ void InjectorASTWrapper::addFile(const ASTContext* Context) {
       Filename, generateOutputFilename(Filename)));
 }
 
+void InjectorASTWrapper::setPlanner(
+    std::unique_ptr<budget::InstrumentationPlanner> Planner) {
+  Planner_ = std::move(Planner);
+}
+
+void InjectorASTWrapper::applyPlannedChecks() {
+  if (PlannedChecks_.empty())
+    return;
+  std::vector<bool> IsInstrumented = Planner_->plan(CheckSites_);
+  for (size_t I = 0; I < PlannedChecks_.size(); ++I) {
+    auto& Check = PlannedChecks_[I];
+    if (IsInstrumented[I])
+      InternalInjectors_[Check.InjectorIdx]->substitute(std::move(Check.Subst));
+    else if (Check.Fallback.has_value())
+      InternalInjectors_[Check.InjectorIdx]->substitute(
+          std::move(Check.Fallback.value()));
+  }
+  PlannedChecks_.clear();
+  CheckSites_.clear();
+}
+
 void InjectorASTWrapper::applySubstitutions() {
+  applyPlannedChecks();
   for (auto& Inj : InternalInjectors_)
     Inj->applySubstitutions();
 }
@@ -82,6 +104,23 @@ void InjectorASTWrapper::substitute(Substitution Substr,
   InternalInjectors_.back()->substitute(std::move(Substr));
 }
 
+void InjectorASTWrapper::substituteCheck(Substitution Subst,
+                                         std::optional<Substitution> Fallback,
+                                         budget::CheckKind Kind,
+                                         SourceLocation Loc,
+                                         const clang::ASTContext* Context) {
+  if (!Planner_) {
+    substitute(std::move(Subst), Context);
+    return;
+  }
+  const auto& SrcManager = Context->getSourceManager();
+  SourceLocation SpellingLoc = SrcManager.getSpellingLoc(Loc);
+  CheckSites_.push_back({SrcManager.getFilename(SpellingLoc).str(),
+                         SrcManager.getSpellingLineNumber(SpellingLoc), Kind});
+  PlannedChecks_.push_back(
+      {InternalInjectors_.size() - 1, std::move(Subst), std::move(Fallback)});
+}
+
 void InjectorASTWrapper::substitute(const clang::SourceRange& Range,
                                     std::string NewString,
                                     const clang::ASTContext* Context) {
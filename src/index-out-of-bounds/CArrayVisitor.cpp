@@ -1,13 +1,19 @@
 #include "index-out-of-bounds/CArrayVisitor.h"
 #include "UBUtility.h"
+#include "cli/CLI.h"
 #include "code-injector/InjectorASTWrapper.h"
 #include "index-out-of-bounds/IOBAssertNames.h"
+#include "instrumentation-scope/InstrumentationScope.h"
+#include "pointer-ub/PointerUBAnalysis.h"
+#include "uninit-variables/UninitVarsAnalysis.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Lex/Lexer.h"
+#include <algorithm>
 #include <optional>
 #include <sstream>
 
-// TODO Handle templates instations
+// Template patterns are instrumented once, checkIOB overload is chosen at
+// each instantiation; see CArrayNPointerUBAsserts.h
 // TODO Handle taking address of array
 
 using namespace clang;
@@ -16,10 +22,27 @@ using namespace ub_tester::code_injector::wrapper;
 
 namespace ub_tester {
 
+bool iob::isSubstitutedArray(const Expr* Ex, const ASTContext* Context) {
+  Ex = Ex->IgnoreParenImpCasts();
+  if (const auto* SubscriptExpr = dyn_cast<ArraySubscriptExpr>(Ex))
+    return isSubstitutedArray(SubscriptExpr->getBase(), Context);
+  const ValueDecl* Decl = nullptr;
+  if (const auto* DRExpr = dyn_cast<DeclRefExpr>(Ex))
+    Decl = DRExpr->getDecl();
+  else if (const auto* MembExpr = dyn_cast<MemberExpr>(Ex))
+    Decl = MembExpr->getMemberDecl();
+  if (!Decl || Decl->isImplicit() ||
+      !(isa<VarDecl>(Decl) || isa<FieldDecl>(Decl)) ||
+      !scope::shouldInstrument(Decl->getBeginLoc(), Context))
+    return false;
+  return !Decl->getType()->isPointerType() ||
+         !ptr::analysis::isKeptRaw(cast<DeclaratorDecl>(Decl), Context);
+}
+
 void CArrayVisitor::ArrayInfo_t::reset() {
   Init_ = std::nullopt;
   ShouldVisitNodes_ = IsIncompleteType_ = false;
-  ShouldVisitImplicitCode_ = false;
+  ShouldVisitImplicitCode_ = IsVariableSize_ = false;
   Dimension_ = 0;
   Sizes_.clear();
 }
@@ -42,8 +65,10 @@ bool CArrayVisitor::VisitConstantArrayType(ConstantArrayType* Type) {
 }
 
 bool CArrayVisitor::VisitVariableArrayType(VariableArrayType* Type) {
-  if (Array_.ShouldVisitNodes_)
+  if (Array_.ShouldVisitNodes_) {
     Array_.Sizes_.push_back(getExprAsString(Type->getSizeExpr(), Context_));
+    Array_.IsVariableSize_ = true;
+  }
   return true;
 }
 
@@ -55,7 +80,7 @@ bool CArrayVisitor::VisitIncompleteArrayType(IncompleteArrayType* Type) {
 
 bool CArrayVisitor::VisitInitListExpr(InitListExpr* List) {
   Array_.ShouldVisitImplicitCode_ = true;
-  if (!Context_->getSourceManager().isWrittenInMainFile(List->getBeginLoc()))
+  if (!scope::shouldInstrument(List->getBeginLoc(), Context_))
     return true;
 
   if (List->isSemanticForm() && List->isSyntacticForm())
@@ -88,19 +113,23 @@ bool CArrayVisitor::VisitStringLiteral(StringLiteral* Literal) {
   return true;
 }
 
+// constant sizes are template arguments of safe array and are not checked
 std::pair<std::string, std::string> CArrayVisitor::getCtorFormats() {
   std::string SourceFormat = Array_.Init_.has_value() ? "#@" : "";
   std::stringstream OutputFormat;
   OutputFormat << "("
                << iob::names_to_inject::generateSafeArrayCtor(
-                      Array_.Sizes_, Array_.Init_.has_value()
-                                         ? std::optional("@")
-                                         : std::nullopt)
+                      Array_.IsVariableSize_ ? Array_.Sizes_
+                                             : std::vector<std::string>{},
+                      Array_.Init_.has_value() ? std::optional("@")
+                                               : std::nullopt)
                << ")";
   return {SourceFormat, OutputFormat.str()};
 }
 
 void CArrayVisitor::executeSubstitutionOfCtor(VarDecl* VDecl) {
+  if (!Array_.IsVariableSize_ && !Array_.Init_.has_value())
+    return;
   SourceLocation Loc = getAfterNameLoc(VDecl, Context_);
   std::pair<std::string, std::string> Formats = getCtorFormats();
   SubstitutionASTWrapper(Context_)
@@ -110,10 +139,10 @@ void CArrayVisitor::executeSubstitutionOfCtor(VarDecl* VDecl) {
       .apply();
 }
 
+// declarations out of scope are kept, their initializers are still visited
 bool CArrayVisitor::TraverseVarDecl(VarDecl* VDecl) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(VDecl->getBeginLoc()))
-    return true;
   Array_.ShouldVisitNodes_ =
+      scope::shouldInstrument(VDecl->getBeginLoc(), Context_) &&
       !isa<ParmVarDecl>(VDecl) && VDecl->getType()->isArrayType();
   RecursiveASTVisitor<CArrayVisitor>::TraverseVarDecl(VDecl);
   if (Array_.ShouldVisitNodes_) {
@@ -133,16 +162,233 @@ void CArrayVisitor::executeSubstitutionOfSubscript(
   std::pair<std::string, std::string> Formats = getSubscriptFormats();
   SubstitutionASTWrapper(Context_)
       .setLoc(BeginLoc)
+      .setCheckKind(budget::CheckKind::IOB)
       .setFormats(Formats.first, Formats.second)
       .setArguments(SubscriptExpr->getLHS(), SubscriptExpr->getRHS())
       .apply();
 }
 
+std::pair<std::string, std::string>
+CArrayVisitor::getMultiSubscriptFormats(size_t NumIndices) {
+  std::string SourceFormat = "@";
+  std::vector<std::string> Indices;
+  for (size_t I = 0; I < NumIndices; ++I) {
+    SourceFormat += "[@]";
+    Indices.emplace_back("(@)");
+  }
+  return {SourceFormat,
+          iob::names_to_inject::generateIOBMultiAssertName("@", Indices)};
+}
+
+// Subscripts of multi-dimensional array from innermost to outermost one,
+// empty if rows are not arrays (e.g. array of pointers)
+std::vector<ArraySubscriptExpr*>
+CArrayVisitor::getSubscriptChain(ArraySubscriptExpr* SubscriptExpr) {
+  std::vector<ArraySubscriptExpr*> Chain;
+  for (ArraySubscriptExpr* Cur = SubscriptExpr;
+       Cur && Cur->getBase() == Cur->getLHS();
+       Cur = dyn_cast<ArraySubscriptExpr>(Cur->getLHS()->IgnoreImpCasts())) {
+    if (!Chain.empty() && !Cur->getType()->isArrayType())
+      break;
+    Chain.push_back(Cur);
+  }
+  if (Chain.size() < 2 ||
+      !Chain.back()->getLHS()->IgnoreImpCasts()->getType()->isArrayType())
+    return {};
+  std::reverse(Chain.begin(), Chain.end());
+  return Chain;
+}
+
+void CArrayVisitor::executeSubstitutionOfMultiSubscript(
+    const std::vector<ArraySubscriptExpr*>& Chain) {
+  std::vector<const Expr*> Indices;
+  for (ArraySubscriptExpr* SubscriptExpr : Chain) {
+    Indices.push_back(SubscriptExpr->getRHS());
+    FusedSubscripts_.insert(SubscriptExpr);
+  }
+  std::pair<std::string, std::string> Formats =
+      getMultiSubscriptFormats(Indices.size());
+  SubstitutionASTWrapper(Context_)
+      .setLoc(Chain.back()->getBeginLoc())
+      .setCheckKind(budget::CheckKind::IOB)
+      .setFormats(Formats.first, Formats.second)
+      .setArguments(Chain.front()->getLHS(), Indices)
+      .apply();
+}
+
+bool CArrayVisitor::isSubscriptBase(const ImplicitCastExpr* Decay) {
+  for (const auto& Parent : Context_->getParents(*Decay))
+    if (const auto* SubscriptExpr = Parent.get<ArraySubscriptExpr>())
+      return SubscriptExpr->getBase() == Decay;
+  return false;
+}
+
+void CArrayVisitor::executeSubstitutionOfDecay(ImplicitCastExpr* Decay) {
+  SubstitutionASTWrapper(Context_)
+      .setLoc(Decay->getBeginLoc())
+      .setFormats("@", "(@).data()")
+      .setArguments(Decay->getSubExpr())
+      .apply();
+}
+
+// safe arrays decay to pointers to their elements only by data(), subscripts
+// are checked by ASSERT_IOB instead; decays out of scope are rewritten too
+bool CArrayVisitor::VisitImplicitCastExpr(ImplicitCastExpr* ImplicitCast) {
+  if (ImplicitCast->getCastKind() != CastKind::CK_ArrayToPointerDecay ||
+      !scope::isInMainFile(ImplicitCast->getBeginLoc(), Context_))
+    return true;
+  if (iob::isSubstitutedArray(ImplicitCast->getSubExpr(), Context_) &&
+      !isSubscriptBase(ImplicitCast) && !isCheckedLibcCallArg(ImplicitCast))
+    executeSubstitutionOfDecay(ImplicitCast);
+  return true;
+}
+
+/* Buffer is a one-dimensional safe array or a safe pointer, whose size is
+ * known to checker. Rows of arrays with tracked elements are not laid out as
+ * in C arrays, so multi-dimensional arrays decay as usual. */
+bool CArrayVisitor::isCheckedBuffer(const Expr* Arg) {
+  const Expr* Buffer = Arg->IgnoreParenImpCasts();
+  if (const auto* ArrType = Context_->getAsArrayType(Buffer->getType()))
+    return !ArrType->getElementType()->isArrayType() &&
+           iob::isSubstitutedArray(Buffer, Context_);
+  return Buffer->getType()->isPointerType() &&
+         (isa<DeclRefExpr>(Buffer) || isa<MemberExpr>(Buffer)) &&
+         iob::isSubstitutedArray(Buffer, Context_);
+}
+
+// call is replaced if some of its buffers is instrumented
+bool CArrayVisitor::isCheckedLibcCall(const CallExpr* Call) {
+  const FunctionDecl* Callee = Call->getDirectCallee();
+  if (!Callee || !Callee->isExternC() || !Callee->getIdentifier())
+    return false;
+  const auto& Funcs = iob::names_to_inject::CheckedLibcFuncs;
+  if (std::find(Funcs.begin(), Funcs.end(), Callee->getName().str()) ==
+      Funcs.end())
+    return false;
+  return std::any_of(Call->arg_begin(), Call->arg_end(),
+                     [this](const Expr* Arg) { return isCheckedBuffer(Arg); });
+}
+
+// arrays passed to checkers do not decay, their sizes are checked
+bool CArrayVisitor::isCheckedLibcCallArg(const ImplicitCastExpr* Decay) {
+  for (const Stmt* Child = Decay;;) {
+    const auto Parents = Context_->getParents(*Child);
+    const Stmt* Parent = Parents.empty() ? nullptr : Parents[0].get<Stmt>();
+    if (const auto* Call = dyn_cast_or_null<CallExpr>(Parent))
+      return isCheckedBuffer(Decay) &&
+             scope::shouldInstrument(Call->getBeginLoc(), Context_) &&
+             isCheckedLibcCall(Call) &&
+             std::find(Call->arg_begin(), Call->arg_end(), Child) !=
+                 Call->arg_end();
+    if (!isa_and_nonnull<ImplicitCastExpr>(Parent) &&
+        !isa_and_nonnull<ParenExpr>(Parent))
+      return false;
+    Child = Parent;
+  }
+}
+
+void CArrayVisitor::executeSubstitutionOfLibcCall(CallExpr* Call) {
+  std::string SourceFormat = "(" + std::string(Call->getNumArgs(), '@') + ")";
+  SubstitutionASTWrapper(Context_)
+      .setLoc(Call->getBeginLoc())
+      .setFormats(SourceFormat,
+                  iob::names_to_inject::generateLibcCallAssertName(
+                      Call->getDirectCallee()->getName().str(),
+                      Call->getNumArgs()))
+      .setArguments(
+          std::vector<const Expr*>(Call->arg_begin(), Call->arg_end()))
+      .apply();
+}
+
+// the whole range is validated once, then libc function runs on raw storage
+bool CArrayVisitor::VisitCallExpr(CallExpr* Call) {
+  if (!scope::shouldInstrument(Call->getBeginLoc(), Context_))
+    return true;
+  if (isCheckedLibcCall(Call))
+    executeSubstitutionOfLibcCall(Call);
+  return true;
+}
+
+/* Loop variable is a copy or a const reference, so elements of array are
+ * only read. Rows of multi-dimensional arrays are iterated as usual. */
+bool CArrayVisitor::isRangeReadOfTrackedArray(
+    const CXXForRangeStmt* RangeFor) {
+  QualType VarType = RangeFor->getLoopVariable()->getType();
+  if (VarType->isReferenceType() &&
+      !VarType.getNonReferenceType().isConstQualified())
+    return false;
+  const Expr* Range = RangeFor->getRangeInit();
+  const auto* ArrType = Context_->getAsArrayType(Range->getType());
+  return ArrType &&
+         uninit::analysis::isTrackedElementType(ArrType->getElementType()) &&
+         iob::isSubstitutedArray(Range, Context_);
+}
+
+void CArrayVisitor::executeSubstitutionOfRangeRead(CXXForRangeStmt* RangeFor) {
+  SubstitutionASTWrapper(Context_)
+      .setLoc(RangeFor->getRangeInit()->getBeginLoc())
+      .setCheckKind(budget::CheckKind::Uninit)
+      .setFormats("@", "ASSERT_CARRAY_RANGE_READ(@)")
+      .setArguments(RangeFor->getRangeInit())
+      .apply();
+}
+
+// mutable begin() of safe array marks all of its elements initialized
+bool CArrayVisitor::VisitCXXForRangeStmt(CXXForRangeStmt* RangeFor) {
+  if (!scope::shouldInstrument(RangeFor->getBeginLoc(), Context_))
+    return true;
+  if (isRangeReadOfTrackedArray(RangeFor))
+    executeSubstitutionOfRangeRead(RangeFor);
+  return true;
+}
+
+// size of array or of its element, whose type has tracked elements
+bool CArrayVisitor::isSizeOfSubstitutedArray(
+    const UnaryExprOrTypeTraitExpr* SizeOf) {
+  if (SizeOf->getKind() != UETT_SizeOf || SizeOf->isArgumentType())
+    return false;
+  const Expr* Arg = SizeOf->getArgumentExpr()->IgnoreParens();
+  const Expr* Array = Arg;
+  if (const auto* SubscriptExpr = dyn_cast<ArraySubscriptExpr>(Arg))
+    Array = SubscriptExpr->getBase()->IgnoreParenImpCasts();
+  const auto* ArrType = Context_->getAsArrayType(Array->getType());
+  if (!ArrType)
+    return false;
+  QualType ElementType = ArrType->getElementType();
+  while (const auto* Row = Context_->getAsArrayType(ElementType))
+    ElementType = Row->getElementType();
+  return uninit::analysis::isTrackedElementType(ElementType) &&
+         iob::isSubstitutedArray(Array, Context_);
+}
+
+void CArrayVisitor::executeSubstitutionOfSizeOf(
+    UnaryExprOrTypeTraitExpr* SizeOf) {
+  SubstitutionASTWrapper(Context_)
+      .setLoc(SizeOf->getBeginLoc())
+      .setFormats("sizeof@", "SIZEOF_CARRAY(@)")
+      .setArguments(SizeOf->getArgumentExpr())
+      .apply();
+}
+
+// init bits of tracked elements are stored in safe array, so its size is
+// computed from type of C array, wherever array is used
+bool CArrayVisitor::VisitUnaryExprOrTypeTraitExpr(
+    UnaryExprOrTypeTraitExpr* SizeOf) {
+  if (!scope::isInMainFile(SizeOf->getBeginLoc(), Context_))
+    return true;
+  if (isSizeOfSubstitutedArray(SizeOf))
+    executeSubstitutionOfSizeOf(SizeOf);
+  return true;
+}
+
 bool CArrayVisitor::VisitArraySubscriptExpr(ArraySubscriptExpr* SubscriptExpr) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(
-          SubscriptExpr->getBeginLoc()))
+  if (!scope::shouldInstrument(SubscriptExpr->getBeginLoc(), Context_) ||
+      FusedSubscripts_.count(SubscriptExpr))
     return true;
-  executeSubstitutionOfSubscript(SubscriptExpr);
+  if (auto Chain = getSubscriptChain(SubscriptExpr); !Chain.empty())
+    executeSubstitutionOfMultiSubscript(Chain);
+  else
+    executeSubstitutionOfSubscript(SubscriptExpr);
   return true;
 }
 
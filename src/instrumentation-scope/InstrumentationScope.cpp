@@ -0,0 +1,209 @@
+#include "instrumentation-scope/InstrumentationScope.h"
+#include "clang/AST/Attr.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/Support/GlobPattern.h"
+#include "llvm/Support/Path.h"
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+using namespace clang;
+using namespace llvm;
+
+namespace ub_tester::scope {
+
+namespace {
+
+constexpr char OffAnnotation[] = "ub_tester_off";
+constexpr char OffComment[] = "ub-tester: off";
+constexpr char OnComment[] = "ub-tester: on";
+
+struct Filter {
+  std::vector<GlobPattern> Allowed, Skipped;
+};
+
+Filter FilesFilter, FuncsFilter;
+
+// file offsets, both ends included
+using Region = std::pair<unsigned, unsigned>;
+std::unordered_map<std::string, std::vector<Region>> ExcludedRegions;
+std::unordered_set<std::string> ExcludedFiles;
+
+Error createPatterns(const std::vector<std::string>& Globs,
+                     std::vector<GlobPattern>& Patterns) {
+  for (const auto& Glob : Globs) {
+    Expected<GlobPattern> Pattern = GlobPattern::create(Glob);
+    if (!Pattern)
+      return Pattern.takeError();
+    Patterns.push_back(std::move(Pattern.get()));
+  }
+  return Error::success();
+}
+
+bool matchesAny(const std::vector<GlobPattern>& Patterns, StringRef Name) {
+  for (const auto& Pattern : Patterns)
+    if (Pattern.match(Name))
+      return true;
+  return false;
+}
+
+bool isAllowed(const Filter& NameFilter, StringRef Name) {
+  return (NameFilter.Allowed.empty() ||
+          matchesAny(NameFilter.Allowed, Name)) &&
+         !matchesAny(NameFilter.Skipped, Name);
+}
+
+bool matchesFile(const std::vector<GlobPattern>& Patterns,
+                 StringRef Filename) {
+  return matchesAny(Patterns, Filename) ||
+         matchesAny(Patterns, sys::path::filename(Filename));
+}
+
+bool isFileInstrumented(StringRef Filename) {
+  return (FilesFilter.Allowed.empty() ||
+          matchesFile(FilesFilter.Allowed, Filename)) &&
+         !matchesFile(FilesFilter.Skipped, Filename);
+}
+
+bool hasOffAnnotation(const Decl* D) {
+  for (const auto* Annotation : D->specific_attrs<AnnotateAttr>())
+    if (Annotation->getAnnotation() == OffAnnotation)
+      return true;
+  return false;
+}
+
+std::string getMainFilename(const SourceManager& SrcManager) {
+  return SrcManager.getFileEntryForID(SrcManager.getMainFileID())
+      ->getName()
+      .str();
+}
+
+void collectOffCommentRegions(StringRef Buffer, std::vector<Region>& Regions) {
+  std::optional<unsigned> OffBegin;
+  for (size_t LineBegin = 0; LineBegin < Buffer.size();) {
+    size_t LineEnd = std::min(Buffer.find('\n', LineBegin), Buffer.size());
+    StringRef Line = Buffer.slice(LineBegin, LineEnd);
+    if (size_t CommentPos = Line.find("//"); CommentPos != StringRef::npos) {
+      StringRef Comment = Line.drop_front(CommentPos + 2).trim();
+      if (Comment == OffComment && !OffBegin.has_value())
+        OffBegin = LineBegin;
+      else if (Comment == OnComment && OffBegin.has_value()) {
+        Regions.emplace_back(OffBegin.value(), LineEnd);
+        OffBegin.reset();
+      }
+    }
+    LineBegin = LineEnd + 1;
+  }
+  if (OffBegin.has_value())
+    Regions.emplace_back(OffBegin.value(), Buffer.size());
+}
+
+} // namespace
+
+Error setUpFilters(const std::vector<std::string>& InstrumentedFiles,
+                   const std::vector<std::string>& SkippedFiles,
+                   const std::vector<std::string>& InstrumentedFuncs,
+                   const std::vector<std::string>& SkippedFuncs) {
+  if (Error Err = createPatterns(InstrumentedFiles, FilesFilter.Allowed))
+    return Err;
+  if (Error Err = createPatterns(SkippedFiles, FilesFilter.Skipped))
+    return Err;
+  if (Error Err = createPatterns(InstrumentedFuncs, FuncsFilter.Allowed))
+    return Err;
+  return createPatterns(SkippedFuncs, FuncsFilter.Skipped);
+}
+
+bool shouldInstrument(SourceLocation Loc, const ASTContext* Context) {
+  const auto& SrcManager = Context->getSourceManager();
+  if (!SrcManager.isWrittenInMainFile(Loc))
+    return false;
+  std::string Filename = getMainFilename(SrcManager);
+  if (ExcludedFiles.find(Filename) != ExcludedFiles.end())
+    return false;
+  auto It = ExcludedRegions.find(Filename);
+  if (It == ExcludedRegions.end())
+    return true;
+  unsigned Offset = SrcManager.getFileOffset(Loc);
+  for (const auto& [Begin, End] : It->second)
+    if (Begin <= Offset && Offset <= End)
+      return false;
+  return true;
+}
+
+bool isInMainFile(SourceLocation Loc, const ASTContext* Context) {
+  return Context->getSourceManager().isWrittenInMainFile(Loc);
+}
+
+bool isExcluded(const Decl* D, const ASTContext* Context) {
+  return D &&
+         Context->getSourceManager().isWrittenInMainFile(D->getLocation()) &&
+         !shouldInstrument(D->getLocation(), Context);
+}
+
+bool hasCodeToInstrument(const ASTContext* Context) {
+  const auto& SrcManager = Context->getSourceManager();
+  std::string Filename = getMainFilename(SrcManager);
+  if (ExcludedFiles.find(Filename) != ExcludedFiles.end())
+    return false;
+  size_t BufferSize =
+      SrcManager.getBufferData(SrcManager.getMainFileID()).size();
+  for (const auto& [Begin, End] : ExcludedRegions[Filename])
+    if (Begin == 0 && End >= BufferSize)
+      return false;
+  return true;
+}
+
+InstrumentationScopeVisitor::InstrumentationScopeVisitor(ASTContext* Context)
+    : Context_(Context) {}
+
+void InstrumentationScopeVisitor::excludeRange(SourceRange Range) {
+  const auto& SrcManager = Context_->getSourceManager();
+  SourceLocation Begin = SrcManager.getExpansionLoc(Range.getBegin());
+  SourceLocation End = SrcManager.getExpansionLoc(Range.getEnd());
+  if (!SrcManager.isWrittenInMainFile(Begin) ||
+      !SrcManager.isWrittenInMainFile(End))
+    return;
+  ExcludedRegions[getMainFilename(SrcManager)].emplace_back(
+      SrcManager.getFileOffset(Begin), SrcManager.getFileOffset(End));
+}
+
+bool InstrumentationScopeVisitor::VisitDecl(Decl* D) {
+  if (!isa<FunctionDecl>(D) && hasOffAnnotation(D))
+    excludeRange(D->getSourceRange());
+  return true;
+}
+
+bool InstrumentationScopeVisitor::VisitFunctionDecl(FunctionDecl* FuncDecl) {
+  // lambdas and local classes follow enclosing function
+  if (!Context_->getSourceManager().isWrittenInMainFile(
+          FuncDecl->getBeginLoc()) ||
+      !FuncDecl->doesThisDeclarationHaveABody() ||
+      FuncDecl->getParentFunctionOrMethod() || FuncDecl->isImplicit())
+    return true;
+  if (isAllowed(FuncsFilter, FuncDecl->getQualifiedNameAsString()) &&
+      !hasOffAnnotation(FuncDecl))
+    return true;
+  // parameters must keep the same types in every redeclaration
+  for (const FunctionDecl* Redecl : FuncDecl->redecls())
+    excludeRange(Redecl->getSourceRange());
+  return true;
+}
+
+InstrumentationScopeConsumer::InstrumentationScopeConsumer(ASTContext* Context)
+    : ScopeVisitor_(Context) {}
+
+void InstrumentationScopeConsumer::HandleTranslationUnit(ASTContext& Context) {
+  const auto& SrcManager = Context.getSourceManager();
+  std::string Filename = getMainFilename(SrcManager);
+  if (!isFileInstrumented(Filename)) {
+    ExcludedFiles.insert(std::move(Filename));
+    return;
+  }
+  collectOffCommentRegions(SrcManager.getBufferData(SrcManager.getMainFileID()),
+                           ExcludedRegions[Filename]);
+  ScopeVisitor_.TraverseDecl(Context.getTranslationUnitDecl());
+}
+
+} // namespace ub_tester::scope
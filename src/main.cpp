@@ -12,11 +12,17 @@
 #include "cli/CLI.h"
 #include "code-injector/InjectorASTWrapper.h"
 #include "index-out-of-bounds/FindIOBConsumer.h"
+#include "instrumentation-scope/InstrumentationScope.h"
+#include "overhead-budget/InstrumentationPlanner.h"
+#include "overhead-budget/Profile.h"
 #include "pointer-ub/FindPointerUBConsumer.h"
+#include "pointer-ub/PointerUBAnalysis.h"
 #include "type-substituter/TypeSubstituterConsumer.h"
+#include "uninit-variables/UninitVarsAnalysis.h"
 #include "uninit-variables/UninitVarsDetection.h"
 
 #include <iostream>
+#include <optional>
 #include <vector>
 
 using namespace clang;
@@ -38,6 +44,16 @@ bool RunArithm;
 bool RunUninit;
 bool SuppressWarnings;
 bool SuppressAllOutput;
+bool AllocRegistry;
+UninitBackendKind UninitBackend;
+std::string ProfileFilename;
+std::string OverheadBudget;
+std::vector<std::string> InstrumentedFiles;
+std::vector<std::string> SkippedFiles;
+std::vector<std::string> InstrumentedFuncs;
+std::vector<std::string> SkippedFuncs;
+std::vector<std::string> SuppressedWarnings;
+std::vector<std::string> DisabledChecks;
 
 namespace internal {
 
@@ -68,6 +84,75 @@ static cl::opt<bool, true>
 static cl::alias SuppressAllOutputFlagAlias("q", cl::desc("Alias for -quiet"),
                                             cl::aliasopt(SuppressAllOutputFlag),
                                             cl::cat(UBTesterOptionsCategory));
+
+static cl::opt<bool, true> AllocRegistryFlag(
+    "alloc-registry",
+    cl::desc("Register heap blocks of instrumented program (glibc), so that "
+             "accesses by untracked pointers are checked against them"),
+    cl::location(AllocRegistry), cl::init(false),
+    cl::cat(UBTesterOptionsCategory));
+
+static cl::opt<UninitBackendKind, true> UninitBackendOption(
+    "uninit-backend", cl::desc("How uninitialized variables are tracked"),
+    cl::values(clEnumValN(UninitBackendKind::Wrapper, "wrapper",
+                          "Substitute UBSafeType for builtin types"),
+               clEnumValN(UninitBackendKind::Shadow, "shadow",
+                          "Keep original types, track local variables in "
+                          "shadow memory")),
+    cl::location(UninitBackend), cl::init(UninitBackendKind::Wrapper),
+    cl::cat(UBTesterOptionsCategory));
+
+static cl::opt<std::string, true> ProfileOption(
+    "profile",
+    cl::desc("Profile of the program (perf script output or per-line "
+             "counters) to choose checks under -overhead-budget"),
+    cl::value_desc("filename"), cl::location(ProfileFilename),
+    cl::cat(UBTesterOptionsCategory));
+static cl::opt<std::string, true> OverheadBudgetOption(
+    "overhead-budget",
+    cl::desc("Estimated overhead checks may add, hottest checks are left out "
+             "(used with -profile)"),
+    cl::value_desc("percent"), cl::location(OverheadBudget), cl::init("10%"),
+    cl::cat(UBTesterOptionsCategory));
+
+using GlobsOption = cl::list<std::string, std::vector<std::string>>;
+static GlobsOption InstrumentedFilesOption(
+    "instrument-files",
+    cl::desc("Only instrument files matching one of the globs"),
+    cl::value_desc("globs"), cl::CommaSeparated,
+    cl::location(InstrumentedFiles), cl::cat(UBTesterOptionsCategory));
+static GlobsOption SkippedFilesOption(
+    "skip-files", cl::desc("Leave files matching one of the globs as is"),
+    cl::value_desc("globs"), cl::CommaSeparated, cl::location(SkippedFiles),
+    cl::cat(UBTesterOptionsCategory));
+static GlobsOption InstrumentedFuncsOption(
+    "instrument-functions",
+    cl::desc("Only instrument functions whose qualified names match one of "
+             "the globs"),
+    cl::value_desc("globs"), cl::CommaSeparated,
+    cl::location(InstrumentedFuncs), cl::cat(UBTesterOptionsCategory));
+static GlobsOption SkippedFuncsOption(
+    "skip-functions",
+    cl::desc("Leave functions whose qualified names match one of the globs "
+             "as is"),
+    cl::value_desc("globs"), cl::CommaSeparated, cl::location(SkippedFuncs),
+    cl::cat(UBTesterOptionsCategory));
+
+using NamesOption = cl::list<std::string, std::vector<std::string>>;
+static NamesOption SuppressedWarningsOption(
+    "suppress",
+    cl::desc("Do not report warnings of the categories: arithm, "
+             "unsigned-overflow, bitshift-cxx20, unsafe-conv, "
+             "impl-defined-conv, uninit, ptr, impl-defined, not-considered; "
+             "checks that can only report them are not compiled"),
+    cl::value_desc("categories"), cl::CommaSeparated,
+    cl::location(SuppressedWarnings), cl::cat(UBTesterOptionsCategory));
+static NamesOption DisabledChecksOption(
+    "disable-checks",
+    cl::desc("Do not compile arithmetic checks of the operations: sum, diff, "
+             "mul, div, mod, shl, shr, neg, incr-decr, cast"),
+    cl::value_desc("operations"), cl::CommaSeparated,
+    cl::location(DisabledChecks), cl::cat(UBTesterOptionsCategory));
 } // namespace internal
 } // namespace cli
 
@@ -77,6 +162,9 @@ public:
   CreateASTConsumer(clang::CompilerInstance& Compiler, llvm::StringRef InFile) {
 
     InjectorASTWrapper::getInstance().addFile(&Compiler.getASTContext());
+    // output file is still generated, but without changes
+    if (!scope::hasCodeToInstrument(&Compiler.getASTContext()))
+      return std::make_unique<ASTConsumer>();
     std::unique_ptr<ASTConsumer> IOBConsumer =
         std::make_unique<FindIOBConsumer>(&Compiler.getASTContext());
     std::unique_ptr<ASTConsumer> UninitVarsConsumer =
@@ -107,11 +195,57 @@ class UBTesterUtilityAction : public ASTFrontendAction {
 public:
   virtual std::unique_ptr<clang::ASTConsumer>
   CreateASTConsumer(clang::CompilerInstance& Compiler, llvm::StringRef InFile) {
-    return std::make_unique<util::func_code_avail::UtilityConsumer>(
-        &Compiler.getASTContext());
+    std::vector<std::unique_ptr<ASTConsumer>> consumers;
+    // must go first, analyses below depend on it
+    consumers.emplace_back(
+        std::make_unique<scope::InstrumentationScopeConsumer>(
+            &Compiler.getASTContext()));
+    consumers.emplace_back(
+        std::make_unique<util::func_code_avail::UtilityConsumer>(
+            &Compiler.getASTContext()));
+    if (cli::RunIOB)
+      consumers.emplace_back(
+          std::make_unique<ptr::analysis::PointerUBAnalysisConsumer>(
+              &Compiler.getASTContext()));
+    if (cli::RunUninit)
+      consumers.emplace_back(
+          std::make_unique<uninit::analysis::UninitVarsAnalysisConsumer>(
+              &Compiler.getASTContext()));
+
+    return std::make_unique<MultiplexConsumer>(std::move(consumers));
   }
 };
 
+void setUpInstrumentationScope() {
+  if (llvm::Error Err = scope::setUpFilters(
+          cli::InstrumentedFiles, cli::SkippedFiles, cli::InstrumentedFuncs,
+          cli::SkippedFuncs)) {
+    std::cerr << "Invalid pattern: " << llvm::toString(std::move(Err))
+              << "\n";
+    exit(1);
+  }
+}
+
+void setUpOverheadBudget() {
+  if (cli::ProfileFilename.empty())
+    return;
+  std::optional<budget::Profile> Prof =
+      budget::Profile::load(cli::ProfileFilename);
+  if (!Prof.has_value()) {
+    std::cerr << "Failed to read profile " << cli::ProfileFilename << "\n";
+    exit(1);
+  }
+  std::optional<double> Budget =
+      budget::parseOverheadBudget(cli::OverheadBudget);
+  if (!Budget.has_value()) {
+    std::cerr << "Invalid overhead budget " << cli::OverheadBudget << "\n";
+    exit(1);
+  }
+  InjectorASTWrapper::getInstance().setPlanner(
+      std::make_unique<budget::InstrumentationPlanner>(std::move(Prof.value()),
+                                                       Budget.value()));
+}
+
 } // namespace ub_tester
 
 void UBTesterVersionPrinter(raw_ostream& OStream) {
@@ -131,6 +265,8 @@ int main(int argc, const char** argv) {
   CommonOptionsParser OptionsParser(argc, argv, UBTesterOptionsCategory,
                                     cl::ZeroOrMore);
   ub_tester::cli::processFlags();
+  ub_tester::setUpInstrumentationScope();
+  ub_tester::setUpOverheadBudget();
 
   ClangTool Tool(OptionsParser.getCompilations(),
                  OptionsParser.getSourcePathList());
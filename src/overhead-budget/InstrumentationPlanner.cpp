@@ -0,0 +1,100 @@
+#include "overhead-budget/InstrumentationPlanner.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <numeric>
+
+using namespace llvm;
+
+namespace ub_tester::budget {
+
+namespace {
+
+// rough slowdown a single check adds to execution of its line
+double getRelativeCost(CheckKind Kind) {
+  switch (Kind) {
+  case CheckKind::Arithm:
+    return 1.5;
+  case CheckKind::IOB:
+    return 1.0;
+  case CheckKind::Pointer:
+    return 0.5;
+  case CheckKind::Uninit:
+    return 0.3;
+  }
+  return 1.0;
+}
+
+const char* getCheckKindAsString(CheckKind Kind) {
+  switch (Kind) {
+  case CheckKind::Arithm:
+    return "arithmetic";
+  case CheckKind::IOB:
+    return "index-out-of-bounds";
+  case CheckKind::Pointer:
+    return "pointer";
+  case CheckKind::Uninit:
+    return "uninit";
+  }
+  return "unknown";
+}
+
+} // namespace
+
+std::optional<double> parseOverheadBudget(StringRef Budget) {
+  Budget = Budget.trim();
+  Budget.consume_back("%");
+  double Percent = 0;
+  if (Budget.getAsDouble(Percent) || Percent < 0)
+    return std::nullopt;
+  return Percent;
+}
+
+InstrumentationPlanner::InstrumentationPlanner(Profile Prof,
+                                               double BudgetInPercent)
+    : Profile_{std::move(Prof)}, BudgetInPercent_{BudgetInPercent} {}
+
+std::vector<bool>
+InstrumentationPlanner::plan(const std::vector<CheckSite>& Sites) const {
+  std::vector<double> Overheads(Sites.size());
+  for (size_t I = 0; I < Sites.size(); ++I)
+    Overheads[I] = 100 *
+                   Profile_.getLineWeight(Sites[I].Filename, Sites[I].Line) *
+                   getRelativeCost(Sites[I].Kind);
+
+  std::vector<size_t> HottestFirst(Sites.size());
+  std::iota(HottestFirst.begin(), HottestFirst.end(), 0);
+  std::stable_sort(HottestFirst.begin(), HottestFirst.end(),
+                   [&Overheads](size_t Lhs, size_t Rhs) {
+                     return Overheads[Lhs] > Overheads[Rhs];
+                   });
+
+  std::vector<bool> IsInstrumented(Sites.size(), true);
+  double TotalOverhead =
+      std::accumulate(Overheads.begin(), Overheads.end(), 0.0);
+  for (size_t I : HottestFirst) {
+    if (TotalOverhead <= BudgetInPercent_ || Overheads[I] == 0)
+      break;
+    IsInstrumented[I] = false;
+    TotalOverhead -= Overheads[I];
+  }
+
+  for (size_t I : HottestFirst) {
+    if (Overheads[I] == 0)
+      break;
+    errs() << "ub-tester: " << Sites[I].Filename << ":" << Sites[I].Line
+           << ": " << getCheckKindAsString(Sites[I].Kind) << " check "
+           << (IsInstrumented[I] ? "instrumented" : "left out")
+           << " (estimated overhead " << format("%.2f", Overheads[I])
+           << "%)\n";
+  }
+  size_t LeftOut =
+      std::count(IsInstrumented.begin(), IsInstrumented.end(), false);
+  errs() << "ub-tester: " << Sites.size() - LeftOut << " of " << Sites.size()
+         << " checks instrumented, estimated overhead "
+         << format("%.2f", TotalOverhead) << "% (budget "
+         << format("%.2f", BudgetInPercent_) << "%)\n";
+  return IsInstrumented;
+}
+
+} // namespace ub_tester::budget
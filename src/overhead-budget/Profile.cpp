@@ -0,0 +1,122 @@
+#include "overhead-budget/Profile.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include <algorithm>
+#include <utility>
+
+using namespace llvm;
+
+namespace ub_tester::budget {
+
+namespace {
+
+std::string getLineKey(StringRef Filename, unsigned Line) {
+  return sys::path::filename(Filename).str() + ":" + std::to_string(Line);
+}
+
+// components of one path end the other, e.g. "src/a.cpp" and "/p/src/a.cpp"
+bool arePathsMatching(StringRef Lhs, StringRef Rhs) {
+  SmallString<128> LhsPath(Lhs), RhsPath(Rhs);
+  sys::path::remove_dots(LhsPath, true);
+  sys::path::remove_dots(RhsPath, true);
+  auto LhsIt = sys::path::rbegin(LhsPath), LhsEnd = sys::path::rend(LhsPath);
+  auto RhsIt = sys::path::rbegin(RhsPath), RhsEnd = sys::path::rend(RhsPath);
+  for (; LhsIt != LhsEnd && RhsIt != RhsEnd; ++LhsIt, ++RhsIt)
+    if (*LhsIt != *RhsIt)
+      return false;
+  return true;
+}
+
+// perf prints IPs in hex without prefix
+bool isIP(StringRef Token) {
+  uint64_t IP = 0;
+  return !Token.getAsInteger(16, IP);
+}
+
+// "path:line", path may contain colons itself
+std::optional<std::pair<StringRef, unsigned>> parseSrcLine(StringRef Token) {
+  auto [Path, LineAsString] = Token.rsplit(':');
+  unsigned Line = 0;
+  if (Path.empty() || LineAsString.getAsInteger(10, Line) || Line == 0)
+    return std::nullopt;
+  return std::make_pair(Path, Line);
+}
+
+} // namespace
+
+std::optional<Profile> Profile::load(const std::string& Filename) {
+  auto Buffer = MemoryBuffer::getFile(Filename);
+  if (!Buffer)
+    return std::nullopt;
+  Profile Prof;
+  SmallVector<StringRef, 0> Lines;
+  (*Buffer)->getBuffer().split(Lines, '\n');
+  for (StringRef Line : Lines)
+    Prof.parseLine(Line.rtrim());
+  return Prof;
+}
+
+/* Samples of perf script start with IP, right-aligned to 16 columns, on its
+ * own line. Samples with callchains start with an empty line instead and
+ * list IP of each frame after a tab. */
+void Profile::parseLine(StringRef Line) {
+  SmallVector<StringRef, 4> Tokens;
+  SplitString(Line, Tokens);
+  if (Tokens.empty()) {
+    IsCurrentSampleAttributed_ = false;
+    return;
+  }
+
+  uint64_t Count = 0;
+  if (Tokens.size() == 2 && !Tokens[1].getAsInteger(10, Count)) {
+    if (auto SrcLine = parseSrcLine(Tokens[0]))
+      addCount(SrcLine->first, SrcLine->second, Count);
+    return;
+  }
+  if (Tokens.size() != 1)
+    return;
+  if (isIP(Tokens[0])) {
+    if (Line.front() != '\t')
+      IsCurrentSampleAttributed_ = false;
+    return;
+  }
+
+  // srcline of a sample or of one of its callers
+  if (IsCurrentSampleAttributed_)
+    return;
+  if (auto SrcLine = parseSrcLine(Tokens[0])) {
+    addCount(SrcLine->first, SrcLine->second, 1);
+    IsCurrentSampleAttributed_ = true;
+  }
+}
+
+void Profile::addCount(StringRef Filename, unsigned Line, uint64_t Count) {
+  std::vector<PathCount_t>& Counts = LineCounts_[getLineKey(Filename, Line)];
+  auto It = std::find_if(Counts.begin(), Counts.end(),
+                         [Filename](const PathCount_t& Cur) {
+                           return Cur.Path_ == Filename;
+                         });
+  if (It == Counts.end())
+    Counts.push_back({Filename.str(), Count});
+  else
+    It->Count_ += Count;
+  TotalCount_ += Count;
+}
+
+double Profile::getLineWeight(StringRef Filename, unsigned Line) const {
+  auto It = LineCounts_.find(getLineKey(Filename, Line));
+  if (It == LineCounts_.end() || TotalCount_ == 0)
+    return 0;
+  uint64_t Count = 0;
+  for (const PathCount_t& Cur : It->second)
+    if (arePathsMatching(Cur.Path_, Filename))
+      Count += Cur.Count_;
+  return static_cast<double>(Count) / TotalCount_;
+}
+
+bool Profile::empty() const { return TotalCount_ == 0; }
+
+} // namespace ub_tester::budget
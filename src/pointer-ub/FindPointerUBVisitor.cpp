@@ -1,6 +1,8 @@
 #include "pointer-ub/FindPointerUBVisitor.h"
 #include "UBUtility.h"
 #include "code-injector/InjectorASTWrapper.h"
+#include "instrumentation-scope/InstrumentationScope.h"
+#include "pointer-ub/PointerUBAnalysis.h"
 #include "pointer-ub/PointerUBAssertNames.h"
 #include "clang/Basic/SourceManager.h"
 #include <unordered_map>
@@ -55,8 +57,31 @@ getSizeCalculationFunc(const std::string& FunctionName) {
   return {};
 }
 
+// pointer to first element of array may access the whole array
+std::optional<std::string> getDecayedArraySize(const Expr* Ex,
+                                               ASTContext* Context) {
+  const auto* Decay = dyn_cast<ImplicitCastExpr>(Ex->IgnoreParens());
+  if (!Decay || Decay->getCastKind() != CastKind::CK_ArrayToPointerDecay)
+    return std::nullopt;
+  const Expr* Array = Decay->getSubExpr()->IgnoreParens();
+  if (const auto* ArrType = Context->getAsConstantArrayType(Array->getType()))
+    return ArrType->getSize().toString(10, false);
+  if (isa<DeclRefExpr>(Array) && Array->getType()->isVariableArrayType())
+    return getExprAsString(Array, Context) + ".size()";
+  return std::nullopt;
+}
+
 } // namespace
 
+void FindPointerUBVisitor::setSizeOfDecayedArray(const Expr* Ex) {
+  if (backPointer().HasSize_)
+    return;
+  if (auto Size = getDecayedArraySize(Ex, Context_)) {
+    backPointer().HasSize_ = true;
+    backPointer().Size_ << Size.value();
+  }
+}
+
 bool FindPointerUBVisitor::VisitCallExpr(CallExpr* CE) {
   if (shouldVisitNodes() && CE->getDirectCallee()) {
     auto Calculator = getSizeCalculationFunc(
@@ -103,10 +128,11 @@ void FindPointerUBVisitor::executeSubstitutionOfPointerCtor(VarDecl* VDecl) {
 }
 
 bool FindPointerUBVisitor::TraverseVarDecl(clang::VarDecl* VDecl) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(VDecl->getBeginLoc()))
+  if (!scope::shouldInstrument(VDecl->getBeginLoc(), Context_))
     return true;
 
-  Pointers_.emplace_back(VDecl->getType().getTypePtr()->isPointerType());
+  Pointers_.emplace_back(VDecl->getType().getTypePtr()->isPointerType() &&
+                         !ptr::analysis::isKeptRaw(VDecl, Context_));
   if (shouldVisitNodes())
     backPointer().PointeeType_ =
         dyn_cast<PointerType>(VDecl->getType().getTypePtr())
@@ -115,8 +141,10 @@ bool FindPointerUBVisitor::TraverseVarDecl(clang::VarDecl* VDecl) {
 
   RecursiveASTVisitor<FindPointerUBVisitor>::TraverseVarDecl(VDecl);
   if (shouldVisitNodes()) {
-    if (VDecl->hasInit())
+    if (VDecl->hasInit()) {
       backPointer().Init_ = getExprAsString(VDecl->getInit(), Context_);
+      setSizeOfDecayedArray(VDecl->getInit());
+    }
     executeSubstitutionOfPointerCtor(VDecl);
   }
   reset();
@@ -143,10 +171,13 @@ void FindPointerUBVisitor::executeSubstitutionOfPointerAssignment(
 
 bool FindPointerUBVisitor::TraverseBinAssign(BinaryOperator* Binop,
                                              DataRecursionQueue* Queue) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(Binop->getBeginLoc()))
+  if (!scope::shouldInstrument(Binop->getBeginLoc(), Context_))
     return true;
 
-  if (Binop->getLHS()->getType().getTypePtr()->isPointerType()) {
+  if (Binop->getLHS()->getType().getTypePtr()->isPointerType() &&
+      ptr::analysis::refersToRawPointer(Binop->getLHS(), Context_)) {
+    Pointers_.emplace_back(false);
+  } else if (Binop->getLHS()->getType().getTypePtr()->isPointerType()) {
     Pointers_.emplace_back(true);
     backPointer().PointeeType_ =
         dyn_cast<PointerType>(Binop->getLHS()->getType().getTypePtr())
@@ -156,8 +187,10 @@ bool FindPointerUBVisitor::TraverseBinAssign(BinaryOperator* Binop,
 
   RecursiveASTVisitor<FindPointerUBVisitor>::TraverseStmt(Binop->getLHS());
   RecursiveASTVisitor<FindPointerUBVisitor>::TraverseStmt(Binop->getRHS());
-  if (shouldVisitNodes())
+  if (shouldVisitNodes()) {
+    setSizeOfDecayedArray(Binop->getRHS());
     executeSubstitutionOfPointerAssignment(Binop);
+  }
   reset();
   return true;
 }
@@ -167,20 +200,24 @@ void FindPointerUBVisitor::executeSubstitutionOfStarOperator(
   SourceLocation Loc = Unop->getBeginLoc();
   std::string SourceFormat = "*@";
   std::string OutputFormat =
-      ptr::names_to_inject::getAssertStarOperatorAsString("@");
+      ptr::analysis::refersToRawPointer(Unop->getSubExpr(), Context_)
+          ? ptr::names_to_inject::getAssertRawStarOperatorAsString("@")
+          : ptr::names_to_inject::getAssertStarOperatorAsString("@");
   SubstitutionASTWrapper(Context_)
       .setLoc(Loc)
       .setPrior(SubstPriorityKind::Deep)
+      .setCheckKind(budget::CheckKind::Pointer)
       .setFormats(SourceFormat, OutputFormat)
       .setArguments(Unop->getSubExpr())
       .apply();
 }
 
 bool FindPointerUBVisitor::VisitUnaryOperator(UnaryOperator* Unop) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(Unop->getBeginLoc()))
+  if (!scope::shouldInstrument(Unop->getBeginLoc(), Context_))
     return true;
   if (Unop->getOpcode() == UnaryOperator::Opcode::UO_Deref &&
-      Unop->getSubExpr()->getType()->isPointerType())
+      Unop->getSubExpr()->getType()->isPointerType() &&
+      !ptr::analysis::isProvenNonNullDeref(Unop, Context_))
     executeSubstitutionOfStarOperator(Unop);
   return true;
 }
@@ -190,10 +227,13 @@ void FindPointerUBVisitor::executeSubstitutionOfMemberExpr(
   SourceLocation Loc = MembExpr->getBeginLoc();
   std::string SourceFormat = "@#@";
   std::string OutputFormat =
-      ptr::names_to_inject::getAssertMemberExprAsString("@", "@");
+      ptr::analysis::refersToRawPointer(MembExpr->getBase(), Context_)
+          ? ptr::names_to_inject::getAssertRawMemberExprAsString("@", "@")
+          : ptr::names_to_inject::getAssertMemberExprAsString("@", "@");
   SubstitutionASTWrapper(Context_)
       .setLoc(Loc)
       .setPrior(SubstPriorityKind::Deep)
+      .setCheckKind(budget::CheckKind::Pointer)
       .setFormats(SourceFormat, OutputFormat)
       .setArguments(MembExpr->getBase(), SourceRange{MembExpr->getMemberLoc(),
                                                      MembExpr->getEndLoc()})
@@ -201,10 +241,10 @@ void FindPointerUBVisitor::executeSubstitutionOfMemberExpr(
 }
 
 bool FindPointerUBVisitor::VisitMemberExpr(MemberExpr* MembExpr) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(
-          MembExpr->getBeginLoc()))
+  if (!scope::shouldInstrument(MembExpr->getBeginLoc(), Context_))
     return true;
-  if (MembExpr->isArrow())
+  if (MembExpr->isArrow() &&
+      !ptr::analysis::isProvenNonNullDeref(MembExpr, Context_))
     executeSubstitutionOfMemberExpr(MembExpr);
   return true;
 }
@@ -0,0 +1,436 @@
+#include "pointer-ub/PointerUBAnalysis.h"
+#include "UBUtility.h"
+#include "instrumentation-scope/InstrumentationScope.h"
+#include "clang/Analysis/AnalysisDeclContext.h"
+#include "clang/Analysis/CFG.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace clang;
+
+namespace ub_tester::ptr::analysis {
+
+namespace {
+
+std::unordered_set<std::string> NonNullDerefs;
+std::unordered_set<std::string> RawPointers;
+
+const DeclRefExpr* getDeclRefThroughCasts(const Expr* Ex) {
+  return dyn_cast<DeclRefExpr>(Ex->IgnoreParenImpCasts());
+}
+
+const VarDecl* getReferencedVar(const Expr* Ex) {
+  const DeclRefExpr* DRExpr = getDeclRefThroughCasts(Ex);
+  return DRExpr ? dyn_cast<VarDecl>(DRExpr->getDecl()) : nullptr;
+}
+
+bool isAlwaysNonNull(const Expr* Ex) {
+  Ex = Ex->IgnoreParenImpCasts();
+  if (isa<CXXThisExpr>(Ex) || isa<StringLiteral>(Ex))
+    return true;
+  if (const auto* Unop = dyn_cast<UnaryOperator>(Ex))
+    return Unop->getOpcode() == UnaryOperator::Opcode::UO_AddrOf;
+  if (const auto* NewExpr = dyn_cast<CXXNewExpr>(Ex))
+    return !NewExpr->shouldNullCheckAllocation();
+  if (const auto* DRExpr = dyn_cast<DeclRefExpr>(Ex)) // decayed array/function
+    return DRExpr->getType()->isArrayType() ||
+           DRExpr->getType()->isFunctionType();
+  return false;
+}
+
+bool isNullExpr(const Expr* Ex, ASTContext* Context) {
+  return Ex->IgnoreParenImpCasts()->isNullPointerConstant(
+      *Context, Expr::NPC_ValueDependentIsNotNull);
+}
+
+// counts uses of pointer variables that are compatible with raw pointer
+class PointerUsesVisitor : public RecursiveASTVisitor<PointerUsesVisitor> {
+public:
+  bool VisitDeclRefExpr(DeclRefExpr* DRExpr) {
+    if (const auto* VDecl = dyn_cast<VarDecl>(DRExpr->getDecl()))
+      ++AllUses_[VDecl];
+    return true;
+  }
+
+  bool VisitUnaryOperator(UnaryOperator* Unop) {
+    if (Unop->getOpcode() == UnaryOperator::Opcode::UO_Deref ||
+        Unop->getOpcode() == UnaryOperator::Opcode::UO_LNot)
+      markAllowed(Unop->getSubExpr());
+    return true;
+  }
+
+  bool VisitMemberExpr(MemberExpr* MembExpr) {
+    if (MembExpr->isArrow())
+      markAllowed(MembExpr->getBase());
+    return true;
+  }
+
+  bool VisitBinaryOperator(BinaryOperator* Binop) {
+    if (Binop->isComparisonOp()) {
+      markAllowed(Binop->getLHS());
+      markAllowed(Binop->getRHS());
+    } else if (Binop->getOpcode() == BinaryOperator::Opcode::BO_Assign) {
+      markAllowed(Binop->getLHS());
+    }
+    return true;
+  }
+
+  bool VisitImplicitCastExpr(ImplicitCastExpr* ImplicitCast) {
+    if (ImplicitCast->getCastKind() == CastKind::CK_PointerToBoolean)
+      markAllowed(ImplicitCast->getSubExpr());
+    return true;
+  }
+
+  bool areAllUsesAllowed(const VarDecl* VDecl) const {
+    auto All = AllUses_.find(VDecl);
+    auto Allowed = AllowedUses_.find(VDecl);
+    size_t AllCount = All == AllUses_.end() ? 0 : All->second;
+    size_t AllowedCount = Allowed == AllowedUses_.end() ? 0 : Allowed->second;
+    return AllCount == AllowedCount;
+  }
+
+private:
+  void markAllowed(const Expr* Ex) {
+    Ex = Ex->IgnoreParens();
+    if (const auto* ImplicitCast = dyn_cast<ImplicitCastExpr>(Ex))
+      if (ImplicitCast->getCastKind() == CastKind::CK_LValueToRValue)
+        Ex = ImplicitCast->getSubExpr()->IgnoreParens();
+    const auto* DRExpr = dyn_cast<DeclRefExpr>(Ex);
+    if (!DRExpr || !AllowedRefs_.insert(DRExpr).second)
+      return;
+    if (const auto* VDecl = dyn_cast<VarDecl>(DRExpr->getDecl()))
+      ++AllowedUses_[VDecl];
+  }
+
+private:
+  std::unordered_map<const VarDecl*, size_t> AllUses_;
+  std::unordered_map<const VarDecl*, size_t> AllowedUses_;
+  std::unordered_set<const DeclRefExpr*> AllowedRefs_;
+};
+
+/* Forward must-analysis over CFG: NonNull bit is set if pointer is non-null
+ * on every path, Init bit is set if it is initialized on every path. Uninit
+ * pointer is not null-checked by if (p), so branch refines only initialized
+ * ones, and their dereferences keep the Uninit check of UBSafePointer. */
+struct PtrsState {
+  llvm::BitVector NonNull;
+  llvm::BitVector Init;
+
+  PtrsState(size_t NumVars, bool Value)
+      : NonNull(NumVars, Value), Init(NumVars, Value) {}
+
+  PtrsState& operator&=(const PtrsState& Other) {
+    NonNull &= Other.NonNull;
+    Init &= Other.Init;
+    return *this;
+  }
+
+  bool operator!=(const PtrsState& Other) const {
+    return NonNull != Other.NonNull || Init != Other.Init;
+  }
+
+  void set(unsigned Idx, bool IsNonNull) {
+    NonNull[Idx] = IsNonNull;
+    Init[Idx] = true;
+  }
+};
+
+class NonNullPointersFinder {
+public:
+  NonNullPointersFinder(const CFG& FuncCFG, ASTContext* Context)
+      : FuncCFG_{FuncCFG}, Context_{Context} {}
+
+  void addTrackedVar(const VarDecl* VDecl, bool IsInitOnEntry) {
+    VarIndices_.try_emplace(VDecl, VarIndices_.size());
+    InitOnEntry_.push_back(IsInitOnEntry);
+  }
+
+  void run() {
+    if (VarIndices_.empty())
+      return;
+    std::vector<bool> IsReachable = findReachableBlocks();
+    BlocksOut_.assign(FuncCFG_.getNumBlockIDs(),
+                      PtrsState(VarIndices_.size(), true));
+
+    for (bool Changed = true; Changed;) {
+      Changed = false;
+      for (const CFGBlock* Block : FuncCFG_) {
+        if (!IsReachable[Block->getBlockID()])
+          continue;
+        PtrsState State = getBlockIn(*Block, IsReachable);
+        transfer(*Block, State, /*RecordDerefs=*/false);
+        if (State != BlocksOut_[Block->getBlockID()]) {
+          BlocksOut_[Block->getBlockID()] = std::move(State);
+          Changed = true;
+        }
+      }
+    }
+
+    for (const CFGBlock* Block : FuncCFG_)
+      if (IsReachable[Block->getBlockID()]) {
+        PtrsState State = getBlockIn(*Block, IsReachable);
+        transfer(*Block, State, /*RecordDerefs=*/true);
+      }
+  }
+
+private:
+  std::vector<bool> findReachableBlocks() const {
+    std::vector<bool> IsReachable(FuncCFG_.getNumBlockIDs(), false);
+    std::vector<const CFGBlock*> Worklist{&FuncCFG_.getEntry()};
+    IsReachable[FuncCFG_.getEntry().getBlockID()] = true;
+    while (!Worklist.empty()) {
+      const CFGBlock* Block = Worklist.back();
+      Worklist.pop_back();
+      for (const CFGBlock* Succ : Block->succs())
+        if (Succ && !IsReachable[Succ->getBlockID()]) {
+          IsReachable[Succ->getBlockID()] = true;
+          Worklist.push_back(Succ);
+        }
+    }
+    return IsReachable;
+  }
+
+  PtrsState getBlockIn(const CFGBlock& Block,
+                       const std::vector<bool>& IsReachable) const {
+    PtrsState State(VarIndices_.size(), false);
+    if (&Block == &FuncCFG_.getEntry()) {
+      for (size_t I = 0; I < InitOnEntry_.size(); ++I)
+        State.Init[I] = InitOnEntry_[I];
+      return State;
+    }
+    bool HasReachablePred = false;
+    for (const CFGBlock* Pred : Block.preds())
+      if (Pred && IsReachable[Pred->getBlockID()]) {
+        PtrsState EdgeState = getEdgeState(*Pred, Block);
+        if (!HasReachablePred)
+          State = std::move(EdgeState);
+        else
+          State &= EdgeState;
+        HasReachablePred = true;
+      }
+    return State;
+  }
+
+  // refines predecessor's state with the branch condition
+  PtrsState getEdgeState(const CFGBlock& Pred, const CFGBlock& Succ) const {
+    PtrsState State = BlocksOut_[Pred.getBlockID()];
+    if (Pred.succ_size() != 2)
+      return State;
+    const CFGBlock* TrueSucc = *Pred.succ_begin();
+    const CFGBlock* FalseSucc = *(Pred.succ_begin() + 1);
+    if (TrueSucc == FalseSucc || !Pred.getTerminatorCondition())
+      return State;
+    bool IsTrueEdge = &Succ == TrueSucc;
+    auto [Idx, NonNullWhenTrue] =
+        getCheckedPointer(cast<Expr>(Pred.getTerminatorCondition()));
+    if (Idx >= 0 && IsTrueEdge == NonNullWhenTrue && State.Init[Idx])
+      State.NonNull[Idx] = true;
+    return State;
+  }
+
+  // recognizes p, !p, p != nullptr and p == nullptr
+  std::pair<int, bool> getCheckedPointer(const Expr* Cond) const {
+    Cond = Cond->IgnoreParenImpCasts();
+    if (const auto* Unop = dyn_cast<UnaryOperator>(Cond))
+      if (Unop->getOpcode() == UnaryOperator::Opcode::UO_LNot) {
+        auto [Idx, NonNullWhenTrue] = getCheckedPointer(Unop->getSubExpr());
+        return {Idx, !NonNullWhenTrue};
+      }
+    if (const auto* Binop = dyn_cast<BinaryOperator>(Cond))
+      if (Binop->isEqualityOp()) {
+        bool IsNotEqual = Binop->getOpcode() == BinaryOperator::Opcode::BO_NE;
+        if (isNullExpr(Binop->getRHS(), Context_))
+          return {getVarIndex(Binop->getLHS()), IsNotEqual};
+        if (isNullExpr(Binop->getLHS(), Context_))
+          return {getVarIndex(Binop->getRHS()), IsNotEqual};
+        return {-1, false};
+      }
+    return {getVarIndex(Cond), true};
+  }
+
+  int getVarIndex(const Expr* Ex) const {
+    const VarDecl* VDecl = getReferencedVar(Ex);
+    auto It = VarIndices_.find(VDecl);
+    return It == VarIndices_.end() ? -1 : static_cast<int>(It->second);
+  }
+
+  bool isNonNull(const Expr* Ex, const PtrsState& State) const {
+    if (isAlwaysNonNull(Ex))
+      return true;
+    int Idx = getVarIndex(Ex);
+    return Idx >= 0 && State.NonNull[Idx];
+  }
+
+  void transfer(const CFGBlock& Block, PtrsState& State, bool RecordDerefs) {
+    for (const CFGElement& Elem : Block) {
+      auto CFGStatement = Elem.getAs<CFGStmt>();
+      if (!CFGStatement)
+        continue;
+      const Stmt* S = CFGStatement->getStmt();
+
+      if (const auto* DStmt = dyn_cast<DeclStmt>(S)) {
+        for (const Decl* D : DStmt->decls())
+          if (const auto* VDecl = dyn_cast<VarDecl>(D)) {
+            auto It = VarIndices_.find(VDecl);
+            if (It == VarIndices_.end())
+              continue;
+            if (VDecl->hasInit()) {
+              State.set(It->second, isNonNull(VDecl->getInit(), State));
+            } else {
+              State.NonNull[It->second] = false;
+              State.Init[It->second] = false;
+            }
+          }
+      } else if (const auto* Binop = dyn_cast<BinaryOperator>(S)) {
+        if (Binop->getOpcode() == BinaryOperator::Opcode::BO_Assign)
+          if (int Idx = getVarIndex(Binop->getLHS()); Idx >= 0)
+            State.set(Idx, isNonNull(Binop->getRHS(), State));
+      } else if (const auto* Unop = dyn_cast<UnaryOperator>(S)) {
+        if (Unop->getOpcode() == UnaryOperator::Opcode::UO_Deref)
+          handleDeref(Unop->getSubExpr(), Unop->getOperatorLoc(), State,
+                      RecordDerefs);
+      } else if (const auto* MembExpr = dyn_cast<MemberExpr>(S)) {
+        if (MembExpr->isArrow())
+          handleDeref(MembExpr->getBase(), MembExpr->getMemberLoc(), State,
+                      RecordDerefs);
+      } else if (const auto* Subscript = dyn_cast<ArraySubscriptExpr>(S)) {
+        if (int Idx = getVarIndex(Subscript->getBase()); Idx >= 0)
+          State.set(Idx, true);
+      }
+    }
+  }
+
+  /* Failed check terminates the program, so pointer is initialized and
+   * non-null afterwards. */
+  void handleDeref(const Expr* Pointer, SourceLocation Loc, PtrsState& State,
+                   bool RecordDerefs) {
+    int Idx = getVarIndex(Pointer);
+    if (Idx < 0)
+      return;
+    if (RecordDerefs && State.NonNull[Idx])
+      NonNullDerefs.insert(util::getLocAsKey(Loc, Context_));
+    State.set(Idx, true);
+  }
+
+private:
+  const CFG& FuncCFG_;
+  ASTContext* Context_;
+  llvm::DenseMap<const VarDecl*, unsigned> VarIndices_;
+  std::vector<bool> InitOnEntry_;
+  std::vector<PtrsState> BlocksOut_;
+};
+
+bool isCandidatePointer(const VarDecl* VDecl) {
+  return VDecl->getType()->isPointerType() &&
+         !VDecl->getType()->isFunctionPointerType();
+}
+
+// pointers to pointers and arrays change their pointee type on substitution
+bool canBeKeptRaw(const VarDecl* VDecl) {
+  const auto* PtrType = dyn_cast<PointerType>(VDecl->getType().getTypePtr());
+  if (!PtrType)
+    return false;
+  QualType Pointee = PtrType->getPointeeType().getCanonicalType();
+  return !Pointee->isPointerType() && !Pointee->isArrayType() &&
+         !Pointee->isMemberPointerType();
+}
+
+} // namespace
+
+bool isProvenNonNullDeref(const UnaryOperator* Unop,
+                          const ASTContext* Context) {
+  if (isAlwaysNonNull(Unop->getSubExpr()))
+    return true;
+  return NonNullDerefs.find(util::getLocAsKey(Unop->getOperatorLoc(),
+                                              Context)) != NonNullDerefs.end();
+}
+
+bool isProvenNonNullDeref(const MemberExpr* MembExpr,
+                          const ASTContext* Context) {
+  if (isAlwaysNonNull(MembExpr->getBase()))
+    return true;
+  return NonNullDerefs.find(util::getLocAsKey(MembExpr->getMemberLoc(),
+                                              Context)) != NonNullDerefs.end();
+}
+
+bool isKeptRaw(const DeclaratorDecl* Decl, const ASTContext* Context) {
+  if (scope::isExcluded(Decl, Context))
+    return true;
+  const auto* VDecl = dyn_cast_or_null<VarDecl>(Decl);
+  if (!VDecl)
+    return false;
+  if (const auto* PVDecl = dyn_cast<ParmVarDecl>(VDecl)) {
+    const auto* FuncDecl =
+        dyn_cast_or_null<FunctionDecl>(PVDecl->getDeclContext());
+    if (!FuncDecl)
+      return false;
+    const FunctionDecl* Definition = FuncDecl->getDefinition();
+    if (Definition && Definition != FuncDecl)
+      VDecl = Definition->getParamDecl(PVDecl->getFunctionScopeIndex());
+  }
+  return RawPointers.find(util::getLocAsKey(VDecl->getLocation(), Context)) !=
+         RawPointers.end();
+}
+
+bool refersToRawPointer(const Expr* Ex, const ASTContext* Context) {
+  if (const auto* MembExpr = dyn_cast<MemberExpr>(Ex->IgnoreParenImpCasts()))
+    return scope::isExcluded(MembExpr->getMemberDecl(), Context);
+  const VarDecl* VDecl = getReferencedVar(Ex);
+  return VDecl && isKeptRaw(VDecl, Context);
+}
+
+PointerUBAnalysisVisitor::PointerUBAnalysisVisitor(ASTContext* Context)
+    : Context_(Context) {}
+
+bool PointerUBAnalysisVisitor::VisitFunctionDecl(FunctionDecl* FuncDecl) {
+  if (!scope::shouldInstrument(FuncDecl->getBeginLoc(), Context_))
+    return true;
+  if (!FuncDecl->doesThisDeclarationHaveABody() ||
+      FuncDecl->isDependentContext())
+    return true;
+
+  AnalysisDeclContextManager ADCManager(*Context_);
+  AnalysisDeclContext* ADContext = ADCManager.getContext(FuncDecl);
+  ADContext->getCFGBuildOptions().setAllAlwaysAdd();
+  CFG* FuncCFG = ADContext->getCFG();
+  if (!FuncCFG)
+    return true;
+
+  util::EscapedVarsVisitor EscapedVars(FuncDecl);
+  EscapedVars.TraverseStmt(FuncDecl->getBody());
+  PointerUsesVisitor PointerUses;
+  PointerUses.TraverseStmt(FuncDecl->getBody());
+
+  NonNullPointersFinder NonNullFinder(*FuncCFG, Context_);
+  for (const ParmVarDecl* PVDecl : FuncDecl->parameters())
+    if (isCandidatePointer(PVDecl) && !EscapedVars.isEscaped(PVDecl)) {
+      NonNullFinder.addTrackedVar(PVDecl, /*IsInitOnEntry=*/true);
+      if (util::canChangeParamTypes(FuncDecl) && canBeKeptRaw(PVDecl) &&
+          PointerUses.areAllUsesAllowed(PVDecl))
+        RawPointers.insert(util::getLocAsKey(PVDecl->getLocation(), Context_));
+    }
+  for (const VarDecl* VDecl : EscapedVars.getLocalVars())
+    if (VDecl->hasLocalStorage() && isCandidatePointer(VDecl) &&
+        !EscapedVars.isEscaped(VDecl)) {
+      NonNullFinder.addTrackedVar(VDecl, /*IsInitOnEntry=*/false);
+      if (VDecl->hasInit() && canBeKeptRaw(VDecl) &&
+          PointerUses.areAllUsesAllowed(VDecl))
+        RawPointers.insert(util::getLocAsKey(VDecl->getLocation(), Context_));
+    }
+  NonNullFinder.run();
+  return true;
+}
+
+PointerUBAnalysisConsumer::PointerUBAnalysisConsumer(ASTContext* Context)
+    : AnalysisVisitor_(Context) {}
+
+void PointerUBAnalysisConsumer::HandleTranslationUnit(ASTContext& Context) {
+  AnalysisVisitor_.TraverseDecl(Context.getTranslationUnitDecl());
+}
+
+} // namespace ub_tester::ptr::analysis
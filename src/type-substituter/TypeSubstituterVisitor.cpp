@@ -2,7 +2,10 @@
 #include "UBUtility.h"
 #include "cli/CLI.h"
 #include "code-injector/InjectorASTWrapper.h"
+#include "instrumentation-scope/InstrumentationScope.h"
+#include "pointer-ub/PointerUBAnalysis.h"
 #include "type-substituter/SafeTypesNames.h"
+#include "uninit-variables/UninitVarsAnalysis.h"
 #include "clang/Basic/SourceManager.h"
 
 // TODO templates
@@ -53,10 +56,21 @@ bool TypeSubstituterVisitor::TypeInfo_t::shouldVisitTypes() {
   return ShouldVisitTypes_;
 }
 
+// tracked elements are wrapped, but stored unwrapped by safe array
+bool TypeSubstituterVisitor::TraverseArrayElementTypeHelper(
+    QualType ElementType) {
+  bool IsWrapped = uninit::analysis::isTrackedElementType(ElementType);
+  if (IsWrapped)
+    Type_ << SafeBuiltinVarName << "<";
+  TraverseType(ElementType);
+  if (IsWrapped)
+    Type_ << ">";
+  return true;
+}
+
 bool TypeSubstituterVisitor::TraverseArrayTypeHelper(ArrayType* ArrType) {
   Type_ << SafeArrayName << "<";
-  RecursiveASTVisitor<TypeSubstituterVisitor>::TraverseType(
-      ArrType->getElementType());
+  TraverseArrayElementTypeHelper(ArrType->getElementType());
   Type_ << ">";
   return true;
 }
@@ -69,8 +83,7 @@ bool TypeSubstituterVisitor::TraverseVariableArrayType(
 bool TypeSubstituterVisitor::TraverseDependentSizedArrayType(
     DependentSizedArrayType* DepSizedArrType) {
   Type_ << SafeArrayName << "<";
-  RecursiveASTVisitor<TypeSubstituterVisitor>::TraverseDependentSizedArrayType(
-      DepSizedArrType);
+  TraverseArrayElementTypeHelper(DepSizedArrType->getElementType());
   if (DepSizedArrType->getSizeExpr())
     Type_ << ", " << getExprAsString(DepSizedArrType->getSizeExpr(), Context_);
   Type_ << ">";
@@ -85,8 +98,7 @@ bool TypeSubstituterVisitor::TraverseIncompleteArrayType(
 bool TypeSubstituterVisitor::TraverseConstantArrayType(
     ConstantArrayType* ConstArrType) {
   Type_ << SafeArrayName << "<";
-  RecursiveASTVisitor<TypeSubstituterVisitor>::TraverseConstantArrayType(
-      ConstArrType);
+  TraverseArrayElementTypeHelper(ConstArrType->getElementType());
   Type_ << ", " << ConstArrType->getSize().toString(10, false) << ">";
   return true;
 }
@@ -110,6 +122,8 @@ bool TypeSubstituterVisitor::TraverseLValueReferenceType(
 }
 
 bool TypeSubstituterVisitor::TraversePointerType(PointerType* PtrType) {
+  if (!Type_.isInited() && KeepOriginalType_)
+    return true; // declaration stays untouched
   Type_ << SafePointerName << "<";
   RecursiveASTVisitor<TypeSubstituterVisitor>::TraversePointerType(PtrType);
   Type_ << ">";
@@ -118,10 +132,12 @@ bool TypeSubstituterVisitor::TraversePointerType(PointerType* PtrType) {
 
 bool TypeSubstituterVisitor::TraverseBuiltinType(BuiltinType* BType) {
   bool FirstInit = !Type_.isInited();
-  if (cli::RunUninit && FirstInit)
+  if (FirstInit && KeepOriginalType_)
+    return true; // declaration stays untouched
+  if (cli::wrapsUninitVars() && FirstInit)
     Type_ << SafeBuiltinVarName << "<";
   Type_ << BType->getName(PrintingPolicy{Context_->getLangOpts()}).str();
-  if (cli::RunUninit && FirstInit)
+  if (cli::wrapsUninitVars() && FirstInit)
     Type_ << ">";
   return true;
 }
@@ -177,7 +193,8 @@ bool TypeSubstituterVisitor::TraverseType(QualType QType) {
     return true;
   Type_.addQuals(QType.getLocalQualifiers(),
                  PrintingPolicy{Context_->getLangOpts()});
-  if ((cli::RunUninit && QType.getNonReferenceType()->isBuiltinType()) ||
+  if ((cli::wrapsUninitVars() &&
+       QType.getNonReferenceType()->isBuiltinType()) ||
       (cli::RunIOB))
     RecursiveASTVisitor<TypeSubstituterVisitor>::TraverseType(QType);
   return true;
@@ -195,8 +212,10 @@ bool TypeSubstituterVisitor::TraverseDeclStmt(DeclStmt* DStmt,
 
 void TypeSubstituterVisitor::substituteTypeOfVariable(
     DeclaratorDecl* DeclarDecl) {
-  if (!Type_.isInited())
+  if (!Type_.isInited()) {
+    Type_.reset();
     return;
+  }
   std::stringstream NewDeclaration;
   if (VarDecl* VDecl = dyn_cast<VarDecl>(DeclarDecl)) {
     if (VDecl->isInline())
@@ -233,7 +252,7 @@ void TypeSubstituterVisitor::substituteTypeOfTypedef(TypedefNameDecl* TDecl) {
 
 bool TypeSubstituterVisitor::VisitFunctionDecl(FunctionDecl* FuncDecl) {
   const auto& SrcManager = Context_->getSourceManager();
-  if (!SrcManager.isWrittenInMainFile(FuncDecl->getBeginLoc()) ||
+  if (!scope::shouldInstrument(FuncDecl->getBeginLoc(), Context_) ||
       SrcManager.isMacroBodyExpansion(FuncDecl->getBeginLoc()))
     return true;
 
@@ -248,12 +267,16 @@ bool TypeSubstituterVisitor::VisitFunctionDecl(FunctionDecl* FuncDecl) {
 
 bool TypeSubstituterVisitor::VisitDeclaratorDeclHelper(
     DeclaratorDecl* DeclarDecl) {
-  const auto& SrcManager = Context_->getSourceManager();
-  if (!SrcManager.isWrittenInMainFile(DeclarDecl->getBeginLoc()))
+  if (!scope::shouldInstrument(DeclarDecl->getBeginLoc(), Context_))
     return true;
+  KeepOriginalType_ =
+      (cli::RunUninit &&
+       uninit::analysis::isProvenInitialized(DeclarDecl, Context_)) ||
+      (cli::RunIOB && ptr::analysis::isKeptRaw(DeclarDecl, Context_));
   Type_.shouldVisitTypes(true);
   TraverseType(DeclarDecl->getType());
   substituteTypeOfVariable(DeclarDecl);
+  KeepOriginalType_ = false;
   return true;
 }
 
@@ -270,12 +293,40 @@ bool TypeSubstituterVisitor::VisitVarDecl(VarDecl* VDecl) {
   return true;
 }
 
+// type of field is followed by types of preceding ones, see UBSafeField.h
+void TypeSubstituterVisitor::substituteTypeOfPackedField(FieldDecl* FDecl) {
+  PrintingPolicy PPolicy{Context_->getLangOpts()};
+  auto GetTypeName = [&PPolicy](const FieldDecl* Field) {
+    return cast<BuiltinType>(Field->getType().getTypePtr())
+        ->getName(PPolicy)
+        .str();
+  };
+  const RecordDecl* Record = FDecl->getParent();
+  std::stringstream NewDeclaration;
+  NewDeclaration << SafeFieldName << "<"
+                 << std::distance(Record->field_begin(), Record->field_end())
+                 << ", " << GetTypeName(FDecl);
+  for (const FieldDecl* PrevField : Record->fields()) {
+    if (PrevField == FDecl)
+      break;
+    NewDeclaration << ", " << GetTypeName(PrevField);
+  }
+  NewDeclaration << "> " << FDecl->getNameAsString();
+  InjectorASTWrapper::getInstance().substitute(
+      {FDecl->getBeginLoc(), getNameLastLoc(FDecl, Context_)},
+      NewDeclaration.str(), Context_);
+}
+
 bool TypeSubstituterVisitor::VisitFieldDecl(FieldDecl* FDecl) {
+  if (uninit::analysis::isPackedRecord(FDecl->getParent(), Context_)) {
+    substituteTypeOfPackedField(FDecl);
+    return true;
+  }
   return VisitDeclaratorDeclHelper(FDecl);
 }
 
 bool TypeSubstituterVisitor::VisitTypedefNameDecl(TypedefNameDecl* TDecl) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(TDecl->getBeginLoc()))
+  if (!scope::shouldInstrument(TDecl->getBeginLoc(), Context_))
     return true;
   Type_.shouldVisitTypes(true);
   TraverseType(TDecl->getTypeSourceInfo()->getType());
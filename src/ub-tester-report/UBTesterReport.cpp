@@ -0,0 +1,295 @@
+#include "arithmetic-ub/ArithmeticUBAsserts.h"
+#include "assert-message-manager/CheckEventLog.h"
+#include "ub-safe-containers/CArrayNPointerUBAsserts.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/* Renders event log written by instrumented program (UB_TESTER_EVENT_LOG):
+ * each event is passed to the same report function the program would have
+ * called, so messages are identical to the ones printed without event log. */
+
+using namespace ub_tester;
+using namespace ub_tester::assert_message_manager::event_log;
+using arithm::checkers::ArithmCheckRes;
+using type_conv::TyCoCheckRes;
+
+namespace {
+
+struct Site {
+  SiteRecord Record;
+  std::vector<std::string> Strings; // filename, then type and operation names
+
+  const char* getFilename() const { return Strings[0].c_str(); }
+  const char* getName(size_t Idx) const { return Strings.at(Idx + 1).c_str(); }
+};
+
+template <typename T>
+struct TypeTag {
+  using Type = T;
+};
+
+// operations are computed in promoted types only
+template <typename Func>
+bool withPromotedIntType(IntTypeId Id, Func&& F) {
+  switch (Id) {
+  case IntTypeId::Int:
+    return F(TypeTag<int>{}), true;
+  case IntTypeId::UnsignedInt:
+    return F(TypeTag<unsigned int>{}), true;
+  case IntTypeId::Long:
+    return F(TypeTag<long>{}), true;
+  case IntTypeId::UnsignedLong:
+    return F(TypeTag<unsigned long>{}), true;
+  case IntTypeId::LongLong:
+    return F(TypeTag<long long>{}), true;
+  case IntTypeId::UnsignedLongLong:
+    return F(TypeTag<unsigned long long>{}), true;
+  default:
+    return false;
+  }
+}
+
+template <typename Func>
+bool withIntType(IntTypeId Id, Func&& F) {
+  switch (Id) {
+  case IntTypeId::Bool:
+    return F(TypeTag<bool>{}), true;
+  case IntTypeId::Char:
+    return F(TypeTag<char>{}), true;
+  case IntTypeId::SignedChar:
+    return F(TypeTag<signed char>{}), true;
+  case IntTypeId::UnsignedChar:
+    return F(TypeTag<unsigned char>{}), true;
+  case IntTypeId::Short:
+    return F(TypeTag<short>{}), true;
+  case IntTypeId::UnsignedShort:
+    return F(TypeTag<unsigned short>{}), true;
+  default:
+    break;
+  }
+  return withPromotedIntType(Id, F);
+}
+
+// rhs of bitshift is only printed, so only its signedness matters
+template <typename Func>
+bool withShiftRhsType(IntTypeId Id, Func&& F) {
+  return withPromotedIntType(Id, [&F](auto Tag) {
+    using T = typename decltype(Tag)::Type;
+    F(TypeTag<std::conditional_t<std::is_signed_v<T>, long long,
+                                 unsigned long long>>{});
+  });
+}
+
+template <typename T>
+T fromBits(uint64_t Bits) {
+  return static_cast<T>(Bits);
+}
+
+#define REPLAY_BINOP(Operation)                                                \
+  case EventKind::Operation:                                                   \
+    return withPromotedIntType(Types[0], [&](auto Tag) {                       \
+      using T = typename decltype(Tag)::Type;                                  \
+      arithm::asserts::report##Operation<T, T>(                                \
+          ArithmRes, fromBits<T>(Ops[0]), fromBits<T>(Ops[1]), S.getName(0),  \
+          Filename, Line);                                                     \
+    })
+
+#define REPLAY_SHIFT(Operation)                                                \
+  case EventKind::Operation:                                                   \
+    return withPromotedIntType(Types[0], [&](auto LhsTag) {                    \
+      withShiftRhsType(Types[1], [&](auto RhsTag) {                            \
+        using L = typename decltype(LhsTag)::Type;                             \
+        using R = typename decltype(RhsTag)::Type;                             \
+        arithm::asserts::report##Operation<L, R>(                              \
+            ArithmRes, fromBits<L>(Ops[0]), fromBits<R>(Ops[1]),               \
+            S.getName(0), Filename, Line);                                     \
+      });                                                                      \
+    })
+
+#define REPLAY_INCR_DECR(Operation)                                            \
+  case EventKind::Operation:                                                   \
+    return withIntType(Types[0], [&](auto Tag) {                               \
+      using T = typename decltype(Tag)::Type;                                  \
+      arithm::asserts::report##Operation<T>(ArithmRes, fromBits<T>(Ops[0]),    \
+                                            S.getName(0), Filename, Line);     \
+    })
+
+#define REPLAY_COMPASSIGNOP(Operation)                                         \
+  case EventKind::CompAssignOp##Operation:                                     \
+    return withIntType(Types[0], [&](auto LhsTag) {                            \
+      withPromotedIntType(Types[1], [&](auto CompTag) {                        \
+        using L = typename decltype(LhsTag)::Type;                             \
+        using C = typename decltype(CompTag)::Type;                            \
+        arithm::asserts::reportCompAssignOp##Operation<L, C, C>(               \
+            ArithmRes, fromBits<L>(Ops[0]), fromBits<C>(Ops[1]),               \
+            S.getName(0), S.getName(1), Filename, Line);                       \
+      });                                                                      \
+    })
+
+#define REPLAY_COMPASSIGNOP_SHIFT(Operation)                                   \
+  case EventKind::CompAssignOp##Operation:                                     \
+    return withIntType(Types[0], [&](auto LhsTag) {                            \
+      withPromotedIntType(Types[1], [&](auto CompTag) {                        \
+        withShiftRhsType(Types[2], [&](auto RhsTag) {                          \
+          using L = typename decltype(LhsTag)::Type;                           \
+          using C = typename decltype(CompTag)::Type;                          \
+          using R = typename decltype(RhsTag)::Type;                           \
+          arithm::asserts::reportCompAssignOp##Operation<L, C, R>(             \
+              ArithmRes, fromBits<L>(Ops[0]), fromBits<R>(Ops[1]),             \
+              S.getName(0), S.getName(1), Filename, Line);                     \
+        });                                                                    \
+      });                                                                      \
+    })
+
+bool replayEvent(const Site& S, const CheckEvent& Event) {
+  const IntTypeId* Types = S.Record.TypeIds;
+  const uint64_t* Ops = Event.Operands;
+  const char* Filename = S.getFilename();
+  int Line = S.Record.Line;
+  auto ArithmRes = static_cast<ArithmCheckRes>(Event.CheckRes);
+  auto TyCoRes = static_cast<TyCoCheckRes>(Event.CheckRes);
+
+  switch (S.Record.Kind) {
+    REPLAY_BINOP(Sum);
+    REPLAY_BINOP(Diff);
+    REPLAY_BINOP(Mul);
+    REPLAY_BINOP(Div);
+    REPLAY_BINOP(Mod);
+    REPLAY_SHIFT(BitShiftLeft);
+    REPLAY_SHIFT(BitShiftRight);
+  case EventKind::UnaryNeg:
+    return withPromotedIntType(Types[0], [&](auto Tag) {
+      using T = typename decltype(Tag)::Type;
+      arithm::asserts::reportUnaryNeg<T>(ArithmRes, fromBits<T>(Ops[0]),
+                                         S.getName(0), Filename, Line);
+    });
+    REPLAY_INCR_DECR(PrefixIncr);
+    REPLAY_INCR_DECR(PostfixIncr);
+    REPLAY_INCR_DECR(PrefixDecr);
+    REPLAY_INCR_DECR(PostfixDecr);
+  case EventKind::IncrOrDecrOpResTypeConv:
+    return withIntType(Types[0], [&](auto Tag) {
+      using T = typename decltype(Tag)::Type;
+      using CommonType = typename std::common_type<T, int>::type;
+      arithm::asserts::support::reportIncrOrDecrOpResTypeConv<T, CommonType>(
+          TyCoRes, fromBits<T>(Ops[0]), fromBits<CommonType>(Ops[1]),
+          S.getName(0), S.getName(1), S.getName(2), S.getName(3), S.getName(4),
+          Filename, Line);
+    });
+    REPLAY_COMPASSIGNOP(Sum);
+    REPLAY_COMPASSIGNOP(Diff);
+    REPLAY_COMPASSIGNOP(Mul);
+    REPLAY_COMPASSIGNOP(Div);
+    REPLAY_COMPASSIGNOP(Mod);
+    REPLAY_COMPASSIGNOP_SHIFT(BitShiftLeft);
+    REPLAY_COMPASSIGNOP_SHIFT(BitShiftRight);
+  case EventKind::CompAssignOpResTypeConv:
+    return withIntType(Types[0], [&](auto LhsTag) {
+      withPromotedIntType(Types[1], [&](auto CompTag) {
+        using L = typename decltype(LhsTag)::Type;
+        using C = typename decltype(CompTag)::Type;
+        arithm::asserts::support::reportCompAssignOpResTypeConv<L, C>(
+            TyCoRes, fromBits<L>(Ops[0]), fromBits<C>(Ops[1]),
+            fromBits<C>(Ops[2]), S.getName(0), S.getName(1), S.getName(2),
+            Filename, Line);
+      });
+    });
+  case EventKind::IntegralCast:
+    return withIntType(Types[0], [&](auto FromTag) {
+      withIntType(Types[1], [&](auto ToTag) {
+        using From = typename decltype(FromTag)::Type;
+        using To = typename decltype(ToTag)::Type;
+        arithm::asserts::casts::reportIntegralCast<From, To>(
+            TyCoRes, fromBits<From>(Ops[0]), S.getName(0), S.getName(1),
+            Filename, Line);
+      });
+    });
+  case EventKind::UntrackedPtr:
+    carr_ptr::checkers::generateUntrackedPtrMessage(Filename, Line);
+    return true;
+  }
+  return false;
+}
+
+#undef REPLAY_BINOP
+#undef REPLAY_SHIFT
+#undef REPLAY_INCR_DECR
+#undef REPLAY_COMPASSIGNOP
+#undef REPLAY_COMPASSIGNOP_SHIFT
+
+bool readEventLog(const char* Path, std::unordered_map<uint32_t, Site>& Sites,
+                  std::vector<CheckEvent>& Events) {
+  std::ifstream File{Path, std::ios::binary};
+  if (!File)
+    return false;
+  std::vector<char> Data{std::istreambuf_iterator<char>{File},
+                         std::istreambuf_iterator<char>{}};
+  if (Data.size() < sizeof(LogMagic) ||
+      std::memcmp(Data.data(), LogMagic, sizeof(LogMagic)) != 0)
+    return false;
+
+  for (size_t Pos = sizeof(LogMagic); Pos < Data.size();) {
+    if (Data[Pos] == EventTag && Pos + sizeof(CheckEvent) <= Data.size()) {
+      Events.emplace_back();
+      std::memcpy(&Events.back(), Data.data() + Pos, sizeof(CheckEvent));
+      Pos += sizeof(CheckEvent);
+    } else if (Data[Pos] == SiteTag &&
+               Pos + sizeof(SiteRecord) <= Data.size()) {
+      Site S;
+      std::memcpy(&S.Record, Data.data() + Pos, sizeof(SiteRecord));
+      Pos += sizeof(SiteRecord);
+      for (uint8_t I = 0; I < S.Record.NumStrings; ++I) {
+        const char* Begin = Data.data() + Pos;
+        const char* End = static_cast<const char*>(
+            std::memchr(Begin, '\0', Data.size() - Pos));
+        if (!End)
+          return false;
+        S.Strings.emplace_back(Begin, End);
+        Pos += End - Begin + 1;
+      }
+      if (S.Strings.empty())
+        return false;
+      Sites.emplace(S.Record.SiteId, std::move(S));
+    } else
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int Argc, char** Argv) {
+  if (Argc != 2) {
+    std::cerr << "usage: ub-tester-report <event-log>\n";
+    return 1;
+  }
+  // reports are replayed, not logged again
+  unsetenv(LogEnvVar);
+
+  std::unordered_map<uint32_t, Site> Sites;
+  std::vector<CheckEvent> Events;
+  if (!readEventLog(Argv[1], Sites, Events)) {
+    std::cerr << "cannot read event log " << Argv[1] << "\n";
+    return 1;
+  }
+  // per-thread buffers are flushed in chunks
+  std::stable_sort(Events.begin(), Events.end(),
+                   [](const CheckEvent& Lhs, const CheckEvent& Rhs) {
+                     return Lhs.Timestamp < Rhs.Timestamp;
+                   });
+
+  for (const auto& Event : Events) {
+    auto It = Sites.find(Event.SiteId);
+    if (It == Sites.end() || !replayEvent(It->second, Event))
+      std::cerr << "skipping unknown event of site " << Event.SiteId << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,338 @@
+#include "uninit-variables/UninitVarsAnalysis.h"
+#include "UBUtility.h"
+#include "cli/CLI.h"
+#include "instrumentation-scope/InstrumentationScope.h"
+#include "clang/AST/Attr.h"
+#include "clang/Analysis/Analyses/UninitializedValues.h"
+#include "clang/Analysis/AnalysisDeclContext.h"
+#include "clang/Analysis/CFG.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace clang;
+
+namespace ub_tester::uninit::analysis {
+
+namespace {
+
+std::unordered_set<std::string> ProvenInitVars;
+std::unordered_set<std::string> ShadowTrackedVars;
+std::unordered_set<std::string> UncheckedReads;
+// reads sharing location with unchecked ones (e.g. in macro expansions)
+std::unordered_set<std::string> CheckedReads;
+
+// bits of all fields fit one word, see UBSafeField.h
+constexpr unsigned MaxPackedFields = 64;
+
+class MaybeUninitVarsCollector : public UninitVariablesHandler {
+public:
+  void handleUseOfUninitVariable(const VarDecl* VDecl,
+                                 const UninitUse&) override {
+    MaybeUninitVars_.insert(VDecl);
+  }
+  void handleSelfInit(const VarDecl* VDecl) override {
+    MaybeUninitVars_.insert(VDecl);
+  }
+
+  bool isMaybeUninit(const VarDecl* VDecl) const {
+    return MaybeUninitVars_.find(VDecl) != MaybeUninitVars_.end();
+  }
+
+private:
+  std::unordered_set<const VarDecl*> MaybeUninitVars_;
+};
+
+bool isCandidateType(QualType VarType) {
+  return !VarType->isReferenceType() &&
+         VarType.getUnqualifiedType()->isFundamentalType();
+}
+
+// forward must-analysis over CFG: bit is set if variable has passed a check
+// on every path since its declaration
+class UncheckedReadsFinder {
+  using VarsState = llvm::BitVector;
+
+public:
+  UncheckedReadsFinder(const CFG& FuncCFG, ASTContext* Context)
+      : FuncCFG_{FuncCFG}, Context_{Context} {}
+
+  /* Uninitialized value may be stored to escaped variable through its
+   * address between reads, so all its reads are recorded as checked, also
+   * hiding unchecked reads of other variables at the same location. */
+  void addTrackedVar(const VarDecl* VDecl, bool IsInitOnEntry,
+                     bool IsEscaped) {
+    VarIndices_.try_emplace(VDecl, VarIndices_.size());
+    InitOnEntry_.push_back(IsInitOnEntry);
+    IsEscaped_.push_back(IsEscaped);
+  }
+
+  void run() {
+    if (VarIndices_.empty())
+      return;
+    std::vector<bool> IsReachable = findReachableBlocks();
+    BlocksOut_.assign(FuncCFG_.getNumBlockIDs(),
+                      VarsState(VarIndices_.size(), true));
+
+    for (bool Changed = true; Changed;) {
+      Changed = false;
+      for (const CFGBlock* Block : FuncCFG_) {
+        if (!IsReachable[Block->getBlockID()])
+          continue;
+        VarsState State = getBlockIn(*Block, IsReachable);
+        transfer(*Block, State, /*RecordReads=*/false);
+        if (State != BlocksOut_[Block->getBlockID()]) {
+          BlocksOut_[Block->getBlockID()] = std::move(State);
+          Changed = true;
+        }
+      }
+    }
+
+    for (const CFGBlock* Block : FuncCFG_)
+      if (IsReachable[Block->getBlockID()]) {
+        VarsState State = getBlockIn(*Block, IsReachable);
+        transfer(*Block, State, /*RecordReads=*/true);
+      }
+  }
+
+private:
+  std::vector<bool> findReachableBlocks() const {
+    std::vector<bool> IsReachable(FuncCFG_.getNumBlockIDs(), false);
+    std::vector<const CFGBlock*> Worklist{&FuncCFG_.getEntry()};
+    IsReachable[FuncCFG_.getEntry().getBlockID()] = true;
+    while (!Worklist.empty()) {
+      const CFGBlock* Block = Worklist.back();
+      Worklist.pop_back();
+      for (const CFGBlock* Succ : Block->succs())
+        if (Succ && !IsReachable[Succ->getBlockID()]) {
+          IsReachable[Succ->getBlockID()] = true;
+          Worklist.push_back(Succ);
+        }
+    }
+    return IsReachable;
+  }
+
+  VarsState getBlockIn(const CFGBlock& Block,
+                       const std::vector<bool>& IsReachable) const {
+    VarsState State(VarIndices_.size(), false);
+    if (&Block == &FuncCFG_.getEntry()) {
+      for (size_t I = 0; I < InitOnEntry_.size(); ++I)
+        State[I] = InitOnEntry_[I];
+      return State;
+    }
+    bool HasReachablePred = false;
+    for (const CFGBlock* Pred : Block.preds())
+      if (Pred && IsReachable[Pred->getBlockID()]) {
+        if (!HasReachablePred)
+          State = BlocksOut_[Pred->getBlockID()];
+        else
+          State &= BlocksOut_[Pred->getBlockID()];
+        HasReachablePred = true;
+      }
+    return State;
+  }
+
+  int getVarIndex(const Expr* Ex) const {
+    const auto* DRExpr = dyn_cast<DeclRefExpr>(Ex->IgnoreParens());
+    if (!DRExpr)
+      return -1;
+    return getVarIndex(DRExpr->getDecl());
+  }
+
+  int getVarIndex(const Decl* D) const {
+    auto It = VarIndices_.find(dyn_cast_or_null<VarDecl>(D));
+    return It == VarIndices_.end() ? -1 : static_cast<int>(It->second);
+  }
+
+  void transfer(const CFGBlock& Block, VarsState& State, bool RecordReads) {
+    for (const CFGElement& Elem : Block) {
+      auto CFGStatement = Elem.getAs<CFGStmt>();
+      if (!CFGStatement)
+        continue;
+      const Stmt* S = CFGStatement->getStmt();
+
+      if (const auto* DStmt = dyn_cast<DeclStmt>(S)) {
+        for (const Decl* D : DStmt->decls())
+          if (int Idx = getVarIndex(D); Idx >= 0)
+            State[Idx] = cast<VarDecl>(D)->hasInit();
+      } else if (const auto* ImplicitCast = dyn_cast<ImplicitCastExpr>(S)) {
+        if (ImplicitCast->getCastKind() != CastKind::CK_LValueToRValue)
+          continue;
+        int Idx = getVarIndex(ImplicitCast->getSubExpr());
+        if (Idx < 0)
+          continue;
+        if (RecordReads)
+          recordRead(ImplicitCast->getSubExpr()->IgnoreParens(),
+                     State[Idx] && !IsEscaped_[Idx]);
+        State[Idx] = true;
+      } else if (const auto* Binop = dyn_cast<BinaryOperator>(S)) {
+        if (Binop->isAssignmentOp())
+          if (int Idx = getVarIndex(Binop->getLHS()); Idx >= 0)
+            State[Idx] = true;
+      } else if (const auto* Unop = dyn_cast<UnaryOperator>(S)) {
+        if (Unop->isIncrementDecrementOp())
+          if (int Idx = getVarIndex(Unop->getSubExpr()); Idx >= 0)
+            State[Idx] = true;
+      }
+    }
+  }
+
+  void recordRead(const Expr* DRExpr, bool IsUnchecked) {
+    std::string Key = util::getLocAsKey(DRExpr->getBeginLoc(), Context_);
+    if (IsUnchecked)
+      UncheckedReads.insert(std::move(Key));
+    else
+      CheckedReads.insert(std::move(Key));
+  }
+
+private:
+  const CFG& FuncCFG_;
+  ASTContext* Context_;
+  llvm::DenseMap<const VarDecl*, unsigned> VarIndices_;
+  std::vector<bool> InitOnEntry_;
+  std::vector<bool> IsEscaped_;
+  std::vector<VarsState> BlocksOut_;
+};
+
+} // namespace
+
+bool isProvenInitialized(const DeclaratorDecl* Decl,
+                         const ASTContext* Context) {
+  const auto* VDecl = dyn_cast_or_null<VarDecl>(Decl);
+  if (!VDecl)
+    return false;
+  if (const auto* PVDecl = dyn_cast<ParmVarDecl>(VDecl)) {
+    const auto* FuncDecl =
+        dyn_cast_or_null<FunctionDecl>(PVDecl->getDeclContext());
+    if (!FuncDecl)
+      return false;
+    const FunctionDecl* Definition = FuncDecl->getDefinition();
+    if (Definition && Definition != FuncDecl)
+      VDecl = Definition->getParamDecl(PVDecl->getFunctionScopeIndex());
+  }
+  return ProvenInitVars.find(util::getLocAsKey(VDecl->getLocation(),
+                                               Context)) !=
+         ProvenInitVars.end();
+}
+
+void setIsProvenInitialized(const VarDecl* VDecl, const ASTContext* Context) {
+  ProvenInitVars.insert(util::getLocAsKey(VDecl->getLocation(), Context));
+}
+
+bool isShadowTracked(const VarDecl* VDecl, const ASTContext* Context) {
+  return VDecl &&
+         ShadowTrackedVars.find(util::getLocAsKey(VDecl->getLocation(),
+                                                  Context)) !=
+             ShadowTrackedVars.end();
+}
+
+void setIsShadowTracked(const VarDecl* VDecl, const ASTContext* Context) {
+  ShadowTrackedVars.insert(util::getLocAsKey(VDecl->getLocation(), Context));
+}
+
+bool isUncheckedRead(const DeclRefExpr* DRExpr, const ASTContext* Context) {
+  std::string Key = util::getLocAsKey(DRExpr->getBeginLoc(), Context);
+  return UncheckedReads.find(Key) != UncheckedReads.end() &&
+         CheckedReads.find(Key) == CheckedReads.end();
+}
+
+bool isTrackedElementType(QualType ElementType) {
+  return cli::RunIOB && cli::wrapsUninitVars() &&
+         ElementType->isBuiltinType() && !ElementType.isConstQualified() &&
+         !ElementType.isVolatileQualified();
+}
+
+bool isPackedRecord(const RecordDecl* RDecl, const ASTContext* Context) {
+  const auto* CXXRDecl = dyn_cast_or_null<CXXRecordDecl>(RDecl);
+  if (!cli::wrapsUninitVars() || !CXXRDecl ||
+      !CXXRDecl->isCompleteDefinition() || CXXRDecl->isUnion() ||
+      CXXRDecl->isDependentContext() || !CXXRDecl->isAggregate() ||
+      !CXXRDecl->isStandardLayout() || CXXRDecl->getNumBases() != 0 ||
+      CXXRDecl->hasAttr<PackedAttr>() ||
+      CXXRDecl->hasAttr<MaxFieldAlignmentAttr>())
+    return false;
+  unsigned NumFields = 0;
+  for (const FieldDecl* FDecl : CXXRDecl->fields()) {
+    // fields of other types (e.g. typedefs) are not wrapped
+    QualType FieldType = FDecl->getType();
+    if (!isa<BuiltinType>(FieldType.getTypePtr()) ||
+        FieldType.hasLocalQualifiers() || FDecl->isBitField() ||
+        FDecl->hasAttr<AlignedAttr>() ||
+        !scope::shouldInstrument(FDecl->getBeginLoc(), Context) ||
+        scope::isExcluded(FDecl, Context))
+      return false;
+    ++NumFields;
+  }
+  return NumFields > 1 && NumFields <= MaxPackedFields;
+}
+
+UninitVarsAnalysisVisitor::UninitVarsAnalysisVisitor(ASTContext* Context)
+    : Context_(Context) {}
+
+bool UninitVarsAnalysisVisitor::VisitFunctionDecl(FunctionDecl* FuncDecl) {
+  if (!scope::shouldInstrument(FuncDecl->getBeginLoc(), Context_))
+    return true;
+  if (!FuncDecl->doesThisDeclarationHaveABody() ||
+      FuncDecl->isDependentContext())
+    return true; // templates are instrumented conservatively
+
+  AnalysisDeclContextManager ADCManager(*Context_);
+  AnalysisDeclContext* ADContext = ADCManager.getContext(FuncDecl);
+  ADContext->getCFGBuildOptions().setAllAlwaysAdd();
+  CFG* FuncCFG = ADContext->getCFG();
+  if (!FuncCFG)
+    return true;
+
+  MaybeUninitVarsCollector Collector;
+  UninitVariablesAnalysisStats Stats;
+  runUninitializedVariablesAnalysis(*FuncDecl, *FuncCFG, *ADContext, Collector,
+                                    Stats);
+
+  util::EscapedVarsVisitor EscapedVars(FuncDecl);
+  EscapedVars.TraverseStmt(FuncDecl->getBody());
+
+  for (const VarDecl* VDecl : EscapedVars.getLocalVars())
+    if (VDecl->hasLocalStorage() && isCandidateType(VDecl->getType()) &&
+        !Collector.isMaybeUninit(VDecl) && !EscapedVars.isEscaped(VDecl))
+      setIsProvenInitialized(VDecl, Context_);
+
+  // initializers cannot be added to catch and range-for variables
+  for (const VarDecl* VDecl : EscapedVars.getLocalVars())
+    if (VDecl->hasLocalStorage() && isCandidateType(VDecl->getType()) &&
+        Collector.isMaybeUninit(VDecl) && !EscapedVars.isEscaped(VDecl) &&
+        !VDecl->isExceptionVariable() && !VDecl->isCXXForRangeDecl())
+      setIsShadowTracked(VDecl, Context_);
+
+  if (util::canChangeParamTypes(FuncDecl))
+    for (const ParmVarDecl* PVDecl : FuncDecl->parameters())
+      if (isCandidateType(PVDecl->getType()) &&
+          !EscapedVars.isEscaped(PVDecl))
+        setIsProvenInitialized(PVDecl, Context_);
+
+  // the rest stay wrapped, but most of their reads need no check
+  UncheckedReadsFinder ReadsFinder(*FuncCFG, Context_);
+  for (const ParmVarDecl* PVDecl : FuncDecl->parameters())
+    if (isCandidateType(PVDecl->getType()) &&
+        !isProvenInitialized(PVDecl, Context_))
+      ReadsFinder.addTrackedVar(PVDecl, /*IsInitOnEntry=*/true,
+                                EscapedVars.isEscaped(PVDecl));
+  for (const VarDecl* VDecl : EscapedVars.getLocalVars())
+    if (VDecl->hasLocalStorage() && isCandidateType(VDecl->getType()) &&
+        !isProvenInitialized(VDecl, Context_))
+      ReadsFinder.addTrackedVar(VDecl, /*IsInitOnEntry=*/false,
+                                EscapedVars.isEscaped(VDecl));
+  ReadsFinder.run();
+  return true;
+}
+
+UninitVarsAnalysisConsumer::UninitVarsAnalysisConsumer(ASTContext* Context)
+    : AnalysisVisitor_(Context) {}
+
+void UninitVarsAnalysisConsumer::HandleTranslationUnit(ASTContext& Context) {
+  AnalysisVisitor_.TraverseDecl(Context.getTranslationUnitDecl());
+}
+
+} // namespace ub_tester::uninit::analysis
@@ -1,6 +1,10 @@
 #include "uninit-variables/UninitVarsDetection.h"
 #include "UBUtility.h"
+#include "cli/CLI.h"
 #include "code-injector/InjectorASTWrapper.h"
+#include "index-out-of-bounds/CArrayVisitor.h"
+#include "instrumentation-scope/InstrumentationScope.h"
+#include "uninit-variables/UninitVarsAnalysis.h"
 #include "clang/AST/ParentMapContext.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include <iostream>
@@ -22,8 +26,64 @@ FindSafeTypeAccessesVisitor::FindSafeTypeAccessesVisitor(ASTContext* Context)
 FindSafeTypeOperatorsVisitor::FindSafeTypeOperatorsVisitor(ASTContext* Context)
     : Context_(Context) {}
 
+namespace {
+
+// shadow of other variables is not maintained, their reads are not checked
+bool isShadowTrackedRef(const DeclRefExpr* DRExpr, const ASTContext* Context) {
+  return !DRExpr->refersToEnclosingVariableOrCapture() &&
+         uninit::analysis::isShadowTracked(
+             dyn_cast<VarDecl>(DRExpr->getDecl()), Context);
+}
+
+// element of safe array is accessed through UBSafeTypeRef, so all of its
+// reads and writes are rewritten
+bool isTrackedArrayElement(const Expr* Ex, const ASTContext* Context) {
+  const auto* SubscriptExpr = dyn_cast_or_null<ArraySubscriptExpr>(Ex);
+  return SubscriptExpr &&
+         uninit::analysis::isTrackedElementType(SubscriptExpr->getType()) &&
+         SubscriptExpr->getBase()->IgnoreParenImpCasts()->getType()
+             ->isArrayType() &&
+         iob::isSubstitutedArray(SubscriptExpr->getBase(), Context);
+}
+
+// such variables keep their original type, so no asserts are needed; with
+// shadow backend these are all but tracked ones
+bool isRefToPlainVar(const Expr* Ex, const ASTContext* Context) {
+  const auto* DRExpr = dyn_cast_or_null<DeclRefExpr>(Ex);
+  if (!cli::wrapsUninitVars())
+    return !DRExpr || !isShadowTrackedRef(DRExpr, Context);
+  if (isa_and_nonnull<ArraySubscriptExpr>(Ex))
+    return !isTrackedArrayElement(Ex, Context);
+  return DRExpr && (scope::isExcluded(DRExpr->getDecl(), Context) ||
+                    uninit::analysis::isProvenInitialized(
+                        dyn_cast<VarDecl>(DRExpr->getDecl()), Context));
+}
+
+// declaration sets shadow bits of variable, initializer clears them
+void declareShadowTrackedVar(VarDecl* VDecl, const ASTContext* Context) {
+  std::string VarName = VDecl->getNameAsString();
+  SubstitutionASTWrapper Subst(Context);
+  Subst.setLoc(getAfterNameLoc(VDecl, Context))
+      .setPrior(SubstPriorityKind::Deep);
+  if (VDecl->hasInit())
+    Subst.setFormats("#@", "(DECLARE_INIT(" + VarName + ", @))")
+        .setArguments(VDecl->getInit());
+  else
+    Subst.setFormats("", "(DECLARE_UNINIT(" + VarName + "))");
+  Subst.apply();
+}
+
+} // namespace
+
 bool FindFundTypeVarDeclVisitor::VisitVarDecl(VarDecl* VDecl) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(VDecl->getBeginLoc()))
+  if (!scope::shouldInstrument(VDecl->getBeginLoc(), Context_))
+    return true;
+  if (!cli::wrapsUninitVars()) {
+    if (uninit::analysis::isShadowTracked(VDecl, Context_))
+      declareShadowTrackedVar(VDecl, Context_);
+    return true;
+  }
+  if (uninit::analysis::isProvenInitialized(VDecl, Context_))
     return true;
 
   QualType VariableType = VDecl->getType().getUnqualifiedType();
@@ -55,11 +115,41 @@ bool isDeclRefExprToLocalVarOrParmOrMember(DeclRefExpr* DRExpr) {
   return (VDecl && VDecl->isLocalVarDeclOrParm()) || (MembExpr);
 }
 
+/* Elements of arrays with static storage are zero-initialized, and arrays
+ * referred to by pointers or references may be written elsewhere, so only
+ * elements of arrays of local objects are checked. */
+bool isCheckedArrayElement(const ArraySubscriptExpr* SubscriptExpr) {
+  const Expr* Base = SubscriptExpr->getBase()->IgnoreParenImpCasts();
+  while (true) {
+    if (const auto* Row = dyn_cast<ArraySubscriptExpr>(Base))
+      Base = Row->getBase()->IgnoreParenImpCasts();
+    else if (const auto* MembExpr = dyn_cast<MemberExpr>(Base);
+             MembExpr && !MembExpr->isArrow())
+      Base = MembExpr->getBase()->IgnoreParenImpCasts();
+    else
+      break;
+  }
+  const auto* DRExpr = dyn_cast<DeclRefExpr>(Base);
+  const auto* VDecl = DRExpr ? dyn_cast<VarDecl>(DRExpr->getDecl()) : nullptr;
+  return VDecl && VDecl->hasLocalStorage() &&
+         !VDecl->getType()->isReferenceType();
+}
+
+const Stmt* getParentIgnoringParens(const Stmt* Child, ASTContext* Context) {
+  for (const auto& Parent : Context->getParents(*Child)) {
+    const auto* ParentStmt = Parent.get<Stmt>();
+    if (isa_and_nonnull<ParenExpr>(ParentStmt))
+      return getParentIgnoringParens(ParentStmt, Context);
+    return ParentStmt;
+  }
+  return nullptr;
+}
+
 } // namespace
 
 bool FindSafeTypeAccessesVisitor::VisitDeclRefExpr(DeclRefExpr* DRExpr) {
   assert(DRExpr);
-  if (!Context_->getSourceManager().isWrittenInMainFile(DRExpr->getBeginLoc()))
+  if (!scope::shouldInstrument(DRExpr->getBeginLoc(), Context_))
     return true;
 
   // check if there is a suitable MemberExpr
@@ -79,6 +169,11 @@ bool FindSafeTypeAccessesVisitor::VisitDeclRefExpr(DeclRefExpr* DRExpr) {
   if (!(VarType.getNonReferenceType()->isFundamentalType() &&
         isDeclRefExprToLocalVarOrParmOrMember(DRExpr)))
     return true;
+  if (FoundCorrespMembExpr
+          ? !cli::wrapsUninitVars() ||
+                scope::isExcluded(MembExpr->getMemberDecl(), Context_)
+          : isRefToPlainVar(DRExpr, Context_))
+    return true;
   std::string VarName = DRExpr->getNameInfo().getName().getAsString();
   if (FoundCorrespMembExpr)
     VarName +=
@@ -104,12 +199,18 @@ bool FindSafeTypeAccessesVisitor::VisitDeclRefExpr(DeclRefExpr* DRExpr) {
             .getNonReferenceType()
             ->isFundamentalType()) {
       FoundCorrespImplicitCast = true;
-      SubstitutionASTWrapper(Context_)
-          .setLoc(DRExpr->getBeginLoc())
+      bool IsUnchecked = !FoundCorrespMembExpr &&
+                         uninit::analysis::isUncheckedRead(DRExpr, Context_);
+      SubstitutionASTWrapper Subst(Context_);
+      Subst.setLoc(DRExpr->getBeginLoc())
           .setPrior(SubstPriorityKind::Deep)
-          .setFormats("#@", "ASSERT_GET_VALUE(@)")
-          .setArguments(VarName)
-          .apply();
+          .setFormats("#@", IsUnchecked ? "GET_VALUE_UNCHECKED(@)"
+                                        : "ASSERT_GET_VALUE(@)")
+          .setArguments(VarName);
+      if (!IsUnchecked)
+        Subst.setCheckKind(budget::CheckKind::Uninit)
+            .setFallbackOutputFormat("GET_VALUE_UNCHECKED(@)");
+      Subst.apply();
     }
   }
 
@@ -134,10 +235,17 @@ bool FindSafeTypeAccessesVisitor::VisitDeclRefExpr(DeclRefExpr* DRExpr) {
         FoundCodeAvailCallingFunction = true;
     }
   }
-  if (FoundCodeAvailCallingFunction || !FoundCallingFunction)
+  // every packed field has its own type, so templates get references to values
+  const auto* FDecl =
+      FoundCorrespMembExpr ? dyn_cast<FieldDecl>(MembExpr->getMemberDecl())
+                           : nullptr;
+  bool IsPackedField =
+      FDecl && uninit::analysis::isPackedRecord(FDecl->getParent(), Context_);
+  if ((FoundCodeAvailCallingFunction && !IsPackedField) ||
+      !FoundCallingFunction)
     return true;
   else
-    // set ignore for functions with inaccessible code
+    // set ignore for functions with inaccessible code and for packed fields
     SubstitutionASTWrapper(Context_)
         .setLoc(DRExpr->getBeginLoc())
         .setPrior(SubstPriorityKind::Deep)
@@ -154,16 +262,76 @@ bool FindSafeTypeAccessesVisitor::VisitDeclRefExpr(DeclRefExpr* DRExpr) {
   return true;
 }
 
+/* Reads of tracked elements are checked like reads of wrapped variables.
+ * Elements bound to references (arguments, initializers of references and
+ * returned references) may be written through them, so they are considered
+ * initialized. Substitutions have default priority, so they enclose
+ * ASSERT_IOB of the same subscript, which has shorter arguments. */
+bool FindSafeTypeAccessesVisitor::VisitArraySubscriptExpr(
+    ArraySubscriptExpr* SubscriptExpr) {
+  if (!scope::shouldInstrument(SubscriptExpr->getBeginLoc(), Context_) ||
+      !isTrackedArrayElement(SubscriptExpr, Context_))
+    return true;
+  const Stmt* Parent = getParentIgnoringParens(SubscriptExpr, Context_);
+  const auto* ImplicitCast = dyn_cast_or_null<ImplicitCastExpr>(Parent);
+  bool IsChecked = isCheckedArrayElement(SubscriptExpr);
+  SubstitutionASTWrapper Subst(Context_);
+  Subst.setLoc(SubscriptExpr->getBeginLoc()).setArguments(SubscriptExpr);
+  if (ImplicitCast &&
+      ImplicitCast->getCastKind() == CastKind::CK_LValueToRValue) {
+    Subst.setFormats("@", IsChecked ? "ASSERT_GET_VALUE(@)"
+                                    : "GET_VALUE_UNCHECKED(@)");
+    if (IsChecked)
+      Subst.setCheckKind(budget::CheckKind::Uninit)
+          .setFallbackOutputFormat("GET_VALUE_UNCHECKED(@)");
+  } else if (!Parent || isa<CallExpr>(Parent) || isa<ReturnStmt>(Parent))
+    Subst.setFormats("@", IsChecked ? "ASSERT_GET_REF_IGNORE(@)"
+                                    : "GET_REF_UNCHECKED(@)");
+  else // stores are substituted by FindSafeTypeOperatorsVisitor
+    return true;
+  Subst.apply();
+  return true;
+}
+
+namespace {
+
+// stores to tracked elements set their init bits
+void substituteArrayElementAssignment(BinaryOperator* Binop,
+                                      ASTContext* Context) {
+  SubstitutionASTWrapper Subst(Context);
+  Subst.setLoc(Binop->getBeginLoc());
+  if (!Binop->isCompoundAssignmentOp())
+    Subst.setFormats("@#@", "ASSERT_SET_VALUE(@, @)")
+        .setArguments(Binop->getLHS(), Binop->getRHS());
+  else
+    Subst
+        .setFormats("@", isCheckedArrayElement(cast<ArraySubscriptExpr>(
+                             Binop->getLHS()->IgnoreParens()))
+                             ? "ASSERT_GET_REF(@)"
+                             : "GET_REF_UNCHECKED(@)")
+        .setArguments(Binop->getLHS());
+  Subst.apply();
+}
+
+} // namespace
+
 bool FindSafeTypeOperatorsVisitor::VisitBinaryOperator(BinaryOperator* Binop) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(Binop->getBeginLoc()))
+  if (!scope::shouldInstrument(Binop->getBeginLoc(), Context_))
     return true;
 
+  if (Binop->isAssignmentOp() &&
+      isTrackedArrayElement(Binop->getLHS()->IgnoreParens(), Context_)) {
+    substituteArrayElementAssignment(Binop, Context_);
+    return true;
+  }
   QualType BinopLHSType = Binop->getLHS()->getType();
   assert(BinopLHSType.getTypePtrOrNull());
   if (!(Binop->isAssignmentOp() && BinopLHSType->isFundamentalType() &&
         isDeclRefExprToLocalVarOrParmOrMember(
             dyn_cast_or_null<DeclRefExpr>(Binop->getLHS()))))
     return true;
+  if (isRefToPlainVar(Binop->getLHS(), Context_))
+    return true;
   if (!Binop->isCompoundAssignmentOp())
     SubstitutionASTWrapper(Context_)
         .setLoc(Binop->getBeginLoc())
@@ -182,7 +350,7 @@ bool FindSafeTypeOperatorsVisitor::VisitBinaryOperator(BinaryOperator* Binop) {
 }
 
 bool FindSafeTypeOperatorsVisitor::VisitUnaryOperator(UnaryOperator* Unop) {
-  if (!Context_->getSourceManager().isWrittenInMainFile(Unop->getBeginLoc()))
+  if (!scope::shouldInstrument(Unop->getBeginLoc(), Context_))
     return true;
 
   QualType UnopExprType = Unop->getSubExpr()->getType();
@@ -190,7 +358,22 @@ bool FindSafeTypeOperatorsVisitor::VisitUnaryOperator(UnaryOperator* Unop) {
   if (!(Unop->getSubExpr()->getType()->isFundamentalType() &&
         (Unop->isIncrementDecrementOp())))
     return true;
+  const Expr* SubExpr = Unop->getSubExpr()->IgnoreParens();
+  if (isRefToPlainVar(SubExpr, Context_))
+    return true;
   // else there will be LRValue conversion, other cases
+  if (isTrackedArrayElement(SubExpr, Context_)) {
+    // default priority, see VisitArraySubscriptExpr
+    SubstitutionASTWrapper(Context_)
+        .setLoc(Unop->getSubExpr()->getBeginLoc())
+        .setFormats("$@", isCheckedArrayElement(
+                              cast<ArraySubscriptExpr>(SubExpr))
+                              ? "ASSERT_GET_REF(@)"
+                              : "GET_REF_UNCHECKED(@)")
+        .setArguments(Unop->getSubExpr())
+        .apply();
+    return true;
+  }
   SubstitutionASTWrapper(Context_)
       .setLoc(Unop->getSubExpr()->getBeginLoc())
       .setPrior(SubstPriorityKind::Deep)
@@ -0,0 +1,158 @@
+#include "arithmetic-ub/ArithmeticUBCheckers.h"
+
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+/* Differential test of arithm::checkers backends: portable and builtin
+ * checkers of sum, diff, mul and bitshift left are run over boundary and
+ * pseudo-random operands of int, long and long long, signed and unsigned, and
+ * must return equal results. Build it with -std=c++17 and with -std=c++20,
+ * since bitshift left is checked differently since C++20.
+ *
+ * The only known divergence is C++20 Lhs << (bits - 1) of signed types:
+ * portable checker multiplies Lhs by 1 << (bits - 1), which wraps to the
+ * minimum, so its result is wrong there. These cases are counted separately
+ * and the builtin result is compared with the exact one instead. */
+
+#ifndef UB_TESTER_OVERFLOW_BUILTINS
+#error Overflow builtins are required to compare checker backends
+#endif
+
+using namespace ub_tester::arithm;
+using checkers::ArithmCheckRes;
+namespace arithm_util = ub_tester::arithm_util;
+
+namespace {
+
+constexpr size_t RandomOperands = 500;
+constexpr bool IsCXX20 = __cplusplus > 201703L;
+
+struct Stats {
+  size_t Cases = 0;
+  size_t Mismatches = 0;
+  size_t KnownDivergences = 0;
+};
+
+template <typename T>
+std::vector<T> getOperands(std::mt19937_64& Gen) {
+  constexpr int Bits = static_cast<int>(arithm_util::getTypeSizeInBits<T>());
+  constexpr T Max = std::numeric_limits<T>::max();
+  constexpr T Min = std::numeric_limits<T>::lowest();
+  constexpr T Half = static_cast<T>(1) << (Bits / 2);
+  std::vector<T> Operands{0,           1,
+                          2,           static_cast<T>(-1),
+                          Max,         Max - 1,
+                          Max / 2,     Max / 2 + 1,
+                          Min,         Min + 1,
+                          Min / 2,     Half,
+                          Half - 1,    Half + 1,
+                          static_cast<T>(-Half),
+                          static_cast<T>(-Half - 1)};
+  std::uniform_int_distribution<T> Values(Min, Max);
+  std::uniform_int_distribution<int> Shifts(1, Bits - 1);
+  for (size_t I = 0; I < RandomOperands; ++I) {
+    T Value = Values(Gen);
+    // narrowed values hit boundaries of products and shifts more often
+    if (I % 2)
+      Value = static_cast<T>(Value >> Shifts(Gen));
+    Operands.push_back(Value);
+  }
+  return Operands;
+}
+
+template <typename T>
+void reportMismatch(const char* OpName, T Lhs, T Rhs, ArithmCheckRes Portable,
+                    ArithmCheckRes Builtin) {
+  std::cerr << "mismatch: " << OpName << "<" << sizeof(T) * CHAR_BIT
+            << (std::numeric_limits<T>::is_signed ? "s" : "u") << ">(" << +Lhs
+            << ", " << +Rhs << "): portable " << static_cast<int>(Portable)
+            << ", builtins " << static_cast<int>(Builtin) << "\n";
+}
+
+template <typename T, typename Checker>
+void compareBinop(const char* OpName, Checker PortableCheck,
+                  Checker BuiltinCheck, const std::vector<T>& Operands,
+                  Stats& S) {
+  for (T Lhs : Operands)
+    for (T Rhs : Operands) {
+      ++S.Cases;
+      ArithmCheckRes Portable = PortableCheck(Lhs, Rhs);
+      ArithmCheckRes Builtin = BuiltinCheck(Lhs, Rhs);
+      if (Portable != Builtin) {
+        ++S.Mismatches;
+        reportMismatch(OpName, Lhs, Rhs, Portable, Builtin);
+      }
+    }
+}
+
+// exact result of C++20 Lhs << Rhs, where shift is multiplication by 2^Rhs
+template <typename T>
+ArithmCheckRes getExactBitShiftLeftCXX20(T Lhs, int Rhs) {
+  __int128 Res = static_cast<__int128>(Lhs) * (static_cast<__int128>(1) << Rhs);
+  if (Res > static_cast<__int128>(std::numeric_limits<T>::max()))
+    return ArithmCheckRes::OVERFLOW_MAX_IN_BITSHIFT_LEFT_CXX20;
+  if (Res < static_cast<__int128>(std::numeric_limits<T>::lowest()))
+    return ArithmCheckRes::OVERFLOW_MIN_IN_BITSHIFT_LEFT_CXX20;
+  return ArithmCheckRes::SAFE_OPERATION;
+}
+
+template <typename T>
+void compareBitShiftLeft(const std::vector<T>& Operands, Stats& S) {
+  constexpr int Bits = static_cast<int>(arithm_util::getTypeSizeInBits<T>());
+  for (T Lhs : Operands)
+    for (int Rhs = -1; Rhs <= Bits; ++Rhs) {
+      ++S.Cases;
+      ArithmCheckRes Portable = checkers::portable::checkBitShiftLeft(Lhs, Rhs);
+      ArithmCheckRes Builtin = checkers::builtins::checkBitShiftLeft(Lhs, Rhs);
+      if (IsCXX20 && std::numeric_limits<T>::is_signed && Rhs == Bits - 1) {
+        ArithmCheckRes Exact = getExactBitShiftLeftCXX20(Lhs, Rhs);
+        if (Portable != Builtin)
+          ++S.KnownDivergences;
+        if (Builtin != Exact) {
+          ++S.Mismatches;
+          reportMismatch("exact BitShiftLeft", Lhs, static_cast<T>(Rhs), Exact,
+                         Builtin);
+        }
+      } else if (Portable != Builtin) {
+        ++S.Mismatches;
+        reportMismatch("BitShiftLeft", Lhs, static_cast<T>(Rhs), Portable,
+                       Builtin);
+      }
+    }
+}
+
+template <typename T>
+void compareCheckers(std::mt19937_64& Gen, Stats& S) {
+  using CheckerType = ArithmCheckRes (*)(T, T);
+  std::vector<T> Operands = getOperands<T>(Gen);
+  compareBinop<T, CheckerType>("Sum", checkers::portable::checkSum<T>,
+                               checkers::builtins::checkSum<T>, Operands, S);
+  compareBinop<T, CheckerType>("Diff", checkers::portable::checkDiff<T>,
+                               checkers::builtins::checkDiff<T>, Operands, S);
+  compareBinop<T, CheckerType>("Mul", checkers::portable::checkMul<T>,
+                               checkers::builtins::checkMul<T>, Operands, S);
+  compareBitShiftLeft<T>(Operands, S);
+}
+
+} // namespace
+
+int main() {
+  std::mt19937_64 Gen(20201);
+  Stats S;
+  compareCheckers<int>(Gen, S);
+  compareCheckers<unsigned>(Gen, S);
+  compareCheckers<long>(Gen, S);
+  compareCheckers<unsigned long>(Gen, S);
+  compareCheckers<long long>(Gen, S);
+  compareCheckers<unsigned long long>(Gen, S);
+
+  std::cout << "C++" << (IsCXX20 ? "20" : "17") << ": " << S.Cases
+            << " cases, " << S.Mismatches << " mismatches, "
+            << S.KnownDivergences
+            << " known divergences of portable Lhs << (bits - 1)\n";
+  return S.Mismatches == 0 ? 0 : 1;
+}
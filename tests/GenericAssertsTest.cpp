@@ -0,0 +1,95 @@
+#include "UBTester.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Type-generic asserts as emitted by the tool for type-dependent expressions
+ * of templates. Operators below are declared in the global namespace, so
+ * they are found only by ordinary lookup from the templates (ADL looks in
+ * namespace std for std::vector), and the plain operation of non-integral
+ * operands has to be looked up where the expression was written. Integral
+ * operands still go through the checks. */
+
+std::ostream& operator<<(std::ostream& Out, const std::vector<int>& Vector) {
+  for (int Value : Vector)
+    Out << Value << ";";
+  return Out;
+}
+
+std::vector<int> operator-(const std::vector<int>& Vector) {
+  std::vector<int> Res;
+  for (int Value : Vector)
+    Res.push_back(-Value);
+  return Res;
+}
+
+std::vector<int>& operator+=(std::vector<int>& Vector, int Value) {
+  Vector.push_back(Value);
+  return Vector;
+}
+
+std::vector<int>& operator++(std::vector<int>& Vector) {
+  for (int& Value : Vector)
+    ++Value;
+  return Vector;
+}
+
+// print(const T& X) { Out << X; }
+template <typename T>
+void print(std::ostream& Out, const T& X) {
+  ASSERT_BINOP_GENERIC(BitShiftLeft, Out, X, 3, "Out << X");
+}
+
+// negate(const T& X) { return -X; }
+template <typename T>
+T negate(const T& X) {
+  return ASSERT_UNOP_GENERIC(UnaryNeg, X, 10, "-X");
+}
+
+// append(T& X, int Value) { X += Value; ++X; }
+template <typename T>
+void append(T& X, int Value) {
+  ASSERT_COMPASSIGNOP_GENERIC(Sum, X, Value, 3, "X += Value");
+  ASSERT_UNOP_GENERIC(PrefixIncr, X, 3, "++X");
+}
+
+// shift(T X, int Bits) { return X << Bits; }
+template <typename T>
+auto shift(T X, int Bits) {
+  return ASSERT_BINOP_GENERIC(BitShiftLeft, X, Bits, 10, "X << Bits");
+}
+
+namespace {
+
+int Failures = 0;
+
+void expect(const std::string& Actual, const std::string& Expected) {
+  if (Actual == Expected)
+    return;
+  std::cerr << "expected \"" << Expected << "\", got \"" << Actual << "\"\n";
+  ++Failures;
+}
+
+template <typename T>
+std::string printToString(const T& X) {
+  std::ostringstream Out;
+  print(Out, X);
+  return Out.str();
+}
+
+} // namespace
+
+int main() {
+  std::vector<int> Vector{1, 2};
+  expect(printToString(Vector), "1;2;");
+  expect(printToString(negate(Vector)), "-1;-2;");
+  append(Vector, 5);
+  expect(printToString(Vector), "2;3;6;");
+  expect(printToString(shift(3, 2)), "12");
+  expect(printToString(negate(1.5)), "-1.5");
+
+  std::cout << (Failures ? "FAILED" : "OK") << "\n";
+  return Failures ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+#include "overhead-budget/Profile.h"
+
+#include <iostream>
+#include <optional>
+#include <string>
+
+/* Profile parser over `perf script -F ip,srcline` output with and without
+ * callchains (-g), as captured in tests/data. Samples without callchain print
+ * IP right-aligned to 16 columns, so every line of them is indented. Files of
+ * the same name in different directories are counted apart. */
+
+using ub_tester::budget::Profile;
+
+namespace {
+
+int Failures = 0;
+
+void expect(const Profile& Prof, const std::string& Filename, unsigned Line,
+            double Expected) {
+  double Actual = Prof.getLineWeight(Filename, Line);
+  if (Actual == Expected)
+    return;
+  std::cerr << Filename << ":" << Line << ": expected weight " << Expected
+            << ", got " << Actual << "\n";
+  ++Failures;
+}
+
+std::optional<Profile> load(const std::string& DataDir,
+                            const std::string& Filename) {
+  auto Prof = Profile::load(DataDir + "/" + Filename);
+  if (!Prof) {
+    std::cerr << "cannot read " << Filename << "\n";
+    ++Failures;
+  }
+  return Prof;
+}
+
+} // namespace
+
+int main(int Argc, char** Argv) {
+  if (Argc != 2) {
+    std::cerr << "usage: " << Argv[0] << " <tests/data directory>\n";
+    return 1;
+  }
+
+  // 10 samples, one of them in libc without srcline
+  if (auto Prof = load(Argv[1], "perf-script-ip-srcline.txt")) {
+    expect(*Prof, "/home/user/proj/src/main.cpp", 12, 5.0 / 9);
+    expect(*Prof, "src/main.cpp", 12, 5.0 / 9);
+    expect(*Prof, "./src/main.cpp", 30, 2.0 / 9);
+    expect(*Prof, "tools/main.cpp", 12, 1.0 / 9);
+    expect(*Prof, "main.cpp", 12, 6.0 / 9);
+    expect(*Prof, "/other/src/main.cpp", 12, 0);
+    expect(*Prof, "src/util.h", 7, 1.0 / 9);
+  }
+
+  // 5 samples, attributed to the innermost frame with srcline
+  if (auto Prof = load(Argv[1], "perf-script-ip-srcline-callchain.txt")) {
+    expect(*Prof, "src/main.cpp", 12, 2.0 / 5);
+    expect(*Prof, "src/main.cpp", 30, 1.0 / 5);
+    expect(*Prof, "src/main.cpp", 41, 0);
+    expect(*Prof, "src/util.h", 7, 1.0 / 5);
+    expect(*Prof, "tools/main.cpp", 12, 1.0 / 5);
+    expect(*Prof, "tools/main.cpp", 20, 0);
+  }
+
+  std::cout << (Failures ? "FAILED" : "OK") << "\n";
+  return Failures ? 1 : 0;
+}